@@ -10,19 +10,19 @@
 #include <zephyr/logging/log.h>
 #include <dk_buttons_and_leds.h>
 
-/* STEP 4 - Include the header file of the nRF Modem library and the LTE link controller library */
-
-/* STEP 5 - Define the semaphore lte_connected */
+/* STEP 4 - Include the header files of the nRF Modem library, the LTE link controller library
+ * and the connectivity manager
+ */
 
 LOG_MODULE_REGISTER(Lesson2_Exercise2, LOG_LEVEL_INF);
 
-/* STEP 7 - Define the event handler for LTE link control */
-static void lte_handler(const struct lte_lc_evt *const evt)
+/* STEP 7 - Define the handler for connectivity events */
+static void conn_handler(const struct conn_mgr_evt *evt)
 {
 	switch (evt->type) {
-	/* STEP 7.1 - On changed registration status, print status */
+	/* STEP 7.1 - On registration, turn on the status LED */
 
-	/* STEP 7.2 - On event RRC update, print RRC mode */
+	/* STEP 7.2 - On lost registration, turn it off again */
 
 	default:
 		break;
@@ -43,7 +43,7 @@ int main(void)
 
 
 
-	/* STEP 9 - Take the semaphore lte_connected */
+	/* STEP 9 - Wait for the modem to register to a network */
 
 	LOG_INF("Connected to LTE network");
 
@@ -10,38 +10,27 @@
 #include <zephyr/logging/log.h>
 #include <dk_buttons_and_leds.h>
 
-/* STEP 4 - Include the header file of the nRF Modem library and the LTE link controller library */
+/* STEP 4 - Include the header files of the nRF Modem library, the LTE link controller library
+ * and the connectivity manager
+ */
 #include <modem/nrf_modem_lib.h>
 #include <modem/lte_lc.h>
-
-/* STEP 5 - Define the semaphore lte_connected */
-static K_SEM_DEFINE(lte_connected, 0, 1);
+#include <cellfund/conn_mgr.h>
 
 LOG_MODULE_REGISTER(Lesson2_Exercise2, LOG_LEVEL_INF);
 
-/* STEP 7 - Define the event handler for LTE link control */
-static void lte_handler(const struct lte_lc_evt *const evt)
+/* STEP 7 - Define the handler for connectivity events */
+static void conn_handler(const struct conn_mgr_evt *evt)
 {
 	switch (evt->type) {
-	/* STEP 7.1 - On changed registration status, print status */
-	case LTE_LC_EVT_NW_REG_STATUS:
-		if ((evt->nw_reg_status != LTE_LC_NW_REG_REGISTERED_HOME) &&
-			(evt->nw_reg_status != LTE_LC_NW_REG_REGISTERED_ROAMING)) {
-			break;
-		}
-		LOG_INF("Network registration status: %s",
-				evt->nw_reg_status == LTE_LC_NW_REG_REGISTERED_HOME ?
-				"Connected - home network" : "Connected - roaming");
-		k_sem_give(&lte_connected);
-		
+	/* STEP 7.1 - On registration, turn on the status LED */
+	case CONN_MGR_EVT_CONNECTED:
 		/* STEP 10 - Turn on the LED status LED */
 		dk_set_led_on(DK_LED2);
-
 		break;
-	/* STEP 7.2 - On event RRC update, print RRC mode */
-	case LTE_LC_EVT_RRC_UPDATE:
-		LOG_INF("RRC mode: %s", evt->rrc_mode == LTE_LC_RRC_MODE_CONNECTED ?
-				"Connected" : "Idle");
+	/* STEP 7.2 - On lost registration, turn it off again */
+	case CONN_MGR_EVT_DISCONNECTED:
+		dk_set_led_off(DK_LED2);
 		break;
 	default:
 		break;
@@ -53,17 +42,19 @@ static int modem_configure(void)
 {
 	int err;
 
-	LOG_INF("Initializing modem library");
-	err = nrf_modem_lib_init();
+	err = conn_mgr_init();
 	if (err) {
-		LOG_ERR("Failed to initialize the modem library, error: %d", err);
 		return err;
 	}
-	
-	LOG_INF("Connecting to LTE network");
-	err = lte_lc_connect_async(lte_handler);
+
+	err = conn_mgr_subscribe(conn_handler);
+	if (err) {
+		LOG_ERR("Failed to subscribe to connectivity events, error: %d", err);
+		return err;
+	}
+
+	err = conn_mgr_connect(K_SECONDS(CONFIG_CONN_MGR_CONNECT_TIMEOUT));
 	if (err) {
-		LOG_ERR("Error in lte_lc_connect_async, error: %d", err);
 		return err;
 	}
 	return 0;
@@ -84,8 +75,8 @@ int main(void)
 		return 0;
 	}
 
-	/* STEP 9 - Take the semaphore lte_connected */
-	k_sem_take(&lte_connected, K_FOREVER);
+	/* STEP 9 - Wait for the modem to register to a network */
+	conn_mgr_wait_connected(K_FOREVER);
 
 	LOG_INF("Connected to LTE network");
 	
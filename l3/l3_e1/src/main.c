@@ -11,6 +11,13 @@
 #include <dk_buttons_and_leds.h>
 #include <modem/nrf_modem_lib.h>
 #include <modem/lte_lc.h>
+#include <cellfund/conn_mgr.h>
+#include <cellfund/resolver.h>
+#include <cellfund/tx_queue.h>
+#include <cellfund/reactor.h>
+#if defined(CONFIG_ECHO_BENCH)
+#include <cellfund/echo_bench.h>
+#endif
 
 /* STEP 3 - Include the header file for the socket API */
 
@@ -22,24 +29,20 @@
 #define MESSAGE_TO_SEND "Hi from nRF91 Series device"
 #define SSTRLEN(s) (sizeof(s) - 1)
 
+/* Message types in the send queue */
+#define MSG_BUTTON 0
+
 /* STEP 5.1 - Declare the structure for the socket and server address */
 
 
 /* STEP 5.2 - Declare the buffer for receiving from server */
 
-K_SEM_DEFINE(lte_connected, 0, 1);
 
 LOG_MODULE_REGISTER(Lesson3_Exercise1, LOG_LEVEL_INF);
 
 static int server_resolve(void)
 {
-	/* STEP 6.1 - Call getaddrinfo() to get the IP address of the echo server */
-
-	/* STEP 6.2 - Retrieve the relevant information from the result structure*/
-
-	/* STEP 6.3 - Convert the address into a string and print it */
-
-	/* STEP 6.4 - Free the memory allocated for result */
+	/* STEP 6 - Resolve the server to an IPv4 or IPv6 address */
 
 	return 0;
 }
@@ -56,69 +59,71 @@ static int server_connect(void)
 	return 0;
 }
 
-static void lte_handler(const struct lte_lc_evt *const evt)
-{
-     switch (evt->type) {
-     case LTE_LC_EVT_NW_REG_STATUS:
-        if ((evt->nw_reg_status != LTE_LC_NW_REG_REGISTERED_HOME) &&
-            (evt->nw_reg_status != LTE_LC_NW_REG_REGISTERED_ROAMING)) {
-            break;
-        }
-		LOG_INF("Network registration status: %s",
-				evt->nw_reg_status == LTE_LC_NW_REG_REGISTERED_HOME ?
-				"Connected - home network" : "Connected - roaming");
-		k_sem_give(&lte_connected);
-        break;
-	case LTE_LC_EVT_RRC_UPDATE:
-		LOG_INF("RRC mode: %s", evt->rrc_mode == LTE_LC_RRC_MODE_CONNECTED ?
-				"Connected" : "Idle");
-		break;
-     default:
-             break;
-     }
-}
-
 static int modem_configure(void)
 {
 	int err;
 
-	LOG_INF("Initializing modem library");
-
-	err = nrf_modem_lib_init();
+	err = conn_mgr_init();
 	if (err) {
-		LOG_ERR("Failed to initialize the modem library, error: %d", err);
 		return err;
 	}
 	
-	LOG_INF("Connecting to LTE network");
-	err = lte_lc_connect_async(lte_handler);
+	err = conn_mgr_connect(K_SECONDS(CONFIG_CONN_MGR_CONNECT_TIMEOUT));
 	if (err) {
-		LOG_ERR("Error in lte_lc_connect_async, error: %d", err);
 		return err;
 	}
 
-	k_sem_take(&lte_connected, K_FOREVER);
+	conn_mgr_wait_connected(K_FOREVER);
 	LOG_INF("Connected to LTE network");
 	dk_set_led_on(DK_LED2);
 
 	return 0;
 }
 
+/* Runs in the send queue thread, so a busy modem does not block the buttons */
+static int message_send(uint8_t type, const uint8_t *data, size_t len)
+{
+	int err = zsock_send(sock, data, len, 0);
+	if (err < 0) {
+		LOG_INF("Failed to send message, %d", errno);
+		return -errno;
+	}
+	LOG_INF("Successfully sent message: %.*s", (int)len, data);
+
+	return 0;
+}
+
 static void button_handler(uint32_t button_state, uint32_t has_changed)
 {
 	switch (has_changed) {
 	case DK_BTN1_MSK:
-		/* STEP 9 - call send() when button 1 is pressed */
+		/* STEP 9 - Queue the message for send() when button 1 is pressed */
 
-	break;
+		break;
+#if defined(CONFIG_ECHO_BENCH)
+	case DK_BTN2_MSK:
+		/* The benchmark has its own socket, the receive loop below is not affected */
+		if (button_state & DK_BTN2_MSK) {
+			int err = echo_bench_start((struct sockaddr *)&server, server_len);
+
+			if (err) {
+				LOG_WRN("Echo benchmark not started, error: %d", err);
+			}
+		}
+		break;
+#endif
 	}
 }
 
+/* STEP 10 - Call recv() when the reactor reports received messages */
+static void sock_handler(int fd, short revents, void *user_data)
+{
+
+}
 
 int main(void)
 {
 	int err;
-	int received;
 
 	if (dk_leds_init() != 0) {
 		LOG_ERR("Failed to initialize the LED library");
@@ -144,14 +149,26 @@ int main(void)
 		return 0;
 	}
 
+	tx_queue_init(message_send);
+
 	LOG_INF("Press button 1 on your DK or Thingy:91 to send your message");
+#if defined(CONFIG_ECHO_BENCH)
+	LOG_INF("Press button 2 on your DK to run the echo benchmark");
+#endif
 
-	while (1) {
-		/* STEP 10 - Call recv() to listen to received messages */
+	/* The main thread waits for the socket, and anything else added to the reactor */
+	err = reactor_fd_add(sock, ZSOCK_POLLIN, sock_handler, NULL);
+	if (err) {
+		LOG_ERR("Failed to add the socket to the reactor: %d", err);
+		return 0;
+	}
 
+	err = reactor_run();
+	if (err) {
+		LOG_ERR("Reactor failed: %d", err);
 	}
 
-	(void)close(sock);
+	(void)zsock_close(sock);
 
 	return 0;
-}
+}
\ No newline at end of file
@@ -11,83 +11,56 @@
 #include <dk_buttons_and_leds.h>
 #include <modem/nrf_modem_lib.h>
 #include <modem/lte_lc.h>
+#include <cellfund/conn_mgr.h>
+#include <cellfund/resolver.h>
+#include <cellfund/tx_queue.h>
+#include <cellfund/reactor.h>
+#if defined(CONFIG_ECHO_BENCH)
+#include <cellfund/echo_bench.h>
+#endif
 
 /* STEP 3 - Include the header file for the socket API */
 #include <zephyr/net/socket.h>
 
 /* STEP 4 - Define the hostname and port for the echo server */
 #define SERVER_HOSTNAME "udp-echo.nordicsemi.academy"
-#define SERVER_PORT "2444"
+#define SERVER_PORT 2444
 
 #define MESSAGE_SIZE 256
 #define MESSAGE_TO_SEND "Hi from nRF91 Series device"
 #define SSTRLEN(s) (sizeof(s) - 1)
 
+/* Message types in the send queue */
+#define MSG_BUTTON 0
+
 /* STEP 5.1 - Declare the structure for the socket and server address */
 static int sock;
 static struct sockaddr_storage server;
+static socklen_t server_len;
 
 /* STEP 5.2 - Declare the buffer for receiving from server */
 static uint8_t recv_buf[MESSAGE_SIZE];
 
-K_SEM_DEFINE(lte_connected, 0, 1);
-
 LOG_MODULE_REGISTER(Lesson3_Exercise1, LOG_LEVEL_INF);
 
 static int server_resolve(void)
 {
-	/* STEP 6.1 - Call getaddrinfo() to get the IP address of the echo server */
-	int err;
-	struct zsock_addrinfo *result;
-	struct zsock_addrinfo hints = {
-		.ai_family = AF_INET,
-		.ai_socktype = SOCK_DGRAM
-	};
-
-	err = zsock_getaddrinfo(SERVER_HOSTNAME, SERVER_PORT, &hints, &result);
-	if (err != 0) {
-		LOG_INF("ERROR: getaddrinfo failed %d", err);
-		return -EIO;
-	}
-
-	if (result == NULL) {
-		LOG_INF("ERROR: Address not found");
-		return -ENOENT;
-	}
-
-	/* STEP 6.2 - Retrieve the relevant information from the result structure*/
-	struct sockaddr_in *server4 = ((struct sockaddr_in *)&server);
-
-	server4->sin_addr.s_addr =
-		((struct sockaddr_in *)result->ai_addr)->sin_addr.s_addr;
-	server4->sin_family = AF_INET;
-	server4->sin_port = ((struct sockaddr_in *)result->ai_addr)->sin_port;
-
-	/* STEP 6.3 - Convert the address into a string and print it */
-	char ipv4_addr[NET_IPV4_ADDR_LEN];
-	zsock_inet_ntop(AF_INET, &server4->sin_addr.s_addr, ipv4_addr,
-		  sizeof(ipv4_addr));
-	LOG_INF("IPv4 Address found %s", ipv4_addr);
-
-	/* STEP 6.4 - Free the memory allocated for result */
-	zsock_freeaddrinfo(result);
-
-	return 0;
+	/* STEP 6 - Resolve the server to an IPv4 or IPv6 address */
+	return resolver_lookup(SERVER_HOSTNAME, SERVER_PORT, SOCK_DGRAM, &server, &server_len);
 }
 
 static int server_connect(void)
 {
 	int err;
 	/* STEP 7 - Create a UDP socket */
-	sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	sock = zsock_socket(server.ss_family, SOCK_DGRAM, IPPROTO_UDP);
 	if (sock < 0) {
 		LOG_ERR("Failed to create socket: %d.", errno);
 		return -errno;
 	}
 
 	/* STEP 8 - Connect the socket to the server */
-	err = zsock_connect(sock, (struct sockaddr *)&server,
-		      sizeof(struct sockaddr_in));
+	err = zsock_connect(sock, (struct sockaddr *)&server, server_len);
 	if (err < 0) {
 		LOG_ERR("Connect failed : %d", errno);
 		return -errno;
@@ -97,74 +70,95 @@ static int server_connect(void)
 	return 0;
 }
 
-static void lte_handler(const struct lte_lc_evt *const evt)
-{
-     switch (evt->type) {
-     case LTE_LC_EVT_NW_REG_STATUS:
-        if ((evt->nw_reg_status != LTE_LC_NW_REG_REGISTERED_HOME) &&
-            (evt->nw_reg_status != LTE_LC_NW_REG_REGISTERED_ROAMING)) {
-            break;
-        }
-		LOG_INF("Network registration status: %s",
-				evt->nw_reg_status == LTE_LC_NW_REG_REGISTERED_HOME ?
-				"Connected - home network" : "Connected - roaming");
-		k_sem_give(&lte_connected);
-        break;
-	case LTE_LC_EVT_RRC_UPDATE:
-		LOG_INF("RRC mode: %s", evt->rrc_mode == LTE_LC_RRC_MODE_CONNECTED ?
-				"Connected" : "Idle");
-		break;
-     default:
-             break;
-     }
-}
-
 static int modem_configure(void)
 {
 	int err;
 
-	LOG_INF("Initializing modem library");
-
-	err = nrf_modem_lib_init();
+	err = conn_mgr_init();
 	if (err) {
-		LOG_ERR("Failed to initialize the modem library, error: %d", err);
 		return err;
 	}
 	
-	LOG_INF("Connecting to LTE network");
-	err = lte_lc_connect_async(lte_handler);
+	err = conn_mgr_connect(K_SECONDS(CONFIG_CONN_MGR_CONNECT_TIMEOUT));
 	if (err) {
-		LOG_ERR("Error in lte_lc_connect_async, error: %d", err);
 		return err;
 	}
 
-	k_sem_take(&lte_connected, K_FOREVER);
+	conn_mgr_wait_connected(K_FOREVER);
 	LOG_INF("Connected to LTE network");
 	dk_set_led_on(DK_LED2);
 
 	return 0;
 }
 
+/* Runs in the send queue thread, so a busy modem does not block the buttons */
+static int message_send(uint8_t type, const uint8_t *data, size_t len)
+{
+	int err = zsock_send(sock, data, len, 0);
+	if (err < 0) {
+		LOG_INF("Failed to send message, %d", errno);
+		return -errno;
+	}
+	LOG_INF("Successfully sent message: %.*s", (int)len, data);
+
+	return 0;
+}
+
 static void button_handler(uint32_t button_state, uint32_t has_changed)
 {
 	switch (has_changed) {
 	case DK_BTN1_MSK:
-		/* STEP 9 - call send() when button 1 is pressed */
+		/* STEP 9 - Queue the message for send() when button 1 is pressed */
 		if (button_state & DK_BTN1_MSK){
-			int err = zsock_send(sock, MESSAGE_TO_SEND, SSTRLEN(MESSAGE_TO_SEND), 0);
-			if (err < 0) {
-				LOG_INF("Failed to send message, %d", errno);
+			/* Presses while a message waits in the queue are merged into it */
+			int err = tx_queue_put(MSG_BUTTON, MESSAGE_TO_SEND, SSTRLEN(MESSAGE_TO_SEND),
+					       TX_QUEUE_COALESCE);
+			if (err) {
+				LOG_INF("Failed to queue message, %d", err);
 				return;
-			} LOG_INF("Successfully sent message: %s", MESSAGE_TO_SEND);
+			}
+		}
+		break;
+#if defined(CONFIG_ECHO_BENCH)
+	case DK_BTN2_MSK:
+		/* The benchmark has its own socket, the receive loop below is not affected */
+		if (button_state & DK_BTN2_MSK) {
+			int err = echo_bench_start((struct sockaddr *)&server, server_len);
+
+			if (err) {
+				LOG_WRN("Echo benchmark not started, error: %d", err);
+			}
 		}
 		break;
+#endif
 	}
 }
 
+/* STEP 10 - Call recv() when the reactor reports received messages */
+static void sock_handler(int fd, short revents, void *user_data)
+{
+	int received = zsock_recv(fd, recv_buf, sizeof(recv_buf) - 1, ZSOCK_MSG_DONTWAIT);
+
+	if (received < 0) {
+		if (errno == EAGAIN) {
+			return;
+		}
+		LOG_ERR("Socket error: %d, exit", errno);
+		reactor_stop();
+		return;
+	} else if (received == 0) {
+		LOG_ERR("Empty datagram");
+		reactor_stop();
+		return;
+	}
+
+	recv_buf[received] = 0;
+	LOG_INF("Data received from the server: (%s)", recv_buf);
+}
+
 int main(void)
 {
 	int err;
-	int received;
 
 	if (dk_leds_init() != 0) {
 		LOG_ERR("Failed to initialize the LED library");
@@ -190,23 +184,23 @@ int main(void)
 		return 0;
 	}
 
-	LOG_INF("Press button 1 on your DK or Thingy:91 to send your message");
+	tx_queue_init(message_send);
 
-	while (1) {
-		/* STEP 10 - Call recv() to listen to received messages */
-		received = zsock_recv(sock, recv_buf, sizeof(recv_buf) - 1, 0);
-
-		if (received < 0) {
-			LOG_ERR("Socket error: %d, exit", errno);
-			break;
-		} else if (received == 0) {
-			LOG_ERR("Empty datagram");
-			break;
-		}
+	LOG_INF("Press button 1 on your DK or Thingy:91 to send your message");
+#if defined(CONFIG_ECHO_BENCH)
+	LOG_INF("Press button 2 on your DK to run the echo benchmark");
+#endif
 
-		recv_buf[received] = 0;
-		LOG_INF("Data received from the server: (%s)", recv_buf);
+	/* The main thread waits for the socket, and anything else added to the reactor */
+	err = reactor_fd_add(sock, ZSOCK_POLLIN, sock_handler, NULL);
+	if (err) {
+		LOG_ERR("Failed to add the socket to the reactor: %d", err);
+		return 0;
+	}
 
+	err = reactor_run();
+	if (err) {
+		LOG_ERR("Reactor failed: %d", err);
 	}
 
 	(void)zsock_close(sock);
@@ -13,6 +13,8 @@
 #include <modem/nrf_modem_lib.h>
 #include <nrf_modem_at.h>
 #include <modem/lte_lc.h>
+#include <cellfund/conn_mgr.h>
+#include <cellfund/tx_queue.h>
 /* STEP 2.3 - Include the header file for the MQTT helper library*/
 
 LOG_MODULE_REGISTER(Lesson4_Exercise1, LOG_LEVEL_INF);
@@ -20,56 +22,31 @@ LOG_MODULE_REGISTER(Lesson4_Exercise1, LOG_LEVEL_INF);
 /* STEP 3 - Define the commands to control and monitor LEDs and buttons */
 
 
+/* Message types in the send queue */
+#define MSG_BUTTON 0
+
 #define IMEI_LEN	15
 #define CGSN_RESPONSE_LENGTH (IMEI_LEN + 6 + 1) /* Add 6 for \r\nOK\r\n and 1 for \0 */
 #define CLIENT_ID_LEN sizeof("nrf-") + IMEI_LEN /* \0 included in sizeof() statement */
 
-static K_SEM_DEFINE(lte_connected, 0, 1);
-
 /* STEP 9.2 - Declare the variable to store the client ID */
 
 
-static void lte_handler(const struct lte_lc_evt *const evt)
-{
-     switch (evt->type) {
-     case LTE_LC_EVT_NW_REG_STATUS:
-        if ((evt->nw_reg_status != LTE_LC_NW_REG_REGISTERED_HOME) &&
-            (evt->nw_reg_status != LTE_LC_NW_REG_REGISTERED_ROAMING)) {
-            break;
-        }
-		LOG_INF("Network registration status: %s",
-				evt->nw_reg_status == LTE_LC_NW_REG_REGISTERED_HOME ?
-				"Connected - home network" : "Connected - roaming");
-		k_sem_give(&lte_connected);
-        break;
-	case LTE_LC_EVT_RRC_UPDATE:
-		LOG_INF("RRC mode: %s", evt->rrc_mode == LTE_LC_RRC_MODE_CONNECTED ?
-				"Connected" : "Idle");
-		break;
-     default:
-             break;
-     }
-}
-
 static int modem_configure(void)
 {
 	int err;
 
-	LOG_INF("Initializing modem library");
-	err = nrf_modem_lib_init();
+	err = conn_mgr_init();
 	if (err) {
-		LOG_ERR("Failed to initialize the modem library, error: %d", err);
 		return err;
 	}
 	
-	LOG_INF("Connecting to LTE network");
-	err = lte_lc_connect_async(lte_handler);
+	err = conn_mgr_connect(K_SECONDS(CONFIG_CONN_MGR_CONNECT_TIMEOUT));
 	if (err) {
-		LOG_ERR("Error in lte_lc_connect_async, error: %d", err);
 		return err;
 	}
 
-	k_sem_take(&lte_connected, K_FOREVER);
+	conn_mgr_wait_connected(K_FOREVER);
 	LOG_INF("Connected to LTE network");
 	dk_set_led_on(DK_LED2);
 
@@ -120,6 +97,13 @@ static int publish(uint8_t *data, size_t len)
 /* STEP 6.4 - Define callback handler for DISCONNECT event */
 
 
+/* Runs in the send queue thread, so a busy modem does not block the buttons */
+static int message_send(uint8_t type, const uint8_t *data, size_t len)
+{
+	/* The payload is not modified, it is only not const in mqtt_publish_param */
+	return publish((uint8_t *)data, len);
+}
+
 static void button_handler(uint32_t button_state, uint32_t has_changed)
 {
 	switch (has_changed) {
@@ -152,10 +136,11 @@ int main(void)
 		return 0;
 	}
 
-		/* STEP 8 - Initialize the MQTT helper library */
+	/* STEP 8 - Initialize the MQTT helper library */
 
 	/* STEP 9.3 - Generate the client ID */
 
 	/* STEP 10 - Establish a connection to the MQTT broker */
 
+	tx_queue_init(message_send);
 }
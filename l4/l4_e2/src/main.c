@@ -13,6 +13,8 @@
 #include <modem/nrf_modem_lib.h>
 #include <nrf_modem_at.h>
 #include <modem/lte_lc.h>
+#include <cellfund/conn_mgr.h>
+#include <cellfund/tx_queue.h>
 #include <net/mqtt_helper.h>
 
 /* STEP 2.5 - Include the header for the Modem Key Management library */
@@ -26,63 +28,39 @@ LOG_MODULE_REGISTER(Lesson4_Exercise2, LOG_LEVEL_INF);
 #define BUTTON_MSG        "Hi from nRF9151 SiP"
 #define SUBSCRIBE_TOPIC_ID 1234
 
+/* Message types in the send queue */
+#define MSG_BUTTON 0
+
 #define IMEI_LEN	15
 #define CGSN_RESPONSE_LENGTH (IMEI_LEN + 6 + 1) /* Add 6 for \r\nOK\r\n and 1 for \0 */
 #define CLIENT_ID_LEN sizeof("nrf-") + IMEI_LEN /* \0 included in sizeof() statement */
 
-static K_SEM_DEFINE(lte_connected, 0, 1);
 
 static uint8_t client_id[CLIENT_ID_LEN];
 
 /* STEP 5.2 - Include the certificate in the application */
 
 
-static void lte_handler(const struct lte_lc_evt *const evt)
-{
-     switch (evt->type) {
-     case LTE_LC_EVT_NW_REG_STATUS:
-        if ((evt->nw_reg_status != LTE_LC_NW_REG_REGISTERED_HOME) &&
-            (evt->nw_reg_status != LTE_LC_NW_REG_REGISTERED_ROAMING)) {
-            break;
-        }
-		LOG_INF("Network registration status: %s",
-				evt->nw_reg_status == LTE_LC_NW_REG_REGISTERED_HOME ?
-				"Connected - home network" : "Connected - roaming");
-		k_sem_give(&lte_connected);
-        break;
-	case LTE_LC_EVT_RRC_UPDATE:
-		LOG_INF("RRC mode: %s", evt->rrc_mode == LTE_LC_RRC_MODE_CONNECTED ?
-				"Connected" : "Idle");
-		break;
-     default:
-             break;
-     }
-}
-
 /* STEP 6 - Store the certificates to the modem */
 
 static int modem_configure(void)
 {
 	int err;
 
-	LOG_INF("Initializing modem library");
-	err = nrf_modem_lib_init();
+	err = conn_mgr_init();
 	if (err) {
-		LOG_ERR("Failed to initialize the modem library, error: %d", err);
 		return err;
 	}
-
+	
 	/* STEP 7 - Store the certificate in the modem while the modem is in offline mode  */
 
 
-	LOG_INF("Connecting to LTE network");
-	err = lte_lc_connect_async(lte_handler);
+	err = conn_mgr_connect(K_SECONDS(CONFIG_CONN_MGR_CONNECT_TIMEOUT));
 	if (err) {
-		LOG_ERR("Error in lte_lc_connect_async, error: %d", err);
 		return err;
 	}
 
-	k_sem_take(&lte_connected, K_FOREVER);
+	conn_mgr_wait_connected(K_FOREVER);
 	LOG_INF("Connected to LTE network");
 	dk_set_led_on(DK_LED2);
 
@@ -262,14 +240,21 @@ static void on_mqtt_disconnect(int result)
 	LOG_INF("MQTT client disconnected: %d", result);
 }
 
+/* Runs in the send queue thread, so a busy modem does not block the buttons */
+static int message_send(uint8_t type, const uint8_t *data, size_t len)
+{
+	/* The payload is not modified, it is only not const in mqtt_publish_param */
+	return publish((uint8_t *)data, len);
+}
+
 static void button_handler(uint32_t button_state, uint32_t has_changed)
 {
 	switch (has_changed) {
 	case DK_BTN1_MSK:
 		if (button_state & DK_BTN1_MSK){
-			int err = publish(BUTTON_MSG, sizeof(BUTTON_MSG)-1);
+			int err = tx_queue_put(MSG_BUTTON, BUTTON_MSG, sizeof(BUTTON_MSG)-1, 0);
 			if (err) {
-				LOG_INF("Failed to send message, %d", err);
+				LOG_INF("Failed to queue message, %d", err);
 				return;
 			}
 		}
@@ -332,4 +317,6 @@ int main(void)
 		LOG_ERR("Failed to connect to MQTT, error code: %d", err);
 		return 0;
 	}
+
+	tx_queue_init(message_send);
 }
\ No newline at end of file
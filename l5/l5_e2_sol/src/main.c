@@ -15,6 +15,11 @@
 #include <dk_buttons_and_leds.h>
 #include <modem/nrf_modem_lib.h>
 #include <modem/lte_lc.h>
+#include <cellfund/conn_mgr.h>
+#include <cellfund/resolver.h>
+#include <cellfund/tx_queue.h>
+#include <cellfund/reactor.h>
+#include <cellfund/coap_dedup.h>
 
 #include <zephyr/random/random.h>
 
@@ -29,18 +34,21 @@
 #define APP_COAP_MAX_MSG_LEN 1280
 #define APP_COAP_VERSION 1
 
+/* Request types in the send queue */
+#define MSG_GET 0
+#define MSG_PUT 1
+
 /* STEP 9.1 - Define the interval for pinging the server */
  #define TX_KEEP_ALIVE_INTERVAL 6500
 
-/* STEP 9.2 - Define the delayable work item */
-static struct k_work_delayable rx_work;
+/* STEP 9.2 - Define the keepalive timer, run by the reactor in the main thread */
+static struct reactor_timer rx_timer;
 
 static uint8_t coap_buf[APP_COAP_MAX_MSG_LEN];
 static uint16_t next_token;
 static int sock;
 static struct sockaddr_storage server;
-
-K_SEM_DEFINE(lte_connected, 0, 1);
+static socklen_t server_len;
 
 LOG_MODULE_REGISTER(Lesson5_Exercise2, LOG_LEVEL_INF);
 
@@ -48,41 +56,7 @@ LOG_MODULE_REGISTER(Lesson5_Exercise2, LOG_LEVEL_INF);
 /**@brief Resolves the configured hostname. */
 static int server_resolve(void)
 {
-	int err;
-	struct zsock_addrinfo *result;
-	struct zsock_addrinfo hints = {
-		.ai_family = AF_INET,
-		.ai_socktype = SOCK_DGRAM
-	};
-	char ipv4_addr[NET_IPV4_ADDR_LEN];
-
-	err = zsock_getaddrinfo(CONFIG_COAP_SERVER_HOSTNAME, NULL, &hints, &result);
-	if (err != 0) {
-		LOG_ERR("ERROR: getaddrinfo failed %d\n", err);
-		return -EIO;
-	}
-
-	if (result == NULL) {
-		LOG_ERR("ERROR: Address not found\n");
-		return -ENOENT;
-	}
-
-	/* IPv4 Address. */
-	struct sockaddr_in *server4 = ((struct sockaddr_in *)&server);
-
-	server4->sin_addr.s_addr =
-		((struct sockaddr_in *)result->ai_addr)->sin_addr.s_addr;
-	server4->sin_family = AF_INET;
-	server4->sin_port = htons(CONFIG_COAP_SERVER_PORT);
-
-	zsock_inet_ntop(AF_INET, &server4->sin_addr.s_addr, ipv4_addr,
-		  sizeof(ipv4_addr));
-	LOG_INF("IPv4 Address found %s\n", ipv4_addr);
-
-	/* Free the address. */
-	zsock_freeaddrinfo(result);
-
-	return 0;
+	return resolver_lookup(CONFIG_COAP_SERVER_HOSTNAME, CONFIG_COAP_SERVER_PORT, SOCK_DGRAM, &server, &server_len);
 }
 
 /**@brief Initialize the CoAP client */
@@ -90,7 +64,7 @@ static int client_init(void)
 {
 	int err;
 	/* STEP 6.1 - Create a DTLS socket */
-	sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_DTLS_1_2);
+	sock = zsock_socket(server.ss_family, SOCK_DGRAM, IPPROTO_DTLS_1_2);
 	if (sock < 0) {
 		LOG_ERR("Failed to create CoAP socket: %d.\n", errno);
 		return -errno;
@@ -129,8 +103,7 @@ static int client_init(void)
 		return -errno;
 	}
 
-	err = zsock_connect(sock, (struct sockaddr *)&server,
-		      sizeof(struct sockaddr_in));
+	err = zsock_connect(sock, (struct sockaddr *)&server, server_len);
 	if (err < 0) {
 		LOG_ERR("Connect failed : %d\n", errno);
 		return -errno;
@@ -143,37 +116,12 @@ static int client_init(void)
 	return 0;
 }
 
-static void lte_handler(const struct lte_lc_evt *const evt)
-{
-     switch (evt->type) {
-     case LTE_LC_EVT_NW_REG_STATUS:
-        if ((evt->nw_reg_status != LTE_LC_NW_REG_REGISTERED_HOME) &&
-            (evt->nw_reg_status != LTE_LC_NW_REG_REGISTERED_ROAMING)) {
-            break;
-        }
-		LOG_INF("Network registration status: %s",
-				evt->nw_reg_status == LTE_LC_NW_REG_REGISTERED_HOME ?
-				"Connected - home network" : "Connected - roaming");
-		k_sem_give(&lte_connected);
-        break;
-	case LTE_LC_EVT_RRC_UPDATE:
-		LOG_INF("RRC mode: %s", evt->rrc_mode == LTE_LC_RRC_MODE_CONNECTED ?
-				"Connected" : "Idle");
-		break;
-     default:
-             break;
-     }
-}
-
 static int modem_configure(void)
 {
 	int err;
 
-	LOG_INF("Initializing modem library");
-
-	err = nrf_modem_lib_init();
+	err = conn_mgr_init();
 	if (err) {
-		LOG_ERR("Failed to initialize the modem library, error: %d", err);
 		return err;
 	}
 
@@ -193,14 +141,12 @@ static int modem_configure(void)
 		return err;
 	}
 	
-	LOG_INF("Connecting to LTE network");
-	err = lte_lc_connect_async(lte_handler);
+	err = conn_mgr_connect(K_SECONDS(CONFIG_CONN_MGR_CONNECT_TIMEOUT));
 	if (err) {
-		LOG_ERR("Error in lte_lc_connect_async, error: %d", err);
 		return err;
 	}
 
-	k_sem_take(&lte_connected, K_FOREVER);
+	conn_mgr_wait_connected(K_FOREVER);
 	LOG_INF("Connected to LTE network");
 	dk_set_led_on(DK_LED2);
 
@@ -316,6 +262,12 @@ static int client_handle_response(uint8_t *buf, int received)
 		return err;
 	}
 
+	/* Server retransmissions are acknowledged again but not handled twice */
+	if (coap_dedup_rx(sock, (struct sockaddr *)&server, &reply) == -EALREADY) {
+		LOG_INF("Duplicate message 0x%04x ignored", coap_header_get_id(&reply));
+		return 0;
+	}
+
 	payload = coap_packet_get_payload(&reply, &payload_len);
 	token_len = coap_header_get_token(&reply, token);
 
@@ -327,7 +279,10 @@ static int client_handle_response(uint8_t *buf, int received)
 	}
 
 	if (payload_len > 0) {
-		snprintf(temp_buf, MIN(payload_len + 1, sizeof(temp_buf)), "%s", payload);
+		/* The payload is not terminated, a bounded copy is enough */
+		payload_len = MIN(payload_len, sizeof(temp_buf) - 1);
+		memcpy(temp_buf, payload, payload_len);
+		temp_buf[payload_len] = '\0';
 	} else {
 		strcpy(temp_buf, "EMPTY");
 	}
@@ -338,37 +293,78 @@ static int client_handle_response(uint8_t *buf, int received)
 	return 0;
 }
 
+/* Runs in the send queue thread, so a busy modem does not block the buttons */
+static int request_send(uint8_t type, const uint8_t *data, size_t len)
+{
+	return type == MSG_PUT ? client_put_send() : client_get_send();
+}
+
+/* Requests of a type are all the same, a queued one is as good as a new one */
+static void request_queue(uint8_t type)
+{
+	(void)tx_queue_put(type, NULL, 0, TX_QUEUE_COALESCE);
+}
+
 static void button_handler(uint32_t button_state, uint32_t has_changed)
 {
 	#if defined (CONFIG_DK)
 	if (has_changed & DK_BTN1_MSK && button_state & DK_BTN1_MSK) {
-		client_get_send();
+		request_queue(MSG_GET);
 	} else if (has_changed & DK_BTN2_MSK && button_state & DK_BTN2_MSK) {
-		client_put_send();
+		request_queue(MSG_PUT);
 	}
 	#elif defined (CONFIG_THINGY)
 	static bool toogle = 1;
 	if (has_changed & DK_BTN1_MSK && button_state & DK_BTN1_MSK) {
 		if (toogle ==1) {
-			client_get_send();
+			request_queue(MSG_GET);
 		} else {
-			client_put_send();
+			request_queue(MSG_PUT);
 		}
 		toogle = !toogle;
 	}
 	#endif
 }
 
-/* STEP 9.3 - Define the handler for the work item */
-static void rx_work_fn(struct k_work *work)
+/* STEP 9.3 - Define the handler for the timer */
+static void rx_timer_fn(struct reactor_timer *timer)
+{
+	request_queue(MSG_GET);
+}
+
+/* Called by the reactor when the socket has data */
+static void sock_handler(int fd, short revents, void *user_data)
 {
-	client_get_send();
+	int err;
+	int received = zsock_recv(fd, coap_buf, sizeof(coap_buf), ZSOCK_MSG_DONTWAIT);
+
+	if (received < 0) {
+		if (errno == EAGAIN) {
+			return;
+		}
+		LOG_ERR("Socket error:  %d, exit\n", errno);
+		reactor_stop();
+		return;
+	}
+
+	/* STEP 9.5 - Restart the timer, the server is pinged after a quiet interval */
+	reactor_timer_start(&rx_timer, TX_KEEP_ALIVE_INTERVAL);
+
+	if (received == 0) {
+		LOG_ERR("Empty datagram\n");
+		return;
+	}
+
+	err = client_handle_response(coap_buf, received);
+	if (err < 0) {
+		LOG_ERR("Invalid response, exit\n");
+		reactor_stop();
+	}
 }
 
 int main(void)
 {
 	int err;
-	int received;
 
 	if (dk_leds_init() != 0) {
 		LOG_ERR("Failed to initialize the LED library");
@@ -394,29 +390,22 @@ int main(void)
 		return 0;
 	}
 
-	/* STEP 9.4 - Initialize the work item rx_work with the handler function */
-	k_work_init_delayable(&rx_work, rx_work_fn);
-
-	while (1) {
-		/* STEP 9.5 - Schedule the work item rx_work with a delay */
-		k_work_reschedule(&rx_work,K_MSEC(TX_KEEP_ALIVE_INTERVAL));
-
-		received = zsock_recv(sock, coap_buf, sizeof(coap_buf), 0);
+	tx_queue_init(request_send);
 
-		if (received < 0) {
-			LOG_ERR("Socket error:  %d, exit\n", errno);
-			break;
-		} else if (received == 0) {
-			LOG_ERR("Empty datagram\n");
-			continue;
-		}
+	/* STEP 9.4 - Initialize the timer with the handler function and start it */
+	reactor_timer_init(&rx_timer, rx_timer_fn);
+	reactor_timer_start(&rx_timer, TX_KEEP_ALIVE_INTERVAL);
 
-		err = client_handle_response(coap_buf, received);
-		if (err < 0) {
-			LOG_ERR("Invalid response, exit\n");
-			break;
-		}
+	/* The main thread waits for the socket and the timer */
+	err = reactor_fd_add(sock, ZSOCK_POLLIN, sock_handler, NULL);
+	if (err) {
+		LOG_ERR("Failed to add the socket to the reactor: %d\n", err);
+		return 0;
+	}
 
+	err = reactor_run();
+	if (err) {
+		LOG_ERR("Reactor failed: %d\n", err);
 	}
 
 	(void)zsock_close(sock);
@@ -11,45 +11,41 @@
 #include <zephyr/logging/log.h>
 #include <modem/nrf_modem_lib.h>
 #include <modem/lte_lc.h>
+#include <cellfund/conn_mgr.h>
+#include <cellfund/gnss_pipeline.h>
 #include <dk_buttons_and_leds.h>
 
 /* STEP 4 - Include the header file for the GNSS interface */
 
 
-/* STEP 5 - Define the PVT data frame variable */
-
-
 /* STEP 12.1 - Declare helper variables to find the TTFF */
 
 
-static K_SEM_DEFINE(lte_connected, 0, 1);
-
 LOG_MODULE_REGISTER(Lesson6_Exercise1, LOG_LEVEL_INF);
 
 static int modem_configure(void)
 {
 	int err;
 
-	LOG_INF("Initializing modem library");
-
-	err = nrf_modem_lib_init();
+	/* GNSS only, LTE is not activated in this exercise */
+	err = conn_mgr_init();
 	if (err) {
-		LOG_ERR("Failed to initialize the modem library, error: %d", err);
 		return err;
 	}
 
-
 	return 0;
 }
 
 /* STEP 6 - Define a function to log fix data in a readable format */
 
 
-static void gnss_event_handler(int event)
+/* Runs in the GNSS pipeline thread, the PVT frame was already read from the modem */
+static void gnss_event_handler(const struct gnss_pipeline_evt *evt)
 {
-	int err;
+	/* STEP 5 - Define the PVT data frame variable */
+
 
-	switch (event) {
+	switch (evt->id) {
 	/* STEP 7.1 - On a PVT event, confirm if PVT data is a valid fix */
 
 	/* STEP 7.2 - Log when the GNSS sleeps and wakes up */
@@ -11,20 +11,19 @@
 #include <zephyr/logging/log.h>
 #include <modem/nrf_modem_lib.h>
 #include <modem/lte_lc.h>
+#include <cellfund/conn_mgr.h>
+#include <cellfund/gnss_pipeline.h>
 #include <dk_buttons_and_leds.h>
 
 /* STEP 4 - Include the header file for the GNSS interface */
 #include <nrf_modem_gnss.h>
-
-/* STEP 5 - Define the PVT data frame variable */
-static struct nrf_modem_gnss_pvt_data_frame pvt_data;
+#include <cellfund/fixfmt.h>
+#include <cellfund/sat_stats.h>
 
 /* STEP 12.1 - Declare helper variables to find the TTFF */
 static int64_t gnss_start_time;
 static bool first_fix = false;
 
-static K_SEM_DEFINE(lte_connected, 0, 1);
-
 LOG_MODULE_REGISTER(Lesson6_Exercise1, LOG_LEVEL_INF);
 
 
@@ -32,11 +31,9 @@ static int modem_configure(void)
 {
 	int err;
 
-	LOG_INF("Initializing modem library");
-
-	err = nrf_modem_lib_init();
+	/* GNSS only, LTE is not activated in this exercise */
+	err = conn_mgr_init();
 	if (err) {
-		LOG_ERR("Failed to initialize the modem library, error: %d", err);
 		return err;
 	}
 
@@ -44,44 +41,42 @@ static int modem_configure(void)
 }
 
 /* STEP 6 - Define a function to log fix data in a readable format */
-static void print_fix_data(struct nrf_modem_gnss_pvt_data_frame *pvt_data)
+static void print_fix_data(const struct nrf_modem_gnss_pvt_data_frame *pvt_data)
 {
-	LOG_INF("Latitude:       %.06f", pvt_data->latitude);
-	LOG_INF("Longitude:      %.06f", pvt_data->longitude);
-	LOG_INF("Altitude:       %.01f m", (double)pvt_data->altitude);
-	LOG_INF("Time (UTC):     %02u:%02u:%02u.%03u",
-	       pvt_data->datetime.hour,
-	       pvt_data->datetime.minute,
-	       pvt_data->datetime.seconds,
-	       pvt_data->datetime.ms);
+	char lat[FIXFMT_DEG_LEN], lon[FIXFMT_DEG_LEN], alt[16], time[FIXFMT_ISO8601_LEN];
+
+	fixfmt_deg_e7(lat, sizeof(lat), fixfmt_deg_to_e7(pvt_data->latitude));
+	fixfmt_deg_e7(lon, sizeof(lon), fixfmt_deg_to_e7(pvt_data->longitude));
+	fixfmt_mm(alt, sizeof(alt), (int64_t)(pvt_data->altitude * 1000.0f));
+	fixfmt_iso8601(time, sizeof(time), &pvt_data->datetime);
+
+	LOG_INF("Latitude:       %s", lat);
+	LOG_INF("Longitude:      %s", lon);
+	LOG_INF("Altitude:       %s m", alt);
+	LOG_INF("Time (UTC):     %s", time);
 }
 
 
-static void gnss_event_handler(int event)
+/* Runs in the GNSS pipeline thread, the PVT frame was already read from the modem */
+static void gnss_event_handler(const struct gnss_pipeline_evt *evt)
 {
-	int err;
+	/* STEP 5 - Define the PVT data frame variable */
+	const struct nrf_modem_gnss_pvt_data_frame *pvt_data = &evt->pvt;
 
-	switch (event) {
-	/* STEP 7 - On a PVT event, confirm if PVT data is a valid fix */
+	switch (evt->id) {
+	/* STEP 7.1 - On a PVT event, confirm if PVT data is a valid fix */
 	case NRF_MODEM_GNSS_EVT_PVT:
 		LOG_INF("Searching...");
 		/* STEP 15 - Print satellite information */
-		int num_satellites = 0;
-		for (int i = 0; i < 12 ; i++) {
-			if (pvt_data.sv[i].signal != 0) {
-				LOG_INF("sv: %d, cn0: %d, signal: %d", pvt_data.sv[i].sv, pvt_data.sv[i].cn0, pvt_data.sv[i].signal);
-				num_satellites++;
-			}
-		}
-		LOG_INF("Number of current satellites: %d", num_satellites);
-		err = nrf_modem_gnss_read(&pvt_data, sizeof(pvt_data), NRF_MODEM_GNSS_DATA_PVT);
-		if (err) {
-			LOG_ERR("nrf_modem_gnss_read failed, err %d", err);
-			return;
-		}
-		if (pvt_data.flags & NRF_MODEM_GNSS_PVT_FLAG_FIX_VALID) {
+		struct sat_stats_summary summary;
+
+		sat_stats_update(pvt_data);
+		sat_stats_summary_get(&summary);
+		LOG_INF("Number of current satellites: %d, mean C/N0: %d.%d dB-Hz",
+			summary.tracked, summary.cn0_mean / 10, summary.cn0_mean % 10);
+		if (pvt_data->flags & NRF_MODEM_GNSS_PVT_FLAG_FIX_VALID) {
 			dk_set_led_on(DK_LED1);
-			print_fix_data(&pvt_data);
+			print_fix_data(pvt_data);
 			/* STEP 12.3 - Print the time to first fix */
 			if (!first_fix) {
 				LOG_INF("Time to first fix: %2.1lld s", (k_uptime_get() - gnss_start_time)/1000);
@@ -123,7 +118,7 @@ int main(void)
 	}
 
 	/* STEP 9 - Register the GNSS event handler */
-	if (nrf_modem_gnss_event_handler_set(gnss_event_handler) != 0) {
+	if (gnss_pipeline_init(gnss_event_handler) != 0) {
 		LOG_ERR("Failed to set GNSS event handler");
 		return 0;
 	}
@@ -5,85 +5,92 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 #include <ncs_version.h>
 #include <zephyr/kernel.h>
 #include <zephyr/net/socket.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/timeutil.h>
 
 #include <zephyr/logging/log.h>
 #include <dk_buttons_and_leds.h>
 #include <modem/nrf_modem_lib.h>
 #include <modem/lte_lc.h>
+#include <cellfund/conn_mgr.h>
+#include <cellfund/resolver.h>
 #include <nrf_modem_gnss.h>
+#include <cellfund/gnss_pipeline.h>
+#include <cellfund/fixfmt.h>
+#if defined(CONFIG_POS_FILTER)
+#include <cellfund/pos_filter.h>
+#endif
+#include <cellfund/lte_timer.h>
+#include <cellfund/tx_queue.h>
+#include <cellfund/reactor.h>
+
 #define SERVER_HOSTNAME "udp-echo.nordicsemi.academy"
-#define SERVER_PORT "2444"
+#define SERVER_PORT 2444
 
 #define MESSAGE_SIZE 256
 #define MESSAGE_TO_SEND "Hello"
 
-static struct nrf_modem_gnss_pvt_data_frame pvt_data;
+/* Text report, "Latitude: 63.421234, Longitude: 10.437112" */
+#define REPORT_LAT "Latitude: "
+#define REPORT_LON ", Longitude: "
+#define REPORT_TEXT_LEN_MAX (sizeof(REPORT_LAT) + sizeof(REPORT_LON) + 2 * FIXFMT_DEG_LEN)
+
+/* Binary report: version, latitude and longitude in 1e-7 degrees, altitude
+ * in metres and UTC time in seconds since 1970, all big endian.
+ */
+#define REPORT_VERSION 1
+#define REPORT_BINARY_LEN 15
+
+/* Message types in the send queue */
+#define MSG_REPORT 0
 
 static int64_t gnss_start_time;
 static bool first_fix = false;
+#if defined(CONFIG_POS_FILTER)
+static struct pos_filter pos_filter;
+#endif
 
-/* STEP 3.1 - Declare buffer to send data in */
+/* Latest fix, encoded into the send buffer when the report is sent */
+struct fix {
+	int32_t lat_e7;
+	int32_t lon_e7;
+	int16_t alt_m;
+	uint32_t time;
+};
+
+static K_MUTEX_DEFINE(fix_lock);
+static struct fix last_fix;
+static bool last_fix_valid;
+
+/* STEP 3.1 - Declare buffer to send data in, sized for the longest report */
 
 
 static int sock;
 static struct sockaddr_storage server;
+static socklen_t server_len;
 static uint8_t recv_buf[MESSAGE_SIZE];
 
-static K_SEM_DEFINE(lte_connected, 0, 1);
-
 LOG_MODULE_REGISTER(Lesson6_Exercise2, LOG_LEVEL_INF);
 
 static int server_resolve(void)
 {
-	int err;
-	struct zsock_addrinfo *result;
-	struct zsock_addrinfo hints = {
-		.ai_family = AF_INET,
-		.ai_socktype = SOCK_DGRAM
-	};
-
-	err = zsock_getaddrinfo(SERVER_HOSTNAME, SERVER_PORT, &hints, &result);
-	if (err != 0) {
-		LOG_INF("ERROR: getaddrinfo failed %d", err);
-		return -EIO;
-	}
-
-	if (result == NULL) {
-		LOG_INF("ERROR: Address not found");
-		return -ENOENT;
-	}
-
-	struct sockaddr_in *server4 = ((struct sockaddr_in *)&server);
-	
-	server4->sin_addr.s_addr =
-		((struct sockaddr_in *)result->ai_addr)->sin_addr.s_addr;
-	server4->sin_family = AF_INET;
-	server4->sin_port = ((struct sockaddr_in *)result->ai_addr)->sin_port;
-
-	char ipv4_addr[NET_IPV4_ADDR_LEN];
-	zsock_inet_ntop(AF_INET, &server4->sin_addr.s_addr, ipv4_addr,
-		  sizeof(ipv4_addr));
-	LOG_INF("IPv4 Address found %s", ipv4_addr);
-
-	zsock_freeaddrinfo(result);
-
-	return 0;
+	return resolver_lookup(SERVER_HOSTNAME, SERVER_PORT, SOCK_DGRAM, &server, &server_len);
 }
 
 static int server_connect(void)
 {
 	int err;
-	sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	sock = zsock_socket(server.ss_family, SOCK_DGRAM, IPPROTO_UDP);
 	if (sock < 0) {
 		LOG_ERR("Failed to create socket: %d.", errno);
 		return -errno;
 	}
 
-	err = zsock_connect(sock, (struct sockaddr *)&server,
-		      sizeof(struct sockaddr_in));
+	err = zsock_connect(sock, (struct sockaddr *)&server, server_len);
 	if (err < 0) {
 		LOG_ERR("Connect failed : %d", errno);
 		return -errno;
@@ -93,24 +100,9 @@ static int server_connect(void)
 	return 0;
 }
 
-static void lte_handler(const struct lte_lc_evt *const evt)
+static void conn_handler(const struct conn_mgr_evt *evt)
 {
 	switch (evt->type) {
-	case LTE_LC_EVT_NW_REG_STATUS:
-		if ((evt->nw_reg_status != LTE_LC_NW_REG_REGISTERED_HOME) &&
-			(evt->nw_reg_status != LTE_LC_NW_REG_REGISTERED_ROAMING)) {
-			break;
-		}
-		LOG_INF("Network registration status: %s",
-				evt->nw_reg_status == LTE_LC_NW_REG_REGISTERED_HOME ?
-				"Connected - home network" : "Connected - roaming");
-		k_sem_give(&lte_connected);
-		break;
-	case LTE_LC_EVT_RRC_UPDATE:
-		LOG_INF("RRC mode: %s",
-				evt->rrc_mode == LTE_LC_RRC_MODE_CONNECTED ?
-				"Connected" : "Idle");
-		break;
 	/* STEP 9.1 - On event PSM update, print PSM parameters and check if was enabled */
 
 	/* STEP 9.2 - On event eDRX update, print eDRX parameters */
@@ -124,68 +116,164 @@ static int modem_configure(void)
 {
 	int err;
 
-	LOG_INF("Initializing modem library");
-
-	err = nrf_modem_lib_init();
+	err = conn_mgr_init();
 	if (err) {
-		LOG_ERR("Failed to initialize the modem library, error: %d", err);
 		return err;
 	}
 
-
+	err = conn_mgr_subscribe(conn_handler);
+	if (err) {
+		LOG_ERR("Failed to subscribe to connectivity events, error: %d", err);
+		return err;
+	}
+	
 	/* STEP 8 - Request PSM and eDRX from the network */
 
 	
-	LOG_INF("Connecting to LTE network");
-	err = lte_lc_connect_async(lte_handler);
+	err = conn_mgr_connect(K_SECONDS(CONFIG_CONN_MGR_CONNECT_TIMEOUT));
 	if (err) {
-		LOG_ERR("Error in lte_lc_connect_async, error: %d", err);
 		return err;
 	}
 
-	k_sem_take(&lte_connected, K_FOREVER);
+	conn_mgr_wait_connected(K_FOREVER);
 	LOG_INF("Connected to LTE network");
 	dk_set_led_on(DK_LED2);
 
 	return 0;
 }
 
-static void print_fix_data(struct nrf_modem_gnss_pvt_data_frame *pvt_data)
+static void print_fix_data(const struct nrf_modem_gnss_pvt_data_frame *pvt_data)
 {
-	LOG_INF("Latitude:       %.06f", pvt_data->latitude);
-	LOG_INF("Longitude:      %.06f", pvt_data->longitude);
-	LOG_INF("Altitude:       %.01f m", (double)pvt_data->altitude);
-	LOG_INF("Time (UTC):     %02u:%02u:%02u.%03u",
-	       pvt_data->datetime.hour,
-	       pvt_data->datetime.minute,
-	       pvt_data->datetime.seconds,
-	       pvt_data->datetime.ms);
+	char lat[FIXFMT_DEG_LEN], lon[FIXFMT_DEG_LEN], alt[16], time[FIXFMT_ISO8601_LEN];
 
-	/* STEP 3.2 - Store latitude and longitude in gps_data buffer */
+	fixfmt_deg_e7(lat, sizeof(lat), fixfmt_deg_to_e7(pvt_data->latitude));
+	fixfmt_deg_e7(lon, sizeof(lon), fixfmt_deg_to_e7(pvt_data->longitude));
+	fixfmt_mm(alt, sizeof(alt), (int64_t)(pvt_data->altitude * 1000.0f));
+	fixfmt_iso8601(time, sizeof(time), &pvt_data->datetime);
 
+	LOG_INF("Latitude:       %s", lat);
+	LOG_INF("Longitude:      %s", lon);
+	LOG_INF("Altitude:       %s m", alt);
+	LOG_INF("Time (UTC):     %s", time);
 }
 
-static void gnss_event_handler(int event)
+/* STEP 3.2 - Store the fix, it is encoded when it is sent */
+
+
+/* Appends the string without its terminator. */
+static int report_str(uint8_t *buf, size_t size, size_t *len, const char *str)
+{
+	size_t n = strlen(str);
+
+	if (size - *len < n) {
+		return -ENOMEM;
+	}
+
+	memcpy(&buf[*len], str, n);
+	*len += n;
+
+	return 0;
+}
+
+/* Appends degrees, the terminator written by fixfmt is overwritten by the next field. */
+static int report_deg(uint8_t *buf, size_t size, size_t *len, int32_t deg_e7)
+{
+	int ret = fixfmt_deg_e7((char *)&buf[*len], size - *len, deg_e7);
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	*len += ret;
+
+	return 0;
+}
+
+static int report_encode_text(const struct fix *fix, uint8_t *buf, size_t size)
 {
-	int err, num_satellites;
+	size_t len = 0;
+	int err;
 
-	switch (event) {
+	err = report_str(buf, size, &len, REPORT_LAT);
+	if (!err) {
+		err = report_deg(buf, size, &len, fix->lat_e7);
+	}
+	if (!err) {
+		err = report_str(buf, size, &len, REPORT_LON);
+	}
+	if (!err) {
+		err = report_deg(buf, size, &len, fix->lon_e7);
+	}
+
+	return err ? err : (int)len;
+}
+
+static int report_encode_binary(const struct fix *fix, uint8_t *buf, size_t size)
+{
+	if (size < REPORT_BINARY_LEN) {
+		return -ENOMEM;
+	}
+
+	buf[0] = REPORT_VERSION;
+	sys_put_be32(fix->lat_e7, &buf[1]);
+	sys_put_be32(fix->lon_e7, &buf[5]);
+	sys_put_be16(fix->alt_m, &buf[9]);
+	sys_put_be32(fix->time, &buf[11]);
+
+	return REPORT_BINARY_LEN;
+}
+
+/* Encodes the latest fix straight into the send buffer.
+ * Returns the report length, or a negative error code.
+ */
+static int report_encode(uint8_t *buf, size_t size)
+{
+	struct fix fix;
+
+	k_mutex_lock(&fix_lock, K_FOREVER);
+	if (!last_fix_valid) {
+		k_mutex_unlock(&fix_lock);
+		return -ENODATA;
+	}
+	fix = last_fix;
+	k_mutex_unlock(&fix_lock);
+
+	if (IS_ENABLED(CONFIG_GNSS_REPORT_BINARY)) {
+		return report_encode_binary(&fix, buf, size);
+	}
+
+	return report_encode_text(&fix, buf, size);
+}
+
+/* Runs in the GNSS pipeline thread, the PVT frame was already read from the modem */
+static void gnss_event_handler(const struct gnss_pipeline_evt *evt)
+{
+	const struct nrf_modem_gnss_pvt_data_frame *pvt_data = &evt->pvt;
+	int num_satellites;
+
+	switch (evt->id) {
 	case NRF_MODEM_GNSS_EVT_PVT:
 		num_satellites = 0;
-		for (int i = 0; i < 12 ; i++) {
-			if (pvt_data.sv[i].signal != 0) {
+		for (int i = 0; i < NRF_MODEM_GNSS_MAX_SATELLITES; i++) {
+			if (pvt_data->sv[i].signal != 0) {
 				num_satellites++;
 			}
 		}
 		LOG_INF("Searching. Current satellites: %d", num_satellites);
-		err = nrf_modem_gnss_read(&pvt_data, sizeof(pvt_data), NRF_MODEM_GNSS_DATA_PVT);
-		if (err) {
-			LOG_ERR("nrf_modem_gnss_read failed, err %d", err);
-			return;
-		}
-		if (pvt_data.flags & NRF_MODEM_GNSS_PVT_FLAG_FIX_VALID) {
+		if (pvt_data->flags & NRF_MODEM_GNSS_PVT_FLAG_FIX_VALID) {
+			struct nrf_modem_gnss_pvt_data_frame fix = *pvt_data;
+#if defined(CONFIG_POS_FILTER)
+			struct pos_filter_output filtered;
+
+			/* Smooth out jitter before the fix is stored for sending */
+			if (pos_filter_update(&pos_filter, &fix, &filtered) == 0) {
+				pos_filter_output_to_pvt(&filtered, &fix);
+			}
+#endif
+
 			dk_set_led_on(DK_LED1);
-			print_fix_data(&pvt_data);
+			print_fix_data(&fix);
+			fix_store(&fix);
 			if (!first_fix) {
 				LOG_INF("Time to first fix: %2.1lld s", (k_uptime_get() - gnss_start_time)/1000);
 				first_fix = true;
@@ -213,7 +301,7 @@ static int gnss_init_and_start(void)
 	/* STEP 4 - Set the modem mode to normal */
 
 
-	if (nrf_modem_gnss_event_handler_set(gnss_event_handler) != 0) {
+	if (gnss_pipeline_init(gnss_event_handler) != 0) {
 		LOG_ERR("Failed to set GNSS event handler");
 		return -1;
 	}
@@ -239,16 +327,66 @@ static int gnss_init_and_start(void)
 	return 0;
 }
 
+/* Runs in the send queue thread, so a busy modem does not block the buttons.
+ * The report is encoded here, so it holds the latest fix when it is sent.
+ */
+static int report_send(uint8_t type, const uint8_t *data, size_t data_len)
+{
+	int len = report_encode(gps_data, sizeof(gps_data));
+	if (len == -ENODATA) {
+		LOG_INF("No fix to send yet");
+		return 0;
+	} else if (len < 0) {
+		LOG_ERR("Failed to encode report: %d", len);
+		return len;
+	}
+
+	/* Only the encoded bytes go on air, not the whole buffer */
+	int err = zsock_send(sock, gps_data, len, 0);
+	if (err < 0) {
+		LOG_INF("Failed to send message, %d", errno);
+		return -errno;
+	}
+	LOG_INF("Sent a %d byte report", len);
+
+	return 0;
+}
+
 static void button_handler(uint32_t button_state, uint32_t has_changed)
 {
 	/* STEP 3.3 - Upon button 1 push, send gps_data */
 
 }
 
+/* Called by the reactor when the socket has data */
+static void sock_handler(int fd, short revents, void *user_data)
+{
+	int received = zsock_recv(fd, recv_buf, sizeof(recv_buf) - 1, ZSOCK_MSG_DONTWAIT);
+
+	if (received < 0) {
+		if (errno == EAGAIN) {
+			return;
+		}
+		LOG_ERR("Socket error: %d, exit", errno);
+		reactor_stop();
+		return;
+	} else if (received == 0) {
+		reactor_stop();
+		return;
+	}
+
+	if (IS_ENABLED(CONFIG_GNSS_REPORT_BINARY)) {
+		LOG_HEXDUMP_INF(recv_buf, received, "Data received from the server:");
+		return;
+	}
+
+	recv_buf[received] = 0;
+	LOG_INF("Data received from the server: (%s)", recv_buf);
+}
+
 int main(void)
 {
 	int err;
-	int received;
 
 	if (dk_leds_init() != 0) {
 		LOG_ERR("Failed to initialize the LED library");
@@ -274,27 +412,25 @@ int main(void)
 		return 0;
 	}
 
+	tx_queue_init(report_send);
+
 	if (gnss_init_and_start() != 0) {
 		LOG_ERR("Failed to initialize and start GNSS");
 		return 0;
 	}
 
-	while (1) {
-		received = zsock_recv(sock, recv_buf, sizeof(recv_buf) - 1, 0);
-
-		if (received < 0) {
-			LOG_ERR("Socket error: %d, exit", errno);
-			break;
-		} else if (received == 0) {
-			break;
-		}
-
-		recv_buf[received] = 0;
-		LOG_INF("Data received from the server: (%s)", recv_buf);
+	err = reactor_fd_add(sock, ZSOCK_POLLIN, sock_handler, NULL);
+	if (err) {
+		LOG_ERR("Failed to add the socket to the reactor: %d", err);
+		return 0;
+	}
 
+	err = reactor_run();
+	if (err) {
+		LOG_ERR("Reactor failed: %d", err);
 	}
 
 	(void)zsock_close(sock);
 
 	return 0;
-}
+}
\ No newline at end of file
@@ -15,6 +15,14 @@
 #include <dk_buttons_and_leds.h>
 #include <modem/nrf_modem_lib.h>
 #include <modem/lte_lc.h>
+#include <cellfund/conn_mgr.h>
+#include <cellfund/resolver.h>
+#include <cellfund/tx_queue.h>
+#include <cellfund/reactor.h>
+#include <cellfund/coap_dedup.h>
+#include <cellfund/coap_rto.h>
+#include <cellfund/coap_exchange.h>
+#include <cellfund/lte_timer.h>
 
 #include <zephyr/random/random.h>
 
@@ -29,18 +37,34 @@
 #define APP_COAP_MAX_MSG_LEN 1280
 #define APP_COAP_VERSION 1
 
+/* Request types in the send queue */
+#define MSG_GET 0
+#define MSG_PUT 1
+
 /* STEP 9.1 - Define the interval for pinging the server */
  #define TX_KEEP_ALIVE_INTERVAL 6500
 
-/* STEP 9.2 - Define the delayable work item */
-static struct k_work_delayable rx_work;
+/* STEP 9.2 - Define the keepalive timer, run by the reactor in the main thread */
+static struct reactor_timer rx_timer;
+
+/* Retransmits the outstanding request, run by the reactor */
+static struct reactor_timer retx_timer;
+
+/* The outstanding confirmable request, only one at a time */
+static K_MUTEX_DEFINE(exchange_lock);
+static K_SEM_DEFINE(exchange_sem, 0, 1);
+static struct coap_exchange exchange;
+static bool exchange_pending;
+static uint16_t exchange_len;
+static int exchange_result;
 
 static uint8_t coap_buf[APP_COAP_MAX_MSG_LEN];
+/* Responses go here, coap_buf keeps the request until it is answered */
+static uint8_t coap_rxbuf[APP_COAP_MAX_MSG_LEN];
 static uint16_t next_token;
 static int sock;
 static struct sockaddr_storage server;
-
-K_SEM_DEFINE(lte_connected, 0, 1);
+static socklen_t server_len;
 
 LOG_MODULE_REGISTER(Lesson7_Exercise1, LOG_LEVEL_INF);
 
@@ -48,54 +72,25 @@ LOG_MODULE_REGISTER(Lesson7_Exercise1, LOG_LEVEL_INF);
 /**@brief Resolves the configured hostname. */
 static int server_resolve(void)
 {
-	int err;
-	struct zsock_addrinfo *result;
-	struct zsock_addrinfo hints = {
-		.ai_family = AF_INET,
-		.ai_socktype = SOCK_DGRAM
-	};
-	char ipv4_addr[NET_IPV4_ADDR_LEN];
-
-	err = zsock_getaddrinfo(CONFIG_COAP_SERVER_HOSTNAME, NULL, &hints, &result);
-	if (err != 0) {
-		LOG_ERR("ERROR: getaddrinfo failed %d\n", err);
-		return -EIO;
-	}
-
-	if (result == NULL) {
-		LOG_ERR("ERROR: Address not found\n");
-		return -ENOENT;
-	}
-
-	/* IPv4 Address. */
-	struct sockaddr_in *server4 = ((struct sockaddr_in *)&server);
-
-	server4->sin_addr.s_addr =
-		((struct sockaddr_in *)result->ai_addr)->sin_addr.s_addr;
-	server4->sin_family = AF_INET;
-	server4->sin_port = htons(CONFIG_COAP_SERVER_PORT);
-
-	zsock_inet_ntop(AF_INET, &server4->sin_addr.s_addr, ipv4_addr,
-		  sizeof(ipv4_addr));
-	LOG_INF("IPv4 Address found %s\n", ipv4_addr);
-
-	/* Free the address. */
-	zsock_freeaddrinfo(result);
-
-	return 0;
+	return resolver_lookup(CONFIG_COAP_SERVER_HOSTNAME, CONFIG_COAP_SERVER_PORT, SOCK_DGRAM, &server, &server_len);
 }
 
 /**@brief Initialize the CoAP client */
 static int client_init(void)
 {
 	int err;
+#if defined(CONFIG_COAP_SERVER_DTLS)
 	/* STEP 6.1 - Create a DTLS socket */
-	sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_DTLS_1_2);
+	sock = zsock_socket(server.ss_family, SOCK_DGRAM, IPPROTO_DTLS_1_2);
+#else
+	sock = zsock_socket(server.ss_family, SOCK_DGRAM, IPPROTO_UDP);
+#endif
 	if (sock < 0) {
 		LOG_ERR("Failed to create CoAP socket: %d.\n", errno);
 		return -errno;
 	}
 
+#if defined(CONFIG_COAP_SERVER_DTLS)
 	/* STEP 7.1 - Set peer verification to be required */
 	enum {
 		NONE = 0,
@@ -128,9 +123,9 @@ static int client_init(void)
 		LOG_ERR("Failed to setup socket security tag, errno %d\n", errno);
 		return -errno;
 	}
+#endif
 
-	err = zsock_connect(sock, (struct sockaddr *)&server,
-		      sizeof(struct sockaddr_in));
+	err = zsock_connect(sock, (struct sockaddr *)&server, server_len);
 	if (err < 0) {
 		LOG_ERR("Connect failed : %d\n", errno);
 		return -errno;
@@ -143,48 +138,12 @@ static int client_init(void)
 	return 0;
 }
 
-static void lte_handler(const struct lte_lc_evt *const evt)
-{
-     switch (evt->type) {
-     case LTE_LC_EVT_NW_REG_STATUS:
-        if ((evt->nw_reg_status != LTE_LC_NW_REG_REGISTERED_HOME) &&
-            (evt->nw_reg_status != LTE_LC_NW_REG_REGISTERED_ROAMING)) {
-            break;
-        }
-		LOG_INF("Network registration status: %s",
-				evt->nw_reg_status == LTE_LC_NW_REG_REGISTERED_HOME ?
-				"Connected - home network" : "Connected - roaming");
-		k_sem_give(&lte_connected);
-        break;
-	case LTE_LC_EVT_RRC_UPDATE:
-		LOG_INF("RRC mode: %s", evt->rrc_mode == LTE_LC_RRC_MODE_CONNECTED ?
-				"Connected" : "Idle");
-		break;
-	case LTE_LC_EVT_PSM_UPDATE:
-		LOG_INF("PSM parameter update: Periodic TAU: %d s, Active time: %d s",
-			evt->psm_cfg.tau, evt->psm_cfg.active_time);
-		if (evt->psm_cfg.active_time == -1){
-			LOG_ERR("Network rejected PSM parameters. Failed to setup network");
-		}
-		break;
-	case LTE_LC_EVT_EDRX_UPDATE:
-		LOG_INF("eDRX parameter update: eDRX: %f, PTW: %f",
-			(double)evt->edrx_cfg.edrx, (double)evt->edrx_cfg.ptw);
-		break;
-     default:
-             break;
-     }
-}
-
 static int modem_configure(void)
 {
 	int err;
 
-	LOG_INF("Initializing modem library");
-
-	err = nrf_modem_lib_init();
+	err = conn_mgr_init();
 	if (err) {
-		LOG_ERR("Failed to initialize the modem library, error: %d", err);
 		return err;
 	}
 
@@ -203,6 +162,11 @@ static int modem_configure(void)
 	}
 
 
+	err = lte_timer_init();
+	if (err) {
+		LOG_ERR("lte_timer_init, error: %d", err);
+	}
+
 	err = lte_lc_psm_req(true);
 	if (err) {
 		LOG_ERR("lte_lc_psm_req, error: %d", err);
@@ -213,20 +177,88 @@ static int modem_configure(void)
 		LOG_ERR("lte_lc_edrx_req, error: %d", err);
 	}
 
-	LOG_INF("Connecting to LTE network");
-	err = lte_lc_connect_async(lte_handler);
+	err = conn_mgr_connect(K_SECONDS(CONFIG_CONN_MGR_CONNECT_TIMEOUT));
 	if (err) {
-		LOG_ERR("Error in lte_lc_connect_async, error: %d", err);
 		return err;
 	}
 
-	k_sem_take(&lte_connected, K_FOREVER);
+	conn_mgr_wait_connected(K_FOREVER);
 	LOG_INF("Connected to LTE network");
 	dk_set_led_on(DK_LED2);
 
 	return 0;
 }
 
+/* Sends the request and starts its retransmission timeout */
+static int exchange_start(const struct coap_packet *request)
+{
+	uint32_t timeout;
+	int err = 0;
+
+	k_sem_reset(&exchange_sem);
+
+	k_mutex_lock(&exchange_lock, K_FOREVER);
+	timeout = coap_exchange_start(&exchange, (struct sockaddr *)&server, request);
+	exchange_len = request->offset;
+	exchange_pending = true;
+
+	if (zsock_send(sock, request->data, request->offset, 0) < 0) {
+		err = -errno;
+		exchange_pending = false;
+	}
+	k_mutex_unlock(&exchange_lock);
+
+	if (!err) {
+		reactor_timer_start(&retx_timer, timeout);
+	}
+
+	return err;
+}
+
+/* Ends the outstanding exchange when it is answered or given up */
+static void exchange_end(int result)
+{
+	k_mutex_lock(&exchange_lock, K_FOREVER);
+	if (!exchange_pending) {
+		k_mutex_unlock(&exchange_lock);
+		return;
+	}
+
+	exchange_pending = false;
+	exchange_result = result;
+	k_mutex_unlock(&exchange_lock);
+
+	reactor_timer_stop(&retx_timer);
+	k_sem_give(&exchange_sem);
+}
+
+static void retx_timer_fn(struct reactor_timer *timer)
+{
+	int timeout;
+
+	k_mutex_lock(&exchange_lock, K_FOREVER);
+	if (!exchange_pending) {
+		k_mutex_unlock(&exchange_lock);
+		return;
+	}
+
+	/* An acknowledged request is not retransmitted, its response is late */
+	timeout = exchange.acked ? -ETIMEDOUT : coap_rto_retransmit(&exchange.rto);
+	if (timeout >= 0 && zsock_send(sock, coap_buf, exchange_len, 0) < 0) {
+		timeout = -errno;
+	}
+	k_mutex_unlock(&exchange_lock);
+
+	if (timeout < 0) {
+		LOG_ERR("CoAP request failed: %d\n", timeout);
+		exchange_end(timeout);
+		return;
+	}
+
+	LOG_INF("CoAP request retransmitted, timeout %d ms", timeout);
+	reactor_timer_start(&retx_timer, timeout);
+}
+
 /**@biref Send CoAP GET request. */
 static int client_get_send(void)
 {
@@ -236,7 +268,7 @@ static int client_get_send(void)
 	next_token++;
 
 	err = coap_packet_init(&request, coap_buf, sizeof(coap_buf),
-			       APP_COAP_VERSION, COAP_TYPE_NON_CON,
+			       APP_COAP_VERSION, COAP_TYPE_CON,
 			       sizeof(next_token), (uint8_t *)&next_token,
 			       COAP_METHOD_GET, coap_next_id());
 	if (err < 0) {
@@ -252,10 +284,10 @@ static int client_get_send(void)
 		return err;
 	}
 
-	err = zsock_send(sock, request.data, request.offset, 0);
-	if (err < 0) {
-		LOG_ERR("Failed to send CoAP request, %d\n", errno);
-		return -errno;
+	err = exchange_start(&request);
+	if (err) {
+		LOG_ERR("Failed to send CoAP request, %d\n", err);
+		return err;
 	}
 
 	LOG_INF("CoAP GET request sent: Token 0x%04x\n", next_token);
@@ -271,7 +303,7 @@ static int client_put_send(void)
 	next_token++;
 
 	err = coap_packet_init(&request, coap_buf, sizeof(coap_buf),
-			       APP_COAP_VERSION, COAP_TYPE_NON_CON,
+			       APP_COAP_VERSION, COAP_TYPE_CON,
 			       sizeof(next_token), (uint8_t *)&next_token,
 			       COAP_METHOD_PUT, coap_next_id());
 	if (err < 0) {
@@ -308,10 +340,10 @@ static int client_put_send(void)
 		return err;
 	}
 
-	err = zsock_send(sock, request.data, request.offset, 0);
-	if (err < 0) {
-		LOG_ERR("Failed to send CoAP request, %d\n", errno);
-		return -errno;
+	err = exchange_start(&request);
+	if (err) {
+		LOG_ERR("Failed to send CoAP request, %d\n", err);
+		return err;
 	}
 
 	LOG_INF("CoAP PUT request sent: Token 0x%04x\n", next_token);
@@ -319,6 +351,21 @@ static int client_put_send(void)
 	return 0;
 }
 
+/**@brief Logs the retransmission timeout estimate for the server. */
+static void rto_stats_log(void)
+{
+	struct coap_rto_stats stats;
+
+	if (coap_rto_stats_get((struct sockaddr *)&server, &stats) != 0) {
+		return;
+	}
+
+	LOG_INF("RTO %u ms: strong RTT %u ms var %u ms (%u), weak RTT %u ms var %u ms (%u), "
+		"%u retransmissions, %u timeouts", stats.rto_ms, stats.strong_rtt_ms,
+		stats.strong_rttvar_ms, stats.strong_samples, stats.weak_rtt_ms,
+		stats.weak_rttvar_ms, stats.weak_samples, stats.retransmissions, stats.timeouts);
+}
+
 /**@brief Handles responses from the remote CoAP server. */
 static int client_handle_response(uint8_t *buf, int received)
 {
@@ -327,8 +374,8 @@ static int client_handle_response(uint8_t *buf, int received)
 	const uint8_t *payload;
 	uint16_t payload_len;
 	uint8_t token[8];
-	uint16_t token_len;
 	uint8_t temp_buf[128];
+	enum coap_exchange_match match = COAP_EXCHANGE_OTHER;
 
 	err = coap_packet_parse(&reply, buf, received, NULL, 0);
 	if (err < 0) {
@@ -336,18 +383,50 @@ static int client_handle_response(uint8_t *buf, int received)
 		return err;
 	}
 
+	/* Server retransmissions are acknowledged again but not handled twice */
+	if (coap_dedup_rx(sock, (struct sockaddr *)&server, &reply) == -EALREADY) {
+		LOG_INF("Duplicate message 0x%04x ignored", coap_header_get_id(&reply));
+		return 0;
+	}
+
+	/* ACKs and resets are matched by message ID, responses by token */
+	k_mutex_lock(&exchange_lock, K_FOREVER);
+	if (exchange_pending) {
+		match = coap_exchange_rx(&exchange, sock, &reply);
+	}
+	k_mutex_unlock(&exchange_lock);
+
+	if (match == COAP_EXCHANGE_ACKED) {
+		/* The response follows separately, only its wait is limited */
+		LOG_INF("CoAP request acknowledged, waiting for the response");
+		reactor_timer_start(&retx_timer, CONFIG_COAP_EXCHANGE_SEPARATE_TIMEOUT * MSEC_PER_SEC);
+		rto_stats_log();
+		return 0;
+	} else if (match == COAP_EXCHANGE_RESET) {
+		LOG_ERR("CoAP request rejected by the server\n");
+		exchange_end(-ECONNRESET);
+		return 0;
+	}
+
 	payload = coap_packet_get_payload(&reply, &payload_len);
-	token_len = coap_header_get_token(&reply, token);
+	(void)coap_header_get_token(&reply, token);
+
+	if (match == COAP_EXCHANGE_OTHER) {
+		if (coap_header_get_code(&reply) == COAP_CODE_EMPTY) {
+			/* A late ACK of a retransmission */
+			return 0;
+		}
 
-	if ((token_len != sizeof(next_token)) ||
-	    (memcmp(&next_token, token, sizeof(next_token)) != 0)) {
 		LOG_ERR("Invalid token received: 0x%02x%02x\n",
 		       token[1], token[0]);
 		return 0;
 	}
 
 	if (payload_len > 0) {
-		snprintf(temp_buf, MIN(payload_len + 1, sizeof(temp_buf)), "%s", payload);
+		/* The payload is not terminated, a bounded copy is enough */
+		payload_len = MIN(payload_len, sizeof(temp_buf) - 1);
+		memcpy(temp_buf, payload, payload_len);
+		temp_buf[payload_len] = '\0';
 	} else {
 		strcpy(temp_buf, "EMPTY");
 	}
@@ -355,40 +434,93 @@ static int client_handle_response(uint8_t *buf, int received)
 	LOG_INF("CoAP response: Code 0x%x, Token 0x%02x%02x, Payload: %s\n",
 	       coap_header_get_code(&reply), token[1], token[0], temp_buf);
 
+	exchange_end(0);
+	rto_stats_log();
+
 	return 0;
 }
 
+/* Runs in the send queue thread, so a busy modem does not block the buttons */
+static int request_send(uint8_t type, const uint8_t *data, size_t len)
+{
+	int err = type == MSG_PUT ? client_put_send() : client_get_send();
+
+	if (err) {
+		return err;
+	}
+
+	/* The next request stays queued until this one is answered or given up */
+	k_sem_take(&exchange_sem, K_FOREVER);
+
+	return exchange_result;
+}
+
+/* Requests of a type are all the same, a queued one is as good as a new one */
+static void request_queue(uint8_t type)
+{
+	(void)tx_queue_put(type, NULL, 0, TX_QUEUE_COALESCE);
+}
+
 static void button_handler(uint32_t button_state, uint32_t has_changed)
 {
 	#if defined (CONFIG_DK)
 	if (has_changed & DK_BTN1_MSK && button_state & DK_BTN1_MSK) {
-		client_get_send();
+		request_queue(MSG_GET);
 	} else if (has_changed & DK_BTN2_MSK && button_state & DK_BTN2_MSK) {
-		client_put_send();
+		request_queue(MSG_PUT);
 	}
 	#elif defined (CONFIG_THINGY)
 	static bool toogle = 1;
 	if (has_changed & DK_BTN1_MSK && button_state & DK_BTN1_MSK) {
 		if (toogle ==1) {
-			client_get_send();
+			request_queue(MSG_GET);
 		} else {
-			client_put_send();
+			request_queue(MSG_PUT);
 		}
 		toogle = !toogle;
 	}
 	#endif
 }
 
-/* STEP 9.3 - Define the handler for the work item */
-static void rx_work_fn(struct k_work *work)
+/* STEP 9.3 - Define the handler for the timer */
+static void rx_timer_fn(struct reactor_timer *timer)
 {
-	client_get_send();
+	request_queue(MSG_GET);
+}
+
+/* Called by the reactor when the socket has data */
+static void sock_handler(int fd, short revents, void *user_data)
+{
+	int err;
+	int received = zsock_recv(fd, coap_rxbuf, sizeof(coap_rxbuf), ZSOCK_MSG_DONTWAIT);
+
+	if (received < 0) {
+		if (errno == EAGAIN) {
+			return;
+		}
+		LOG_ERR("Socket error:  %d, exit\n", errno);
+		reactor_stop();
+		return;
+	}
+
+	/* STEP 9.5 - Restart the timer, the server is pinged after a quiet interval */
+	reactor_timer_start(&rx_timer, TX_KEEP_ALIVE_INTERVAL);
+
+	if (received == 0) {
+		LOG_ERR("Empty datagram\n");
+		return;
+	}
+
+	err = client_handle_response(coap_rxbuf, received);
+	if (err < 0) {
+		LOG_ERR("Invalid response, exit\n");
+		reactor_stop();
+	}
 }
 
 int main(void)
 {
 	int err;
-	int received;
 
 	if (dk_leds_init() != 0) {
 		LOG_ERR("Failed to initialize the LED library");
@@ -414,29 +546,23 @@ int main(void)
 		return 0;
 	}
 
-	/* STEP 9.4 - Initialize the work item rx_work with the handler function */
-	k_work_init_delayable(&rx_work, rx_work_fn);
-
-	while (1) {
-		/* STEP 9.5 - Schedule the work item rx_work with a delay */
-		k_work_reschedule(&rx_work,K_MSEC(TX_KEEP_ALIVE_INTERVAL));
+	reactor_timer_init(&retx_timer, retx_timer_fn);
+	tx_queue_init(request_send);
 
-		received = zsock_recv(sock, coap_buf, sizeof(coap_buf), 0);
+	/* STEP 9.4 - Initialize the timer with the handler function and start it */
+	reactor_timer_init(&rx_timer, rx_timer_fn);
+	reactor_timer_start(&rx_timer, TX_KEEP_ALIVE_INTERVAL);
 
-		if (received < 0) {
-			LOG_ERR("Socket error:  %d, exit\n", errno);
-			break;
-		} else if (received == 0) {
-			LOG_ERR("Empty datagram\n");
-			continue;
-		}
-
-		err = client_handle_response(coap_buf, received);
-		if (err < 0) {
-			LOG_ERR("Invalid response, exit\n");
-			break;
-		}
+	/* The main thread waits for the socket and the timer */
+	err = reactor_fd_add(sock, ZSOCK_POLLIN, sock_handler, NULL);
+	if (err) {
+		LOG_ERR("Failed to add the socket to the reactor: %d\n", err);
+		return 0;
+	}
 
+	err = reactor_run();
+	if (err) {
+		LOG_ERR("Reactor failed: %d\n", err);
 	}
 
 	(void)zsock_close(sock);
@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "geofences.h"
+
+/* Example yard, replace with your own fences. Coordinates are in 1e-7 degrees. */
+static const struct geofence_vertex yard[] = {
+	{ 634296000, 104006000 },
+	{ 634296000, 104030000 },
+	{ 634310000, 104030000 },
+	{ 634310000, 104006000 },
+};
+
+const struct geofence tracker_fences[] = {
+	GEOFENCE_POLYGON_INIT("yard", yard),
+	GEOFENCE_CIRCLE_INIT("gate", 634303000, 104018000, 50),
+};
+
+const size_t tracker_fence_count = ARRAY_SIZE(tracker_fences);
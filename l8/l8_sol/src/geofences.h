@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef GEOFENCES_H_
+#define GEOFENCES_H_
+
+#include <cellfund/geofence.h>
+
+/* Fences that the tracker reports crossings of, kept in flash */
+extern const struct geofence tracker_fences[];
+extern const size_t tracker_fence_count;
+
+#endif /* GEOFENCES_H_ */
@@ -13,10 +13,46 @@
 #include <zephyr/net/socket.h>
 #include <modem/nrf_modem_lib.h>
 #include <modem/lte_lc.h>
+#include <cellfund/conn_mgr.h>
+#include <cellfund/resolver.h>
+#include <cellfund/coap_rto.h>
+#include <cellfund/coap_exchange.h>
 #include <zephyr/net/tls_credentials.h>
 #include <modem/modem_key_mgmt.h>
 #include <dk_buttons_and_leds.h>
 #include <nrf_modem_gnss.h>
+#include <cellfund/gnss_pipeline.h>
+#include <cellfund/fixfmt.h>
+#if defined(CONFIG_POS_FILTER)
+#include <cellfund/pos_filter.h>
+#endif
+#if defined(CONFIG_TRACK_SIMPLIFY)
+#include <cellfund/track_simplify.h>
+#endif
+#if defined(CONFIG_TRACKER_GEOFENCE)
+#include "geofences.h"
+#endif
+#if defined(CONFIG_UPLOAD_SCHED)
+#include <cellfund/upload_sched.h>
+#endif
+#if defined(CONFIG_RAT_SELECT)
+#include <cellfund/rat_select.h>
+#endif
+#if defined(CONFIG_ATTACH_HINT)
+#include <cellfund/attach_hint.h>
+#endif
+#if !defined(CONFIG_TRACKER_RADIO_DETACH)
+#include <cellfund/lte_timer.h>
+#endif
+#if defined(CONFIG_TRACKER_CELL_FALLBACK)
+#include <cellfund/cell_meas.h>
+#endif
+#if defined(CONFIG_COAP_DEDUP)
+#include <cellfund/coap_dedup.h>
+#endif
+#if defined(CONFIG_MEM_PROF)
+#include <cellfund/mem_prof.h>
+#endif
 
 #include <zephyr/random/random.h>
 
@@ -26,38 +62,248 @@
 #define APP_COAP_VERSION 1
 static int sock;
 static struct sockaddr_storage server;
+static socklen_t server_len;
 static uint16_t next_token;
-K_SEM_DEFINE(lte_connected, 0, 1);
+/* The outstanding confirmable request */
+static struct coap_exchange exchange;
 K_SEM_DEFINE(gnss_fix_sem, 0, 1);
 LOG_MODULE_REGISTER(Cellfund_Project, LOG_LEVEL_INF);
 static uint8_t coap_buf[APP_COAP_MAX_MSG_LEN];
-static uint8_t coap_sendbug[64];
+/* Responses go here, coap_buf keeps the request until it is answered */
+static uint8_t coap_rxbuf[APP_COAP_MAX_MSG_LEN];
+/* Longest encoding of one fix */
+#define FIX_PAYLOAD_MAX_LEN 64
+#if defined(CONFIG_TRACKER_CELL_FALLBACK)
+static uint8_t coap_sendbug[MAX(FIX_PAYLOAD_MAX_LEN * CONFIG_TRACKER_FIXES_PER_UPLOAD,
+				CELL_MEAS_RECORD_MAX_LEN)];
+#else
+static uint8_t coap_sendbug[FIX_PAYLOAD_MAX_LEN * CONFIG_TRACKER_FIXES_PER_UPLOAD];
+#endif
 static struct nrf_modem_gnss_pvt_data_frame current_pvt;
 static struct nrf_modem_gnss_pvt_data_frame last_pvt;
 static enum tracker_status {status_nolte = DK_LED1, status_searching = DK_LED2, status_fixed = DK_LED3} device_status;
 static int resolve_address_lock = 0;
-static void print_fix_data(struct nrf_modem_gnss_pvt_data_frame *pvt_data)
+#if defined(CONFIG_POS_FILTER)
+static struct pos_filter pos_filter;
+#endif
+
+/* Fixes buffered between uploads */
+struct tracker_fix {
+	int32_t lat_e7;
+	int32_t lon_e7;
+	uint32_t accuracy_mm;
+	struct nrf_modem_gnss_datetime datetime;
+};
+static struct tracker_fix fix_buf[CONFIG_TRACKER_FIXES_PER_UPLOAD];
+static size_t fix_count;
+K_MUTEX_DEFINE(fix_buf_lock);
+/* Set when the buffered fixes should be sent without waiting for a good link */
+static atomic_t upload_urgent;
+#if defined(CONFIG_TRACKER_CELL_FALLBACK)
+/* Set when GNSS timed out and the cells should be uploaded instead */
+static atomic_t cell_fallback;
+static struct cell_meas_record cell_record;
+#endif
+
+#if defined(CONFIG_TRACK_SIMPLIFY)
+BUILD_ASSERT(CONFIG_TRACKER_FIXES_PER_UPLOAD <= CONFIG_TRACK_SIMPLIFY_MAX_POINTS);
+#endif
+
+/**@brief Buffers a fix, returns true once enough fixes are buffered for an upload. */
+static bool fix_buf_add(const struct nrf_modem_gnss_pvt_data_frame *pvt_data)
 {
-	printk("Latitude:       %.06f\n", pvt_data->latitude);
-	printk("Longitude:      %.06f\n", pvt_data->longitude);
-	printk("Altitude:       %.01f m\n", (double)pvt_data->altitude);
-	printk("Time (UTC):     %02u:%02u:%02u.%03u\n",
-	       pvt_data->datetime.hour,
-	       pvt_data->datetime.minute,
-	       pvt_data->datetime.seconds,
-	       pvt_data->datetime.ms);
+	struct tracker_fix *fix;
+	bool full;
+
+	k_mutex_lock(&fix_buf_lock, K_FOREVER);
+
+	/* If the previous upload is still ongoing, the newest fix replaces the last one */
+	fix = &fix_buf[MIN(fix_count, ARRAY_SIZE(fix_buf) - 1)];
+	fix->lat_e7 = fixfmt_deg_to_e7(pvt_data->latitude);
+	fix->lon_e7 = fixfmt_deg_to_e7(pvt_data->longitude);
+	fix->accuracy_mm = (uint32_t)(pvt_data->accuracy * 1000.0f);
+	fix->datetime = pvt_data->datetime;
+	fix_count = MIN(fix_count + 1, ARRAY_SIZE(fix_buf));
+	full = fix_count == ARRAY_SIZE(fix_buf);
+
+	k_mutex_unlock(&fix_buf_lock);
+
+	return full;
 }
 
-static void gnss_event_handler(int event)
+/**@brief Upper bound of the payload size for the buffered fixes. */
+static size_t fix_buf_payload_len(void)
+{
+	size_t len;
+
+	k_mutex_lock(&fix_buf_lock, K_FOREVER);
+	len = fix_count * FIX_PAYLOAD_MAX_LEN;
+	k_mutex_unlock(&fix_buf_lock);
+
+	return len;
+}
+
+/**@brief Upper bound of the payload size for the next upload. */
+static size_t upload_payload_len(bool cells)
+{
+#if defined(CONFIG_TRACKER_CELL_FALLBACK)
+	if (cells) {
+		return CELL_MEAS_RECORD_LEN(cell_record.ncell_count);
+	}
+#endif
+	return fix_buf_payload_len();
+}
+
+#if defined(CONFIG_TRACKER_GEOFENCE)
+static void geofence_handler(const struct geofence_evt *evt)
+{
+	LOG_INF("Geofence %s: %s", evt->type == GEOFENCE_EVT_ENTER ? "entered" : "left",
+		evt->fence->name);
+}
+#endif
+
+#if !defined(CONFIG_TRACKER_RADIO_DETACH)
+/**@brief Requests the PSM or eDRX timers for tracking, or for a parked tracker. */
+static int radio_timers_set(bool parked)
 {
+#if defined(CONFIG_TRACKER_RADIO_PSM)
+	/* While tracking, the periodic TAU does not wake the modem between uploads */
+	uint32_t tau = parked ? CONFIG_LTE_TIMER_PSM_TAU :
+				CONFIG_TRACKER_PERIODIC_INTERVAL * CONFIG_TRACKER_FIXES_PER_UPLOAD;
+	uint32_t active_time = parked ? CONFIG_LTE_TIMER_PSM_ACTIVE_TIME :
+					CONFIG_TRACKER_PSM_ACTIVE_TIME;
+
+	LOG_INF("PSM for %s: TAU %u s, active time %u s", parked ? "parking" : "tracking",
+		tau, active_time);
+
+	return lte_timer_psm_set(tau, active_time);
+#else
 	int err;
-	switch (event) {
+
+	LOG_INF("eDRX for %s", parked ? "parking" : "tracking");
+
+	err = lte_timer_edrx_set(LTE_LC_LTE_MODE_LTEM,
+				 parked ? CONFIG_TRACKER_PARKED_EDRX : CONFIG_LTE_TIMER_EDRX_LTE_M,
+				 CONFIG_LTE_TIMER_PTW_LTE_M);
+	if (err) {
+		return err;
+	}
+
+	return lte_timer_edrx_set(LTE_LC_LTE_MODE_NBIOT,
+				  parked ? CONFIG_TRACKER_PARKED_EDRX : CONFIG_LTE_TIMER_EDRX_NBIOT,
+				  CONFIG_LTE_TIMER_PTW_NBIOT);
+#endif
+}
+
+#if defined(CONFIG_TRACKER_GEOFENCE)
+/* Set while the tracker is inside a geofence and only uploads crossings */
+static atomic_t radio_parked;
+
+static void radio_timers_work_fn(struct k_work *work)
+{
+	int err = radio_timers_set(atomic_get(&radio_parked));
+
+	if (err) {
+		LOG_ERR("Failed to set the radio timers, error: %d", err);
+	}
+}
+
+static K_WORK_DEFINE(radio_timers_work, radio_timers_work_fn);
+
+/**@brief Renegotiates the radio timers when the tracker parks or moves on. */
+static void radio_parked_set(bool parked)
+{
+	if (atomic_set(&radio_parked, parked) != parked) {
+		k_work_submit(&radio_timers_work);
+	}
+}
+#endif /* CONFIG_TRACKER_GEOFENCE */
+#endif /* !CONFIG_TRACKER_RADIO_DETACH */
+
+/**@brief Buffers a fix and decides whether it triggers an upload. */
+static void fix_handle(const struct nrf_modem_gnss_pvt_data_frame *pvt_data)
+{
+	bool upload;
+
+#if defined(CONFIG_TRACKER_GEOFENCE)
+	int crossings = geofence_update(fixfmt_deg_to_e7(pvt_data->latitude),
+					fixfmt_deg_to_e7(pvt_data->longitude));
+
+#if !defined(CONFIG_TRACKER_RADIO_DETACH)
+	radio_parked_set(geofence_inside_any());
+#endif
+
+	/* Only boundary crossings matter while inside a fence */
+	if (crossings == 0 && geofence_inside_any()) {
+		LOG_INF("Inside a geofence, routine upload suppressed");
+		return;
+	}
+
+	if (crossings > 0) {
+		atomic_set(&upload_urgent, true);
+	}
+
+	upload = fix_buf_add(pvt_data) || crossings > 0;
+#else
+	upload = fix_buf_add(pvt_data);
+#endif
+
+	if (upload) {
+		k_sem_give(&gnss_fix_sem);
+	}
+}
+
+static void print_fix_data(const struct nrf_modem_gnss_pvt_data_frame *pvt_data)
+{
+	char lat[FIXFMT_DEG_LEN], lon[FIXFMT_DEG_LEN], alt[16], time[FIXFMT_ISO8601_LEN];
+
+	fixfmt_deg_e7(lat, sizeof(lat), fixfmt_deg_to_e7(pvt_data->latitude));
+	fixfmt_deg_e7(lon, sizeof(lon), fixfmt_deg_to_e7(pvt_data->longitude));
+	fixfmt_mm(alt, sizeof(alt), (int64_t)(pvt_data->altitude * 1000.0f));
+	fixfmt_iso8601(time, sizeof(time), &pvt_data->datetime);
+
+	printk("Latitude:       %s\n", lat);
+	printk("Longitude:      %s\n", lon);
+	printk("Altitude:       %s m\n", alt);
+	printk("Time (UTC):     %s\n", time);
+}
+
+/**@brief Filters, prints and buffers a fix. */
+static void fix_received(const struct gnss_pipeline_evt *evt)
+{
+	device_status = status_fixed;
+	if (!evt->has_pvt) {
+		return;
+	}
+
+	last_pvt = evt->pvt;
+	current_pvt = last_pvt;
+#if defined(CONFIG_POS_FILTER)
+	/* Smooth out jitter before the fix is printed and uploaded */
+	struct pos_filter_output filtered;
+
+	if (pos_filter_update(&pos_filter, &current_pvt, &filtered) == 0) {
+		pos_filter_output_to_pvt(&filtered, &current_pvt);
+	}
+#endif
+	print_fix_data(&current_pvt);
+	fix_handle(&current_pvt);
+}
+
+/* Runs in the GNSS pipeline thread, the PVT frame was already read from the modem */
+static void gnss_event_handler(const struct gnss_pipeline_evt *evt)
+{
+	switch (evt->id) {
 	case NRF_MODEM_GNSS_EVT_PVT:
 		LOG_INF("Searching for GNSS Satellites....\n\r");
 		device_status = status_searching;
 		break;
 	case NRF_MODEM_GNSS_EVT_FIX:
 		LOG_INF("GNSS fix event\n\r");
+#if !defined(CONFIG_TRACKER_RADIO_DETACH)
+		/* Single fixes end here, there is no sleep event */
+		fix_received(evt);
+#endif
 		break;
 	case NRF_MODEM_GNSS_EVT_PERIODIC_WAKEUP:
 		LOG_INF("GNSS woke up in periodic mode\n\r");
@@ -67,16 +313,17 @@ static void gnss_event_handler(int event)
 		break;
 	case NRF_MODEM_GNSS_EVT_SLEEP_AFTER_FIX:
 		LOG_INF("GNSS enters sleep because fix was achieved in periodic mode\n\r");
-		device_status = status_fixed;
-		err = nrf_modem_gnss_read(&last_pvt, sizeof(last_pvt), NRF_MODEM_GNSS_DATA_PVT);
-		if (err == 0){
-			current_pvt = last_pvt;
-			print_fix_data(&current_pvt);
-			k_sem_give(&gnss_fix_sem);
-		}
+		fix_received(evt);
 		break;
 	case NRF_MODEM_GNSS_EVT_SLEEP_AFTER_TIMEOUT:
 		LOG_INF("GNSS enters sleep because fix retry timeout was reached\n\r");
+#if defined(CONFIG_TRACKER_CELL_FALLBACK)
+		/* Buffered fixes are a better position than the cells */
+		if (fix_buf_payload_len() == 0) {
+			atomic_set(&cell_fallback, true);
+			k_sem_give(&gnss_fix_sem);
+		}
+#endif
 		break;
 
 	default:
@@ -85,6 +332,67 @@ static void gnss_event_handler(int event)
 	}
 }
 
+#if !defined(CONFIG_TRACKER_RADIO_DETACH)
+/* GNSS runs single fixes that are started in the modem's sleep windows,
+ * so GNSS and LTE never compete for the radio.
+ */
+static void gnss_window_work_fn(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(gnss_window_work, gnss_window_work_fn);
+/* Uptime when the next fix is due, in ms. */
+static int64_t gnss_due;
+static atomic_t gnss_waiting;
+
+/**@brief True when the modem leaves the radio to GNSS. */
+static bool radio_idle(void)
+{
+	struct conn_mgr_state link;
+
+	conn_mgr_state_get(&link);
+	if (!link.registered) {
+		return !link.requested;
+	}
+
+#if defined(CONFIG_TRACKER_RADIO_PSM)
+	return link.modem_asleep;
+#else
+	return !link.rrc_connected;
+#endif
+}
+
+static void gnss_window_work_fn(struct k_work *work)
+{
+	int64_t late_ms = k_uptime_get() - gnss_due;
+
+	if (!radio_idle() && late_ms < CONFIG_TRACKER_GNSS_WINDOW_MAX_DELAY * MSEC_PER_SEC) {
+		/* Started from radio_handler() when the modem goes to sleep */
+		atomic_set(&gnss_waiting, true);
+		k_work_reschedule(&gnss_window_work,
+				  K_MSEC(CONFIG_TRACKER_GNSS_WINDOW_MAX_DELAY * MSEC_PER_SEC - late_ms));
+		return;
+	}
+
+	atomic_set(&gnss_waiting, false);
+	if (late_ms > 0) {
+		LOG_INF("GNSS started %u ms late, waiting for the modem to sleep", (uint32_t)late_ms);
+	}
+
+	if (nrf_modem_gnss_start() != 0) {
+		LOG_ERR("Failed to start GNSS");
+	}
+
+	gnss_due += CONFIG_TRACKER_PERIODIC_INTERVAL * MSEC_PER_SEC;
+	k_work_reschedule(&gnss_window_work, K_MSEC(MAX(gnss_due - k_uptime_get(), 0)));
+}
+
+static void radio_handler(const struct conn_mgr_evt *evt)
+{
+	if ((evt->type == CONN_MGR_EVT_MODEM_SLEEP_ENTER || evt->type == CONN_MGR_EVT_RRC_IDLE) &&
+	    atomic_get(&gnss_waiting)) {
+		k_work_reschedule(&gnss_window_work, K_NO_WAIT);
+	}
+}
+#endif /* !CONFIG_TRACKER_RADIO_DETACH */
+
 static int gnss_init_and_start(void)
 {
 #if defined(CONFIG_GNSS_HIGH_ACCURACY_TIMING_SOURCE)
@@ -102,21 +410,30 @@ static int gnss_init_and_start(void)
 	}
 #endif
 	/* Configure GNSS event handler . */
-	if (nrf_modem_gnss_event_handler_set(gnss_event_handler) != 0) {
+	if (gnss_pipeline_init(gnss_event_handler) != 0) {
 		LOG_ERR("Failed to set GNSS event handler");
 		return -1;
 	}
 
+#if defined(CONFIG_TRACKER_RADIO_DETACH)
 	if (nrf_modem_gnss_fix_interval_set(CONFIG_TRACKER_PERIODIC_INTERVAL) != 0) {
 		LOG_ERR("Failed to set GNSS fix interval");
 		return -1;
 	}
+#else
+	/* Single fixes, scheduled by gnss_window_work */
+	if (nrf_modem_gnss_fix_interval_set(0) != 0) {
+		LOG_ERR("Failed to set GNSS fix interval");
+		return -1;
+	}
+#endif
 
 	if (nrf_modem_gnss_fix_retry_set(CONFIG_TRACKER_PERIODIC_TIMEOUT) != 0) {
 		LOG_ERR("Failed to set GNSS fix retry");
 		return -1;
 	}
 
+#if defined(CONFIG_TRACKER_RADIO_DETACH)
 	if (nrf_modem_gnss_start() != 0) {
 		LOG_ERR("Failed to start GNSS");
 		return -1;
@@ -125,47 +442,18 @@ static int gnss_init_and_start(void)
 		LOG_ERR("Error setting GNSS priority mode");
 		return -1;
 	}
+#else
+	/* LTE is not active yet, so the first fix starts right away */
+	gnss_due = k_uptime_get();
+	k_work_reschedule(&gnss_window_work, K_NO_WAIT);
+#endif
 	return 0;
 }
 
 /**@brief Resolves the configured hostname. */
 static int server_resolve(void)
 {
-	int err;
-	struct zsock_addrinfo *result;
-	struct zsock_addrinfo hints = {
-		.ai_family = AF_INET,
-		.ai_socktype = SOCK_DGRAM
-	};
-	char ipv4_addr[NET_IPV4_ADDR_LEN];
-
-	err = zsock_getaddrinfo(CONFIG_COAP_SERVER_HOSTNAME, NULL, &hints, &result);
-	if (err != 0) {
-		LOG_ERR("ERROR: getaddrinfo failed %d\n", err);
-		return -EIO;
-	}
-
-	if (result == NULL) {
-		LOG_ERR("ERROR: Address not found\n");
-		return -ENOENT;
-	}
-
-	/* IPv4 Address. */
-	struct sockaddr_in *server4 = ((struct sockaddr_in *)&server);
-
-	server4->sin_addr.s_addr =
-		((struct sockaddr_in *)result->ai_addr)->sin_addr.s_addr;
-	server4->sin_family = AF_INET;
-	server4->sin_port = htons(CONFIG_COAP_SERVER_PORT);
-
-	zsock_inet_ntop(AF_INET, &server4->sin_addr.s_addr, ipv4_addr,
-		  sizeof(ipv4_addr));
-	LOG_INF("IPv4 Address found %s\n", ipv4_addr);
-
-	/* Free the address. */
-	zsock_freeaddrinfo(result);
-
-	return 0;
+	return resolver_lookup(CONFIG_COAP_SERVER_HOSTNAME, CONFIG_COAP_SERVER_PORT, SOCK_DGRAM, &server, &server_len);
 }
 
 /**@brief Initialize the CoAP client */
@@ -173,12 +461,17 @@ static int server_connect(void)
 {
 	int err;
 
-	sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_DTLS_1_2);
+#if defined(CONFIG_COAP_SERVER_DTLS)
+	sock = zsock_socket(server.ss_family, SOCK_DGRAM, IPPROTO_DTLS_1_2);
+#else
+	sock = zsock_socket(server.ss_family, SOCK_DGRAM, IPPROTO_UDP);
+#endif
 	if (sock < 0) {
 		LOG_ERR("Failed to create CoAP socket: %d.\n", errno);
 		return -errno;
 	}
 
+#if defined(CONFIG_COAP_SERVER_DTLS)
 	int verify;
 	sec_tag_t sec_tag_list[] = { 12 };
 
@@ -210,9 +503,9 @@ static int server_connect(void)
 		LOG_ERR("Failed to setup socket security tag, errno %d\n", errno);
 		return -errno;
 	}
+#endif
 
-	err = zsock_connect(sock, (struct sockaddr *)&server,
-		      sizeof(struct sockaddr_in));
+	err = zsock_connect(sock, (struct sockaddr *)&server, server_len);
 	if (err < 0) {
 		LOG_ERR("Connect failed : %d\n", errno);
 		return -errno;
@@ -224,7 +517,10 @@ static int server_connect(void)
 	return 0;
 }
 
-/**@brief Handles responses from the remote CoAP server. */
+/**@brief Handles responses from the remote CoAP server.
+ * Returns -EINPROGRESS for an empty ACK of the request, and -EAGAIN for
+ * anything else than its response.
+ */
 static int client_handle_get_response(uint8_t *buf, int received)
 {
 	int err;
@@ -232,8 +528,8 @@ static int client_handle_get_response(uint8_t *buf, int received)
 	const uint8_t *payload;
 	uint16_t payload_len;
 	uint8_t token[8];
-	uint16_t token_len;
 	static uint8_t temp_buf[128];
+	enum coap_exchange_match match;
 
 	err = coap_packet_parse(&reply, buf, received, NULL, 0);
 	if (err < 0) {
@@ -241,18 +537,43 @@ static int client_handle_get_response(uint8_t *buf, int received)
 		return err;
 	}
 
+#if defined(CONFIG_COAP_DEDUP)
+	/* Server retransmissions are acknowledged again but not handled twice */
+	if (coap_dedup_rx(sock, (struct sockaddr *)&server, &reply) == -EALREADY) {
+		LOG_INF("Duplicate message 0x%04x ignored", coap_header_get_id(&reply));
+		return -EAGAIN;
+	}
+#endif
+
+	/* ACKs and resets are matched by message ID, responses by token */
+	match = coap_exchange_rx(&exchange, sock, &reply);
+	if (match == COAP_EXCHANGE_ACKED) {
+		LOG_INF("CoAP request acknowledged, waiting for the response");
+		return -EINPROGRESS;
+	} else if (match == COAP_EXCHANGE_RESET) {
+		LOG_ERR("CoAP request rejected by the server\n");
+		return -ECONNRESET;
+	}
+
 	payload = coap_packet_get_payload(&reply, &payload_len);
-	token_len = coap_header_get_token(&reply, token);
+	(void)coap_header_get_token(&reply, token);
+
+	if (match == COAP_EXCHANGE_OTHER) {
+		if (coap_header_get_code(&reply) == COAP_CODE_EMPTY) {
+			/* A late ACK of a retransmission */
+			return -EAGAIN;
+		}
 
-	if ((token_len != sizeof(next_token)) ||
-	    (memcmp(&next_token, token, sizeof(next_token)) != 0)) {
 		LOG_ERR("Invalid token received: 0x%02x%02x\n",
 		       token[1], token[0]);
-		return 0;
+		return -EAGAIN;
 	}
 
 	if (payload_len > 0) {
-		snprintf(temp_buf, MIN(payload_len + 1, sizeof(temp_buf)), "%s", payload);
+		/* The payload is not terminated, a bounded copy is enough */
+		payload_len = MIN(payload_len, sizeof(temp_buf) - 1);
+		memcpy(temp_buf, payload, payload_len);
+		temp_buf[payload_len] = '\0';
 	} else {
 		strcpy(temp_buf, "EMPTY");
 	}
@@ -262,60 +583,12 @@ static int client_handle_get_response(uint8_t *buf, int received)
 	return 0;
 }
 
-static void lte_handler(const struct lte_lc_evt *const evt)
-{
-	switch (evt->type) {
-	case LTE_LC_EVT_NW_REG_STATUS:
-		if ((evt->nw_reg_status != LTE_LC_NW_REG_REGISTERED_HOME) &&
-		     (evt->nw_reg_status != LTE_LC_NW_REG_REGISTERED_ROAMING)) {
-			break;
-		}
-
-		LOG_INF("Network registration status: %s\n",
-			evt->nw_reg_status == LTE_LC_NW_REG_REGISTERED_HOME ?
-			"Connected - home network" : "Connected - roaming\n");
-		k_sem_give(&lte_connected);
-		break;
-	case LTE_LC_EVT_PSM_UPDATE:
-		LOG_INF("PSM parameter update: TAU: %d, Active time: %d\n",
-			evt->psm_cfg.tau, evt->psm_cfg.active_time);
-		break;
-	case LTE_LC_EVT_EDRX_UPDATE: {
-		char log_buf[60];
-		ssize_t len;
-
-		len = snprintf(log_buf, sizeof(log_buf),
-			       "eDRX parameter update: eDRX: %f, PTW: %f\n",
-			       (double)evt->edrx_cfg.edrx, (double)evt->edrx_cfg.ptw);
-		if (len > 0) {
-			LOG_INF("%s\n", log_buf);
-		}
-		break;
-	}
-	case LTE_LC_EVT_RRC_UPDATE:
-		LOG_INF("RRC mode: %s\n",
-			evt->rrc_mode == LTE_LC_RRC_MODE_CONNECTED ?
-			"Connected" : "Idle\n");
-		break;
-	case LTE_LC_EVT_CELL_UPDATE:
-		LOG_INF("LTE cell changed: Cell ID: %d, Tracking area: %d\n",
-		       evt->cell.id, evt->cell.tac);
-		break;
-	default:
-		break;
-	}
-}
-
-
 static int modem_configure(void)
 {
 	int err;
 
-	LOG_INF("Initializing modem library");
-
-	err = nrf_modem_lib_init();
+	err = conn_mgr_init();
 	if (err) {
-		LOG_ERR("Failed to initialize the modem library, error: %d", err);
 		return err;
 	}
 
@@ -331,17 +604,21 @@ static int modem_configure(void)
 		return err;
 	}
 
-	
-	LOG_INF("Connecting to LTE network");
-	err = lte_lc_connect_async(lte_handler);
+#if !defined(CONFIG_TRACKER_RADIO_DETACH)
+	err = lte_timer_init();
 	if (err) {
-		LOG_ERR("Error in lte_lc_connect_async, error: %d", err);
-		return err;
+		LOG_ERR("lte_timer_init, error: %d", err);
 	}
 
+	/* Also requests PSM or eDRX */
+	err = radio_timers_set(false);
+	if (err) {
+		LOG_ERR("Failed to set the radio timers, error: %d", err);
+	}
+#endif
 
-	/* Decativate LTE and enable GNSS. */
-	err = lte_lc_func_mode_set(LTE_LC_FUNC_MODE_DEACTIVATE_LTE);
+	/* Enable GNSS, LTE is only activated to upload. */
+	err = lte_lc_func_mode_set(LTE_LC_FUNC_MODE_ACTIVATE_GNSS);
 	if (err) {
 		LOG_ERR("Failed to decativate LTE and enable GNSS functional mode");
 		return err;
@@ -351,9 +628,69 @@ static int modem_configure(void)
 }
 
 
-static int client_post_send(void)
+/**@brief Encodes the buffered fixes into coap_sendbug and empties the buffer.
+ * Returns the payload length.
+ */
+static int fix_buf_encode(void)
 {
-	int err, ret;
+	uint8_t kept[CONFIG_TRACKER_FIXES_PER_UPLOAD];
+	const struct tracker_fix *fix;
+	size_t len = 0;
+	int count, ret;
+
+	k_mutex_lock(&fix_buf_lock, K_FOREVER);
+
+#if defined(CONFIG_TRACK_SIMPLIFY)
+	struct track_point track[CONFIG_TRACKER_FIXES_PER_UPLOAD];
+
+	for (size_t i = 0; i < fix_count; i++) {
+		track[i].lat_e7 = fix_buf[i].lat_e7;
+		track[i].lon_e7 = fix_buf[i].lon_e7;
+	}
+
+	/* Only the fixes that change the shape of the track are sent */
+	count = track_simplify(track, fix_count, CONFIG_TRACK_SIMPLIFY_TOLERANCE * 1000, kept);
+	LOG_INF("Track simplified from %d to %d fixes", (int)fix_count, count);
+#else
+	for (size_t i = 0; i < fix_count; i++) {
+		kept[i] = i;
+	}
+	count = fix_count;
+#endif
+
+	for (int i = 0; i < count; i++) {
+		char lat[FIXFMT_DEG_LEN], lon[FIXFMT_DEG_LEN], acc[16];
+
+		fix = &fix_buf[kept[i]];
+		fixfmt_deg_e7(lat, sizeof(lat), fix->lat_e7);
+		fixfmt_deg_e7(lon, sizeof(lon), fix->lon_e7);
+		fixfmt_mm(acc, sizeof(acc), fix->accuracy_mm);
+		ret = snprintf((char *)coap_sendbug + len, sizeof(coap_sendbug) - len,
+			       "%s%s,%s\n%s m\n%04u-%02u-%02u %02u:%02u:%02u",
+			       len > 0 ? "\n" : "", lat, lon, acc,
+			       fix->datetime.year, fix->datetime.month, fix->datetime.day,
+			       fix->datetime.hour, fix->datetime.minute, fix->datetime.seconds);
+		if (ret < 0 || (size_t)ret >= sizeof(coap_sendbug) - len) {
+			LOG_ERR("snprintf failed to format string, %d\n", ret);
+			k_mutex_unlock(&fix_buf_lock);
+			return -ENOMEM;
+		}
+		len += ret;
+	}
+
+	fix_count = 0;
+
+	k_mutex_unlock(&fix_buf_lock);
+
+	return len;
+}
+
+/**@brief Sends the buffered fixes, or the measured cells if @p cells is set.
+ * Returns the number of bytes sent.
+ */
+static int client_post_send(bool cells)
+{
+	int err, len;
 	struct coap_packet request;
 
 	next_token++;
@@ -376,6 +713,7 @@ static int client_post_send(void)
 	}
 
    err = coap_append_option_int(&request, COAP_OPTION_CONTENT_FORMAT,
+                                cells ? COAP_CONTENT_FORMAT_APP_OCTET_STREAM :
                                 COAP_CONTENT_FORMAT_TEXT_PLAIN);
    if (err < 0) {
       LOG_ERR("Failed to encode CoAP CONTENT_FORMAT option, %d", err);
@@ -396,19 +734,26 @@ static int client_post_send(void)
 		return err;
 	}
 
-   ret = snprintf (coap_sendbug, sizeof(coap_sendbug), "%.06f,%.06f\n%.01f m\n%04u-%02u-%02u %02u:%02u:%02u",
-   current_pvt.latitude, current_pvt.longitude,(double)current_pvt.accuracy,current_pvt.datetime.year,current_pvt.datetime.month,current_pvt.datetime.day,
-   current_pvt.datetime.hour, current_pvt.datetime.minute, last_pvt.datetime.seconds);
-	if (err < 0) {
-		LOG_ERR("snprintf failed to format string, %d\n", err);
-		return err;
+#if defined(CONFIG_TRACKER_CELL_FALLBACK)
+	if (cells) {
+		len = cell_meas_encode(&cell_record, coap_sendbug, sizeof(coap_sendbug));
+	} else {
+		len = fix_buf_encode();
+	}
+#else
+	len = fix_buf_encode();
+#endif
+	if (len < 0) {
+		LOG_ERR("Failed to encode %s, %d\n", cells ? "cells" : "fixes", len);
+		return len;
 	}
-	err = coap_packet_append_payload(&request, (uint8_t *)coap_sendbug, ret);
+	err = coap_packet_append_payload(&request, (uint8_t *)coap_sendbug, len);
 	if (err < 0) {
 		LOG_ERR("Failed to append payload, %d\n", err);
 		return err;
 	}
 
+	(void)coap_exchange_start(&exchange, (struct sockaddr *)&server, &request);
 	err = zsock_send(sock, request.data, request.offset, 0);
 	if (err < 0) {
 		LOG_ERR("Failed to send CoAP request, %d\n", errno);
@@ -417,7 +762,70 @@ static int client_post_send(void)
 
 	LOG_INF("CoAP request sent: token 0x%04x\n", next_token);
 
-	return 0;
+	return request.offset;
+}
+
+/**@brief Waits for the response to the @p len byte request in coap_buf and
+ * retransmits the request when the adaptive timeout expires, until it is
+ * acknowledged.
+ * Returns the number of bytes received.
+ */
+static int client_response_wait(size_t len)
+{
+	struct zsock_pollfd fds = {
+		.fd = sock,
+		.events = ZSOCK_POLLIN,
+	};
+	int64_t deadline;
+	int timeout, received, err;
+
+	deadline = k_uptime_get() + exchange.rto.timeout_ms;
+
+	while (true) {
+		err = zsock_poll(&fds, 1, (int)MAX(deadline - k_uptime_get(), 0));
+		if (err < 0) {
+			return -errno;
+		} else if (err == 0 && exchange.acked) {
+			LOG_ERR("No separate response to the acknowledged request\n");
+			return -ETIMEDOUT;
+		} else if (err == 0) {
+			timeout = coap_rto_retransmit(&exchange.rto);
+			if (timeout < 0) {
+				LOG_ERR("No response after %u retransmissions\n",
+					exchange.rto.retransmissions);
+				return timeout;
+			}
+
+			LOG_INF("Retransmitting CoAP request, timeout %d ms", timeout);
+			if (zsock_send(sock, coap_buf, len, 0) < 0) {
+				return -errno;
+			}
+			deadline = k_uptime_get() + timeout;
+			continue;
+		}
+
+		received = zsock_recv(sock, coap_rxbuf, sizeof(coap_rxbuf), 0);
+		if (received < 0) {
+			return -errno;
+		} else if (received == 0) {
+			return -ENOTCONN;
+		}
+
+		/* Anything else than the response leaves the timeout running */
+		err = client_handle_get_response(coap_rxbuf, received);
+		if (err == -EINPROGRESS) {
+			/* No more retransmissions, only the wait is limited */
+			deadline = k_uptime_get() +
+				   CONFIG_COAP_EXCHANGE_SEPARATE_TIMEOUT * MSEC_PER_SEC;
+			continue;
+		} else if (err == -EAGAIN) {
+			continue;
+		} else if (err < 0) {
+			return err;
+		}
+
+		return received;
+	}
 }
 static void button_handler(uint32_t button_state, uint32_t has_changed)
 {
@@ -435,10 +843,77 @@ static void button_handler(uint32_t button_state, uint32_t has_changed)
 	}
 }
 
+/**@brief Logs the energy proxies of the last fix and upload cycle. */
+static void cycle_stats_log(void)
+{
+	static struct conn_mgr_stats prev;
+	struct conn_mgr_stats stats;
+
+	conn_mgr_stats_get(&stats);
+	LOG_INF("Cycle (%s): %u attaches, registered %u ms, RRC connected %u ms",
+		IS_ENABLED(CONFIG_TRACKER_RADIO_PSM) ? "PSM" :
+		IS_ENABLED(CONFIG_TRACKER_RADIO_EDRX) ? "eDRX" : "detach",
+		stats.registrations - prev.registrations,
+		(uint32_t)(stats.registered_ms_total - prev.registered_ms_total),
+		(uint32_t)(stats.rrc_connected_ms_total - prev.rrc_connected_ms_total));
+	prev = stats;
+
+#if defined(CONFIG_MEM_PROF)
+	/* Every code path has run once after the first few cycles */
+	mem_prof_report();
+#endif
+}
+
+/**@brief Logs the average CoAP round trip per address family. */
+static void rtt_stats_log(void)
+{
+	struct resolver_family_stats v4, v6;
+
+	(void)resolver_stats_get(AF_INET, &v4);
+	(void)resolver_stats_get(AF_INET6, &v6);
+	LOG_INF("Round trip: IPv4 %u ms (%u), IPv6 %u ms (%u)",
+		v4.rtt_ms_total / MAX(v4.rtt_count, 1), v4.rtt_count,
+		v6.rtt_ms_total / MAX(v6.rtt_count, 1), v6.rtt_count);
+}
+
+/**@brief Logs the retransmission timeout estimate for the server. */
+static void rto_stats_log(void)
+{
+	struct coap_rto_stats stats;
+
+	if (coap_rto_stats_get((struct sockaddr *)&server, &stats) != 0) {
+		return;
+	}
+
+	LOG_INF("RTO %u ms: strong RTT %u ms var %u ms (%u), weak RTT %u ms var %u ms (%u), "
+		"%u retransmissions, %u timeouts", stats.rto_ms, stats.strong_rtt_ms,
+		stats.strong_rttvar_ms, stats.strong_samples, stats.weak_rtt_ms,
+		stats.weak_rttvar_ms, stats.weak_samples, stats.retransmissions, stats.timeouts);
+}
+
+#if defined(CONFIG_ATTACH_HINT)
+/**@brief Logs the average network search time with and without hints. */
+static void search_stats_log(void)
+{
+	struct attach_hint_stats stats;
+
+	attach_hint_stats_get(&stats);
+	LOG_INF("Search time: hinted %u ms (%u), fallback %u ms (%u), full %u ms (%u), same cell %u",
+		stats.hinted_ms_total / MAX(stats.hinted, 1), stats.hinted,
+		stats.fallback_ms_total / MAX(stats.fallbacks, 1), stats.fallbacks,
+		stats.full_ms_total / MAX(stats.full, 1), stats.full, stats.same_cell);
+}
+#endif
+
 int main(void)
 {
 	int err;
 	int received;
+	int sent;
+	int64_t send_time;
+	uint32_t rtt_ms;
+	struct conn_mgr_state link;
+	bool send_cells = false;
 	LOG_INF("The nRF91 Simple Tracker Version %d.%d.%d started\n",CONFIG_TRACKER_VERSION_MAJOR,CONFIG_TRACKER_VERSION_MINOR,CONFIG_TRACKER_VERSION_PATCH);
 
 	err = dk_leds_init();
@@ -454,23 +929,119 @@ int main(void)
 		return 0;
 	}
 
+#if defined(CONFIG_RAT_SELECT)
+	err = rat_select_init();
+	if (err) {
+		LOG_ERR("Failed to initialize RAT selection: %d\n", err);
+		return 0;
+	}
+#endif
+
+#if defined(CONFIG_ATTACH_HINT)
+	err = attach_hint_init();
+	if (err) {
+		LOG_ERR("Failed to initialize attach hints: %d\n", err);
+		return 0;
+	}
+#endif
+
+#if defined(CONFIG_TRACKER_CELL_FALLBACK)
+	err = cell_meas_init();
+	if (err) {
+		LOG_ERR("Failed to initialize cell measurements: %d\n", err);
+		return 0;
+	}
+#endif
+
 	err = dk_buttons_init(button_handler);
 	if (err) {
 		LOG_ERR("Failed to initlize button handler: %d\n", err);
 		return 0;
 	}
 
+#if defined(CONFIG_TRACKER_GEOFENCE)
+	err = geofence_init(tracker_fences, tracker_fence_count, geofence_handler);
+	if (err) {
+		LOG_ERR("Failed to initialize geofences: %d\n", err);
+		return 0;
+	}
+#endif
+
+#if !defined(CONFIG_TRACKER_RADIO_DETACH)
+	err = conn_mgr_subscribe(radio_handler);
+	if (err) {
+		LOG_ERR("Failed to subscribe to connectivity events: %d\n", err);
+		return 0;
+	}
+#endif
+
 	LOG_INF("Starting GNSS....");
-	gnss_init_and_start();
+	err = gnss_init_and_start();
+	if (err) {
+		LOG_ERR("Failed to initialize and start GNSS: %d\n", err);
+		return 0;
+	}
 
 	while (1) {
 		k_sem_take(&gnss_fix_sem, K_FOREVER);
-		err = lte_lc_func_mode_set(LTE_LC_FUNC_MODE_NORMAL);
+		conn_mgr_state_get(&link);
+		/* Attach preparations, only possible while LTE is deactivated: before
+		 * the first connect, and between uploads in DETACH mode
+		 */
+		if (!link.requested) {
+#if defined(CONFIG_RAT_SELECT)
+			/* Prefer the access technology that has been cheapest on this network */
+			(void)rat_select_apply();
+#endif
+#if defined(CONFIG_ATTACH_HINT)
+			/* Search the band and network of the last serving cell first */
+			(void)attach_hint_apply();
+#endif
+		}
+		err = conn_mgr_connect(K_SECONDS(CONFIG_CONN_MGR_CONNECT_TIMEOUT));
 		if (err != 0){
 			LOG_ERR("Failed to activate LTE");
 			break;
 		}
-		k_sem_take(&lte_connected, K_FOREVER);
+		conn_mgr_wait_connected(K_FOREVER);
+#if defined(CONFIG_TRACKER_CELL_FALLBACK)
+		send_cells = atomic_clear(&cell_fallback);
+		if (send_cells) {
+			err = cell_meas_run(&cell_record);
+			if (err) {
+				/* No serving cell, or the same cells as a recent upload */
+				LOG_INF("No cell record to upload: %d\n", err);
+#if defined(CONFIG_TRACKER_RADIO_DETACH)
+				(void)conn_mgr_disconnect();
+#endif
+				cycle_stats_log();
+				continue;
+			}
+		}
+#endif
+#if defined(CONFIG_UPLOAD_SCHED) && defined(CONFIG_TRACKER_RADIO_DETACH)
+		/* LTE is not kept registered while the link is poor, the upload is
+		 * tried again after the next fix
+		 */
+		err = upload_sched_check(atomic_clear(&upload_urgent), upload_payload_len(send_cells));
+		if (err == -EAGAIN) {
+#if defined(CONFIG_TRACKER_CELL_FALLBACK)
+			if (send_cells) {
+				atomic_set(&cell_fallback, true);
+			}
+#endif
+			(void)conn_mgr_disconnect();
+			cycle_stats_log();
+			continue;
+		}
+#elif defined(CONFIG_UPLOAD_SCHED)
+		/* Routine uploads wait for a link that is cheap to send on, LTE
+		 * stays registered in between anyway
+		 */
+		(void)upload_sched_wait(atomic_clear(&upload_urgent), upload_payload_len(send_cells));
+#else
+		atomic_clear(&upload_urgent);
+#endif
 		if (resolve_address_lock == 0){
 			LOG_INF("Resolving the server address\n\r");
 			if (server_resolve() != 0) {
@@ -486,33 +1057,56 @@ int main(void)
 			return 0;
 		}
 
-		if (client_post_send() != 0) {
+		send_time = k_uptime_get();
+		sent = client_post_send(send_cells);
+		if (sent < 0) {
 			LOG_ERR("Failed to send GET request, exit...\n");
 			break;
 		}
 
-		received = zsock_recv(sock, coap_buf, sizeof(coap_buf), 0);
-		if (received < 0) {
-			LOG_ERR("Error reading response\n");
-			break;
-		} else if (received == 0) {
-			LOG_ERR("Disconnected\n");
+		received = client_response_wait(sent);
+		if (received == -ETIMEDOUT || received == -ECONNRESET) {
+			/* This upload is lost, the tracker carries on with the next one */
+			rto_stats_log();
+			(void)zsock_close(sock);
+#if defined(CONFIG_TRACKER_RADIO_DETACH)
+			(void)conn_mgr_disconnect();
+#endif
+			cycle_stats_log();
+			continue;
+		} else if (received < 0) {
+			LOG_ERR("No valid response: %d, exit...\n", received);
 			break;
 		}
 
-		err = client_handle_get_response(coap_buf, received);
-		if (err < 0) {
-			LOG_ERR("Invalid response, exit...\n");
-			break;
+		rtt_ms = k_uptime_get() - send_time;
+		LOG_INF("CoAP round trip: %u ms", rtt_ms);
+		resolver_rtt_add(server.ss_family, rtt_ms);
+		rtt_stats_log();
+		rto_stats_log();
+#if defined(CONFIG_RAT_SELECT)
+		rat_select_exchange_done(sent + received, rtt_ms);
+#endif
+#if defined(CONFIG_ATTACH_HINT)
+		search_stats_log();
+#endif
+#if defined(CONFIG_TRACKER_CELL_FALLBACK)
+		if (send_cells) {
+			/* The server has these cells, they are not sent again for a while */
+			cell_meas_cache_add(&cell_record);
 		}
+#endif
 
 		(void)zsock_close(sock);
 
-		err = lte_lc_func_mode_set(LTE_LC_FUNC_MODE_DEACTIVATE_LTE);
+#if defined(CONFIG_TRACKER_RADIO_DETACH)
+		err = conn_mgr_disconnect();
 		if (err != 0){
 			LOG_ERR("Failed to decativate LTE and enable GNSS functional mode");
 			break;
 		}
+#endif
+		cycle_stats_log();
 	}
 
 	device_status = status_nolte;
@@ -0,0 +1,337 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/settings/settings.h>
+#include <modem/lte_lc.h>
+#include <nrf_modem_at.h>
+
+#include <cellfund/attach_hint.h>
+#include <cellfund/conn_mgr.h>
+
+LOG_MODULE_REGISTER(attach_hint, CONFIG_ATTACH_HINT_LOG_LEVEL);
+
+#define SETTINGS_TREE "att_hint"
+#define SETTINGS_CELL_KEY "cell"
+
+/* Highest band that fits in the AT%XBANDLOCK bit string. */
+#define BAND_MAX 88
+
+enum search_type {
+	SEARCH_NONE,
+	SEARCH_HINTED,
+	SEARCH_FALLBACK,
+	SEARCH_FULL,
+};
+
+static K_MUTEX_DEFINE(lock);
+static struct attach_hint_cell stored;
+static struct attach_hint_stats stats;
+static enum search_type search;
+/* The next capture is the first one after an attach. */
+static bool capture_after_attach;
+
+static void fallback_work_fn(struct k_work *work);
+static void capture_work_fn(struct k_work *work);
+static void clear_work_fn(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(fallback_work, fallback_work_fn);
+static K_WORK_DEFINE(capture_work, capture_work_fn);
+static K_WORK_DEFINE(clear_work, clear_work_fn);
+
+#if defined(CONFIG_ATTACH_HINT_SETTINGS)
+static int settings_set(const char *key, size_t len, settings_read_cb read_cb, void *cb_arg)
+{
+	ssize_t ret;
+
+	if (strcmp(key, SETTINGS_CELL_KEY) != 0 || len != sizeof(stored)) {
+		return -EINVAL;
+	}
+
+	ret = read_cb(cb_arg, &stored, sizeof(stored));
+	if (ret < 0) {
+		return ret;
+	}
+
+	stored.plmn[sizeof(stored.plmn) - 1] = '\0';
+
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(attach_hint, SETTINGS_TREE, NULL, settings_set, NULL, NULL);
+
+static void cell_save(const struct attach_hint_cell *cell)
+{
+	int err = settings_save_one(SETTINGS_TREE "/" SETTINGS_CELL_KEY, cell, sizeof(*cell));
+
+	if (err) {
+		LOG_WRN("Failed to save the serving cell, error: %d", err);
+	}
+}
+#else
+static void cell_save(const struct attach_hint_cell *cell)
+{
+}
+#endif /* CONFIG_ATTACH_HINT_SETTINGS */
+
+/* The hints are kept by the modem until cleared, so a full search must
+ * explicitly remove them.
+ */
+static void hints_clear(void)
+{
+	int err;
+
+	if (IS_ENABLED(CONFIG_ATTACH_HINT_BAND_LOCK)) {
+		err = nrf_modem_at_printf("AT%%XBANDLOCK=0");
+		if (err) {
+			LOG_WRN("Failed to remove the band lock, error: %d", err);
+		}
+	}
+
+	if (IS_ENABLED(CONFIG_ATTACH_HINT_PLMN)) {
+		err = nrf_modem_at_printf("AT+COPS=0");
+		if (err) {
+			LOG_WRN("Failed to select automatic network selection, error: %d", err);
+		}
+	}
+}
+
+static void hints_set(const struct attach_hint_cell *cell)
+{
+	char mask[BAND_MAX + 1];
+	int err;
+
+	if (IS_ENABLED(CONFIG_ATTACH_HINT_BAND_LOCK) && cell->band > 0 && cell->band <= BAND_MAX) {
+		/* The rightmost bit is band 1. */
+		memset(mask, '0', cell->band);
+		mask[0] = '1';
+		mask[cell->band] = '\0';
+
+		err = nrf_modem_at_printf("AT%%XBANDLOCK=2,\"%s\"", mask);
+		if (err) {
+			LOG_WRN("Failed to lock band %u, error: %d", cell->band, err);
+		}
+	}
+
+	if (IS_ENABLED(CONFIG_ATTACH_HINT_PLMN)) {
+		/* Manual selection, the modem does not support the manual/automatic
+		 * mode. fallback_work switches back to automatic selection.
+		 */
+		err = nrf_modem_at_printf("AT+COPS=1,2,\"%s\"", cell->plmn);
+		if (err) {
+			LOG_WRN("Failed to select network %s, error: %d", cell->plmn, err);
+		}
+	}
+}
+
+static void clear_work_fn(struct k_work *work)
+{
+	hints_clear();
+}
+
+static void fallback_work_fn(struct k_work *work)
+{
+	struct conn_mgr_state link;
+	int err;
+
+	conn_mgr_state_get(&link);
+
+	k_mutex_lock(&lock, K_FOREVER);
+	if (search != SEARCH_HINTED || link.registered || !link.requested) {
+		k_mutex_unlock(&lock);
+		return;
+	}
+
+	search = SEARCH_FALLBACK;
+	k_mutex_unlock(&lock);
+
+	LOG_INF("Not registered on the stored cell's band, doing a full search");
+
+	err = lte_lc_func_mode_set(LTE_LC_FUNC_MODE_DEACTIVATE_LTE);
+	if (err) {
+		LOG_ERR("Failed to deactivate LTE, error: %d", err);
+		return;
+	}
+
+	hints_clear();
+
+	err = lte_lc_connect_async(NULL);
+	if (err) {
+		LOG_ERR("Failed to reactivate LTE, error: %d", err);
+	}
+}
+
+static bool cell_equal(const struct attach_hint_cell *a, const struct attach_hint_cell *b)
+{
+	return strcmp(a->plmn, b->plmn) == 0 && a->cell_id == b->cell_id &&
+	       a->earfcn == b->earfcn && a->tac == b->tac && a->band == b->band;
+}
+
+static void capture_work_fn(struct k_work *work)
+{
+	struct attach_hint_cell cell;
+	unsigned int tac, cell_id, band, earfcn;
+	bool changed;
+	int ret;
+
+	ret = nrf_modem_at_scanf("AT%XMONITOR",
+				 "%%XMONITOR: %*d,%*[^,],%*[^,],\"%6[0-9]\",\"%4x\",%*d,%u,\"%8x\",%*d,%u",
+				 cell.plmn, &tac, &band, &cell_id, &earfcn);
+	if (ret != 5) {
+		LOG_DBG("Serving cell not available, error: %d", ret);
+		return;
+	}
+
+	cell.tac = tac;
+	cell.band = band;
+	cell.cell_id = cell_id;
+	cell.earfcn = earfcn;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	changed = !cell_equal(&cell, &stored);
+	if (capture_after_attach && !changed) {
+		stats.same_cell++;
+	}
+	capture_after_attach = false;
+	stored = cell;
+	k_mutex_unlock(&lock);
+
+	if (changed) {
+		LOG_INF("Serving cell: PLMN %s, cell 0x%08x, TAC 0x%04x, band %u, EARFCN %u",
+			cell.plmn, cell.cell_id, cell.tac, cell.band, cell.earfcn);
+		cell_save(&cell);
+	}
+}
+
+static void connected(uint32_t connect_ms)
+{
+	bool hinted;
+
+	k_work_cancel_delayable(&fallback_work);
+
+	k_mutex_lock(&lock, K_FOREVER);
+	hinted = search == SEARCH_HINTED;
+	switch (search) {
+	case SEARCH_HINTED:
+		stats.hinted++;
+		stats.hinted_ms_total += connect_ms;
+		break;
+	case SEARCH_FALLBACK:
+		stats.fallbacks++;
+		stats.fallback_ms_total += connect_ms;
+		break;
+	case SEARCH_FULL:
+		stats.full++;
+		stats.full_ms_total += connect_ms;
+		break;
+	default:
+		break;
+	}
+
+	search = SEARCH_NONE;
+	capture_after_attach = true;
+	k_mutex_unlock(&lock);
+
+	/* The hints have done their job, a locked band or network would keep
+	 * the modem from reselecting a better cell while registered.
+	 */
+	if (hinted) {
+		k_work_submit(&clear_work);
+	}
+
+	k_work_submit(&capture_work);
+}
+
+static void conn_handler(const struct conn_mgr_evt *evt)
+{
+	switch (evt->type) {
+	case CONN_MGR_EVT_CONNECTED:
+		connected(evt->connect_ms);
+		break;
+	case CONN_MGR_EVT_CELL_UPDATE:
+		/* Also track reselections while registered. */
+		k_work_submit(&capture_work);
+		break;
+	case CONN_MGR_EVT_CONNECT_TIMEOUT: {
+		bool hinted;
+
+		/* LTE is deactivated until the retry, which searches everywhere. */
+		k_work_cancel_delayable(&fallback_work);
+
+		k_mutex_lock(&lock, K_FOREVER);
+		hinted = search == SEARCH_HINTED;
+		if (hinted) {
+			search = SEARCH_FALLBACK;
+		}
+		k_mutex_unlock(&lock);
+
+		if (hinted) {
+			hints_clear();
+		}
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+int attach_hint_init(void)
+{
+	int err;
+
+	if (IS_ENABLED(CONFIG_ATTACH_HINT_SETTINGS)) {
+		err = settings_subsys_init();
+		if (err) {
+			LOG_ERR("Failed to initialize settings, error: %d", err);
+			return err;
+		}
+
+		err = settings_load_subtree(SETTINGS_TREE);
+		if (err) {
+			LOG_WRN("Failed to load the serving cell, error: %d", err);
+		}
+	}
+
+	return conn_mgr_subscribe(conn_handler);
+}
+
+int attach_hint_apply(void)
+{
+	struct attach_hint_cell cell;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	cell = stored;
+	search = cell.plmn[0] != '\0' ? SEARCH_HINTED : SEARCH_FULL;
+	k_mutex_unlock(&lock);
+
+	if (cell.plmn[0] == '\0') {
+		hints_clear();
+		return -ENOENT;
+	}
+
+	LOG_DBG("Searching band %u on %s first", cell.band, cell.plmn);
+	hints_set(&cell);
+	k_work_reschedule(&fallback_work, K_SECONDS(CONFIG_ATTACH_HINT_TIMEOUT));
+
+	return 0;
+}
+
+void attach_hint_cell_get(struct attach_hint_cell *cell)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+	*cell = stored;
+	k_mutex_unlock(&lock);
+}
+
+void attach_hint_stats_get(struct attach_hint_stats *out)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+	*out = stats;
+	k_mutex_unlock(&lock);
+}
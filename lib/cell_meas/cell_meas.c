@@ -0,0 +1,309 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/byteorder.h>
+#include <modem/lte_lc.h>
+
+#include <cellfund/cell_meas.h>
+#include <cellfund/conn_mgr.h>
+
+LOG_MODULE_REGISTER(cell_meas, CONFIG_CELL_MEAS_LOG_LEVEL);
+
+/* RSRP index reported by the modem when a cell was not measured. */
+#define RSRP_IDX_UNKNOWN 255
+/* RSRP index 0 is -140 dBm, see 3GPP TS 36.133. */
+#define RSRP_IDX_OFFSET 140
+
+/* FNV-1a, 32 bit */
+#define FNV_OFFSET_BASIS 2166136261u
+#define FNV_PRIME 16777619u
+
+struct cache_entry {
+	uint32_t key;
+	/* Uptime of the upload in ms, 0 if the entry is unused. */
+	int64_t time;
+};
+
+static K_MUTEX_DEFINE(lock);
+static K_SEM_DEFINE(result_sem, 0, 1);
+
+/* Filled by the event handler while a measurement is running. */
+static struct cell_meas_record *pending;
+static bool pending_found;
+static struct cache_entry cache[CONFIG_CELL_MEAS_CACHE_SIZE];
+static struct cell_meas_stats stats;
+
+static int8_t rsrp_to_dbm(int16_t idx)
+{
+	if (idx == RSRP_IDX_UNKNOWN) {
+		return CELL_MEAS_RSRP_UNKNOWN;
+	}
+
+	return CLAMP(idx - RSRP_IDX_OFFSET, INT8_MIN + 1, INT8_MAX);
+}
+
+/* Keeps the strongest neighbor cells, sorted by RSRP. Neighbors that repeat
+ * the serving cell or an earlier neighbor are dropped.
+ */
+static void ncell_insert(struct cell_meas_record *record, const struct lte_lc_ncell *ncell)
+{
+	struct cell_meas_ncell cell = {
+		.earfcn = ncell->earfcn,
+		.pci = ncell->phys_cell_id,
+		.rsrp = rsrp_to_dbm(ncell->rsrp),
+	};
+	size_t i;
+
+	if (cell.earfcn == record->earfcn && cell.pci == record->pci) {
+		return;
+	}
+
+	for (i = 0; i < record->ncell_count; i++) {
+		if (record->ncells[i].earfcn == cell.earfcn && record->ncells[i].pci == cell.pci) {
+			return;
+		}
+	}
+
+	for (i = record->ncell_count; i > 0 && record->ncells[i - 1].rsrp < cell.rsrp; i--) {
+		if (i < ARRAY_SIZE(record->ncells)) {
+			record->ncells[i] = record->ncells[i - 1];
+		}
+	}
+
+	if (i < ARRAY_SIZE(record->ncells)) {
+		record->ncells[i] = cell;
+		record->ncell_count = MIN(record->ncell_count + 1, ARRAY_SIZE(record->ncells));
+	}
+}
+
+static void record_fill(struct cell_meas_record *record, const struct lte_lc_cells_info *info)
+{
+	const struct lte_lc_cell *cell = &info->current_cell;
+
+	memset(record, 0, sizeof(*record));
+	record->mcc = cell->mcc;
+	record->mnc = cell->mnc;
+	record->cell_id = cell->id;
+	record->tac = cell->tac;
+	record->earfcn = cell->earfcn;
+	record->pci = cell->phys_cell_id;
+	record->rsrp = rsrp_to_dbm(cell->rsrp);
+
+	for (size_t i = 0; i < info->ncells_count; i++) {
+		ncell_insert(record, &info->neighbor_cells[i]);
+	}
+}
+
+static uint32_t fnv_add(uint32_t hash, uint32_t value)
+{
+	for (size_t i = 0; i < sizeof(value); i++) {
+		hash = (hash ^ ((value >> (8 * i)) & 0xff)) * FNV_PRIME;
+	}
+
+	return hash;
+}
+
+/* Identifies the serving cell and the strongest neighbors, in any order. */
+static uint32_t record_key(const struct cell_meas_record *record)
+{
+	size_t count = MIN(record->ncell_count, CONFIG_CELL_MEAS_DEDUP_NCELLS);
+	uint32_t ids[MAX(CONFIG_CELL_MEAS_DEDUP_NCELLS, 1)];
+	uint32_t hash = FNV_OFFSET_BASIS;
+
+	hash = fnv_add(hash, record->mcc << 16 | record->mnc);
+	hash = fnv_add(hash, record->cell_id);
+
+	for (size_t i = 0; i < count; i++) {
+		uint32_t id = record->ncells[i].earfcn << 9 | record->ncells[i].pci;
+		size_t j;
+
+		for (j = i; j > 0 && ids[j - 1] > id; j--) {
+			ids[j] = ids[j - 1];
+		}
+		ids[j] = id;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		hash = fnv_add(hash, ids[i]);
+	}
+
+	return hash;
+}
+
+/* Called with the lock held. */
+static bool cache_contains_locked(uint32_t key)
+{
+	int64_t now = k_uptime_get();
+
+	for (size_t i = 0; i < ARRAY_SIZE(cache); i++) {
+		if (cache[i].time != 0 && cache[i].key == key &&
+		    now - cache[i].time < CONFIG_CELL_MEAS_CACHE_TTL * MSEC_PER_SEC) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void conn_handler(const struct conn_mgr_evt *evt)
+{
+	if (evt->type != CONN_MGR_EVT_NEIGHBOR_CELL_MEAS) {
+		return;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+	if (pending == NULL) {
+		k_mutex_unlock(&lock);
+		return;
+	}
+
+	pending_found = evt->cells_info.current_cell.id != LTE_LC_CELL_EUTRAN_ID_INVALID;
+	if (pending_found) {
+		record_fill(pending, &evt->cells_info);
+	}
+	pending = NULL;
+	k_mutex_unlock(&lock);
+
+	k_sem_give(&result_sem);
+}
+
+int cell_meas_init(void)
+{
+	return conn_mgr_subscribe(conn_handler);
+}
+
+int cell_meas_run(struct cell_meas_record *record)
+{
+	struct lte_lc_ncellmeas_params params = {
+		.search_type = LTE_LC_NEIGHBOR_SEARCH_TYPE_DEFAULT,
+	};
+	int64_t start = k_uptime_get();
+	bool found;
+	int err;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	if (pending != NULL) {
+		k_mutex_unlock(&lock);
+		return -EBUSY;
+	}
+	pending = record;
+	k_sem_reset(&result_sem);
+	k_mutex_unlock(&lock);
+
+	err = lte_lc_neighbor_cell_measurement(&params);
+	if (err) {
+		LOG_ERR("Failed to start the measurement, error: %d", err);
+		k_mutex_lock(&lock, K_FOREVER);
+		pending = NULL;
+		stats.failures++;
+		k_mutex_unlock(&lock);
+		return err;
+	}
+
+	err = k_sem_take(&result_sem, K_SECONDS(CONFIG_CELL_MEAS_TIMEOUT));
+
+	k_mutex_lock(&lock, K_FOREVER);
+	if (err) {
+		/* The result may still arrive, it must not be written to the record. */
+		pending = NULL;
+		stats.failures++;
+		k_mutex_unlock(&lock);
+
+		LOG_WRN("No measurement result within %d s", CONFIG_CELL_MEAS_TIMEOUT);
+		(void)lte_lc_neighbor_cell_measurement_cancel();
+		return -ETIMEDOUT;
+	}
+
+	found = pending_found;
+	if (!found) {
+		stats.failures++;
+		k_mutex_unlock(&lock);
+		return -ENOENT;
+	}
+
+	stats.measurements++;
+	stats.meas_ms_total += k_uptime_get() - start;
+	if (cache_contains_locked(record_key(record))) {
+		stats.duplicates++;
+		err = -EALREADY;
+	}
+	k_mutex_unlock(&lock);
+
+	LOG_INF("Serving cell 0x%08x (%d dBm), %u neighbor cells%s", record->cell_id,
+		record->rsrp, record->ncell_count, err ? ", uploaded recently" : "");
+
+	return err;
+}
+
+void cell_meas_cache_add(const struct cell_meas_record *record)
+{
+	uint32_t key = record_key(record);
+	size_t slot = 0;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	for (size_t i = 0; i < ARRAY_SIZE(cache); i++) {
+		if (cache[i].time != 0 && cache[i].key == key) {
+			slot = i;
+			break;
+		}
+
+		/* Unused entries have the oldest time. */
+		if (cache[i].time < cache[slot].time) {
+			slot = i;
+		}
+	}
+
+	cache[slot].key = key;
+	cache[slot].time = k_uptime_get();
+	stats.uploads++;
+	k_mutex_unlock(&lock);
+}
+
+int cell_meas_encode(const struct cell_meas_record *record, uint8_t *buf, size_t len)
+{
+	size_t off = 0;
+
+	if (len < CELL_MEAS_RECORD_LEN(record->ncell_count)) {
+		return -ENOMEM;
+	}
+
+	buf[off++] = CELL_MEAS_RECORD_VERSION;
+	buf[off++] = record->ncell_count;
+	sys_put_be16(record->mcc, &buf[off]);
+	off += 2;
+	sys_put_be16(record->mnc, &buf[off]);
+	off += 2;
+	sys_put_be32(record->cell_id, &buf[off]);
+	off += 4;
+	sys_put_be16(record->tac, &buf[off]);
+	off += 2;
+	sys_put_be24(record->earfcn, &buf[off]);
+	off += 3;
+	sys_put_be16(record->pci, &buf[off]);
+	off += 2;
+	buf[off++] = (uint8_t)record->rsrp;
+
+	for (size_t i = 0; i < record->ncell_count; i++) {
+		sys_put_be24(record->ncells[i].earfcn, &buf[off]);
+		off += 3;
+		sys_put_be16(record->ncells[i].pci, &buf[off]);
+		off += 2;
+		buf[off++] = (uint8_t)record->ncells[i].rsrp;
+	}
+
+	return off;
+}
+
+void cell_meas_stats_get(struct cell_meas_stats *out)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+	*out = stats;
+	k_mutex_unlock(&lock);
+}
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/coap.h>
+
+#include <cellfund/coap_dedup.h>
+
+LOG_MODULE_REGISTER(coap_dedup, CONFIG_COAP_DEDUP_LOG_LEVEL);
+
+/* An empty ACK is the 4-byte header only */
+#define ACK_LEN 4
+
+struct entry {
+	struct sockaddr_storage addr;
+	/* In ms of uptime, 0 for a free entry */
+	int64_t expiry;
+	uint16_t mid;
+	uint8_t ack_len;
+	uint8_t ack[ACK_LEN];
+};
+
+static K_MUTEX_DEFINE(lock);
+static struct entry entries[CONFIG_COAP_DEDUP_ENTRIES];
+static struct coap_dedup_stats stats;
+
+static bool addr_equal(const struct sockaddr *a, const struct sockaddr *b)
+{
+	if (a->sa_family != b->sa_family) {
+		return false;
+	}
+
+	if (a->sa_family == AF_INET) {
+		const struct sockaddr_in *a4 = (const struct sockaddr_in *)a;
+		const struct sockaddr_in *b4 = (const struct sockaddr_in *)b;
+
+		return a4->sin_port == b4->sin_port &&
+		       memcmp(&a4->sin_addr, &b4->sin_addr, sizeof(a4->sin_addr)) == 0;
+	} else if (a->sa_family == AF_INET6) {
+		const struct sockaddr_in6 *a6 = (const struct sockaddr_in6 *)a;
+		const struct sockaddr_in6 *b6 = (const struct sockaddr_in6 *)b;
+
+		return a6->sin6_port == b6->sin6_port &&
+		       memcmp(&a6->sin6_addr, &b6->sin6_addr, sizeof(a6->sin6_addr)) == 0;
+	}
+
+	return false;
+}
+
+static size_t addr_len(const struct sockaddr *addr)
+{
+	return addr->sa_family == AF_INET6 ? sizeof(struct sockaddr_in6) :
+					     sizeof(struct sockaddr_in);
+}
+
+/* Called with the lock held. */
+static struct entry *entry_find_locked(const struct sockaddr *src, uint16_t mid, int64_t now)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(entries); i++) {
+		if (entries[i].expiry > now && entries[i].mid == mid &&
+		    addr_equal((struct sockaddr *)&entries[i].addr, src)) {
+			return &entries[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Called with the lock held. A free or expired entry, otherwise the one that
+ * expires first.
+ */
+static struct entry *entry_alloc_locked(int64_t now)
+{
+	struct entry *oldest = &entries[0];
+
+	for (size_t i = 0; i < ARRAY_SIZE(entries); i++) {
+		if (entries[i].expiry <= now) {
+			return &entries[i];
+		}
+
+		if (entries[i].expiry < oldest->expiry) {
+			oldest = &entries[i];
+		}
+	}
+
+	LOG_DBG("Cache full, message 0x%04x forgotten early", oldest->mid);
+	stats.evicted++;
+
+	return oldest;
+}
+
+/* Called with the lock held. */
+static int ack_build_locked(struct entry *entry)
+{
+	struct coap_packet ack;
+	int err;
+
+	err = coap_packet_init(&ack, entry->ack, sizeof(entry->ack), COAP_VERSION_1,
+			       COAP_TYPE_ACK, 0, NULL, COAP_CODE_EMPTY, entry->mid);
+	if (err) {
+		return err;
+	}
+
+	entry->ack_len = ack.offset;
+
+	return 0;
+}
+
+int coap_dedup_rx(int sock, const struct sockaddr *src, const struct coap_packet *msg)
+{
+	uint8_t type = coap_header_get_type(msg);
+	uint16_t mid = coap_header_get_id(msg);
+	int64_t now = k_uptime_get();
+	struct entry *entry;
+	uint8_t ack[ACK_LEN];
+	size_t ack_len = 0;
+	int err = 0;
+
+	if (type != COAP_TYPE_CON && type != COAP_TYPE_NON_CON) {
+		return 0;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+	stats.checked++;
+
+	entry = entry_find_locked(src, mid, now);
+	if (entry != NULL) {
+		LOG_DBG("Duplicate message 0x%04x", mid);
+		stats.duplicates++;
+		err = -EALREADY;
+	} else {
+		entry = entry_alloc_locked(now);
+		memcpy(&entry->addr, src, addr_len(src));
+		entry->mid = mid;
+		entry->ack_len = 0;
+		entry->expiry = now + MSEC_PER_SEC * (type == COAP_TYPE_CON ?
+						      CONFIG_COAP_DEDUP_EXCHANGE_LIFETIME :
+						      CONFIG_COAP_DEDUP_NON_LIFETIME);
+
+		if (type == COAP_TYPE_CON && ack_build_locked(entry) != 0) {
+			LOG_WRN("Failed to build ACK for message 0x%04x", mid);
+		}
+	}
+
+	/* Sent outside the lock, a copy is enough as the ACK never changes */
+	ack_len = entry->ack_len;
+	memcpy(ack, entry->ack, ack_len);
+	k_mutex_unlock(&lock);
+
+	if (ack_len == 0) {
+		return err;
+	}
+
+	if (zsock_send(sock, ack, ack_len, 0) < 0) {
+		LOG_WRN("Failed to send ACK for message 0x%04x, error: %d", mid, errno);
+		return err;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+	if (err) {
+		stats.acks_replayed++;
+	} else {
+		stats.acks_sent++;
+	}
+	k_mutex_unlock(&lock);
+
+	return err;
+}
+
+void coap_dedup_stats_get(struct coap_dedup_stats *out)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+	*out = stats;
+	k_mutex_unlock(&lock);
+}
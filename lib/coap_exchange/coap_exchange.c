@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/coap.h>
+
+#include <cellfund/coap_exchange.h>
+
+LOG_MODULE_REGISTER(coap_exchange, CONFIG_COAP_EXCHANGE_LOG_LEVEL);
+
+/* An empty ACK is the 4-byte header only */
+#define ACK_LEN 4
+
+uint32_t coap_exchange_start(struct coap_exchange *ex, const struct sockaddr *dst,
+			     const struct coap_packet *request)
+{
+	ex->id = coap_header_get_id(request);
+	ex->token_len = coap_header_get_token(request, ex->token);
+	ex->acked = false;
+
+	return coap_rto_start(&ex->rto, dst);
+}
+
+static void ack_send(int sock, const struct coap_packet *msg)
+{
+	uint8_t buf[ACK_LEN];
+	struct coap_packet ack;
+	uint16_t mid = coap_header_get_id(msg);
+
+	if (coap_packet_init(&ack, buf, sizeof(buf), COAP_VERSION_1, COAP_TYPE_ACK, 0, NULL,
+			     COAP_CODE_EMPTY, mid) != 0) {
+		return;
+	}
+
+	if (zsock_send(sock, ack.data, ack.offset, 0) < 0) {
+		LOG_WRN("Failed to send ACK for message 0x%04x, error: %d", mid, errno);
+	}
+}
+
+enum coap_exchange_match coap_exchange_rx(struct coap_exchange *ex, int sock,
+					  const struct coap_packet *msg)
+{
+	uint8_t type = coap_header_get_type(msg);
+	uint8_t token[COAP_TOKEN_MAX_LEN];
+	uint8_t token_len;
+
+	/* ACKs and resets carry the message ID of the request, the token
+	 * only when the response is piggybacked
+	 */
+	if (type == COAP_TYPE_ACK || type == COAP_TYPE_RESET) {
+		if (coap_header_get_id(msg) != ex->id) {
+			return COAP_EXCHANGE_OTHER;
+		}
+
+		if (type == COAP_TYPE_RESET) {
+			LOG_DBG("Request 0x%04x reset", ex->id);
+			return COAP_EXCHANGE_RESET;
+		}
+
+		if (!ex->acked) {
+			ex->acked = true;
+			coap_rto_done(&ex->rto);
+		}
+
+		if (coap_header_get_code(msg) == COAP_CODE_EMPTY) {
+			LOG_DBG("Request 0x%04x acknowledged, response follows", ex->id);
+			return COAP_EXCHANGE_ACKED;
+		}
+	}
+
+	token_len = coap_header_get_token(msg, token);
+	if (token_len != ex->token_len || memcmp(token, ex->token, token_len) != 0) {
+		return COAP_EXCHANGE_OTHER;
+	}
+
+	if (type == COAP_TYPE_CON && !IS_ENABLED(CONFIG_COAP_DEDUP)) {
+		ack_send(sock, msg);
+	}
+
+	return COAP_EXCHANGE_RESPONSE;
+}
@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/random/random.h>
+
+#include <cellfund/coap_rto.h>
+
+LOG_MODULE_REGISTER(coap_rto, CONFIG_COAP_RTO_LOG_LEVEL);
+
+/* RTTVAR multipliers of the strong and weak estimators */
+#define STRONG_K 4
+#define WEAK_K 1
+/* Weak samples are only taken up to this many retransmissions */
+#define WEAK_RETRANSMIT_MAX 2
+
+struct estimator {
+	uint32_t rtt_ms;
+	uint32_t rttvar_ms;
+	uint32_t samples;
+};
+
+struct dest {
+	struct sockaddr_storage addr;
+	/* In ms of uptime, free entries have no address family */
+	int64_t used_at;
+	/* Last change of the RTO by a sample or by aging */
+	int64_t updated_at;
+	uint32_t rto_ms;
+	struct estimator strong;
+	struct estimator weak;
+	uint32_t retransmissions;
+	uint32_t timeouts;
+};
+
+static K_MUTEX_DEFINE(lock);
+static struct dest dests[CONFIG_COAP_RTO_DESTINATIONS];
+
+static bool addr_equal(const struct sockaddr *a, const struct sockaddr *b)
+{
+	if (a->sa_family != b->sa_family) {
+		return false;
+	}
+
+	if (a->sa_family == AF_INET) {
+		const struct sockaddr_in *a4 = (const struct sockaddr_in *)a;
+		const struct sockaddr_in *b4 = (const struct sockaddr_in *)b;
+
+		return a4->sin_port == b4->sin_port &&
+		       memcmp(&a4->sin_addr, &b4->sin_addr, sizeof(a4->sin_addr)) == 0;
+	} else if (a->sa_family == AF_INET6) {
+		const struct sockaddr_in6 *a6 = (const struct sockaddr_in6 *)a;
+		const struct sockaddr_in6 *b6 = (const struct sockaddr_in6 *)b;
+
+		return a6->sin6_port == b6->sin6_port &&
+		       memcmp(&a6->sin6_addr, &b6->sin6_addr, sizeof(a6->sin6_addr)) == 0;
+	}
+
+	return false;
+}
+
+/* Called with the lock held. */
+static struct dest *dest_find_locked(const struct sockaddr *dst)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(dests); i++) {
+		if (addr_equal((struct sockaddr *)&dests[i].addr, dst)) {
+			return &dests[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Called with the lock held. A free entry, otherwise the least recently used. */
+static struct dest *dest_alloc_locked(const struct sockaddr *dst, int64_t now)
+{
+	struct dest *d = &dests[0];
+
+	for (size_t i = 0; i < ARRAY_SIZE(dests); i++) {
+		if (dests[i].addr.ss_family == AF_UNSPEC) {
+			d = &dests[i];
+			break;
+		}
+
+		if (dests[i].used_at < d->used_at) {
+			d = &dests[i];
+		}
+	}
+
+	memset(d, 0, sizeof(*d));
+	memcpy(&d->addr, dst, dst->sa_family == AF_INET6 ? sizeof(struct sockaddr_in6) :
+							   sizeof(struct sockaddr_in));
+	d->rto_ms = CONFIG_COAP_RTO_INITIAL_MS;
+	d->updated_at = now;
+
+	return d;
+}
+
+/* Called with the lock held. An RTO that has not been updated for a while
+ * moves back towards the initial value, small ones faster than large ones.
+ */
+static void rto_age_locked(struct dest *d, int64_t now)
+{
+	int64_t idle = now - d->updated_at;
+
+	if (d->rto_ms < 1000 && idle > 16 * (int64_t)d->rto_ms) {
+		d->rto_ms *= 2;
+	} else if (d->rto_ms > 3000 && idle > 4 * (int64_t)d->rto_ms) {
+		d->rto_ms = (CONFIG_COAP_RTO_INITIAL_MS + d->rto_ms) / 2;
+	} else {
+		return;
+	}
+
+	LOG_DBG("RTO aged to %u ms", d->rto_ms);
+	d->updated_at = now;
+}
+
+/* Returns the RTO estimate of @p k times the variance for the sample. */
+static uint32_t estimator_update(struct estimator *e, uint32_t rtt_ms, uint32_t k)
+{
+	uint32_t diff = e->rtt_ms > rtt_ms ? e->rtt_ms - rtt_ms : rtt_ms - e->rtt_ms;
+
+	if (e->samples++ == 0) {
+		e->rtt_ms = rtt_ms;
+		e->rttvar_ms = rtt_ms / 2;
+	} else {
+		/* RFC 6298 smoothing, beta 1/4 and alpha 1/8 */
+		e->rttvar_ms = (3 * e->rttvar_ms + diff) / 4;
+		e->rtt_ms = (7 * e->rtt_ms + rtt_ms) / 8;
+	}
+
+	return e->rtt_ms + k * e->rttvar_ms;
+}
+
+uint32_t coap_rto_start(struct coap_rto_exchange *ex, const struct sockaddr *dst)
+{
+	int64_t now = k_uptime_get();
+	struct dest *d;
+	uint32_t rto_ms;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	d = dest_find_locked(dst);
+	if (d == NULL) {
+		d = dest_alloc_locked(dst, now);
+	}
+
+	d->used_at = now;
+	rto_age_locked(d, now);
+	rto_ms = d->rto_ms;
+	k_mutex_unlock(&lock);
+
+	/* Short timeouts back off faster and long ones slower, so a wrong
+	 * estimate is corrected within the usual number of retransmissions.
+	 */
+	if (rto_ms < 1000) {
+		ex->backoff_x2 = 6;
+	} else if (rto_ms > 3000) {
+		ex->backoff_x2 = 3;
+	} else {
+		ex->backoff_x2 = 4;
+	}
+
+	ex->dst = dst;
+	ex->start = now;
+	ex->retransmissions = 0;
+	/* Dithered by ACK_RANDOM_FACTOR so senders do not synchronize */
+	ex->timeout_ms = rto_ms + sys_rand32_get() % (rto_ms / 2 + 1);
+
+	return ex->timeout_ms;
+}
+
+int coap_rto_retransmit(struct coap_rto_exchange *ex)
+{
+	struct dest *d;
+	bool failed = ex->retransmissions >= CONFIG_COAP_RTO_MAX_RETRANSMIT;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	d = dest_find_locked(ex->dst);
+	if (d != NULL) {
+		if (failed) {
+			d->timeouts++;
+		} else {
+			d->retransmissions++;
+		}
+	}
+	k_mutex_unlock(&lock);
+
+	if (failed) {
+		return -ETIMEDOUT;
+	}
+
+	ex->retransmissions++;
+	ex->timeout_ms = (uint32_t)MIN((uint64_t)ex->timeout_ms * ex->backoff_x2 / 2, INT32_MAX);
+
+	return ex->timeout_ms;
+}
+
+void coap_rto_done(struct coap_rto_exchange *ex)
+{
+	int64_t now = k_uptime_get();
+	uint32_t rtt_ms = now - ex->start;
+	uint32_t rto_ms;
+	struct dest *d;
+
+	/* Which transmission the ACK belongs to can no longer be guessed */
+	if (ex->retransmissions > WEAK_RETRANSMIT_MAX) {
+		return;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+	d = dest_find_locked(ex->dst);
+	if (d == NULL) {
+		goto out;
+	}
+
+	if (ex->retransmissions == 0) {
+		rto_ms = estimator_update(&d->strong, rtt_ms, STRONG_K);
+		d->rto_ms = (rto_ms + d->rto_ms) / 2;
+	} else {
+		/* Measured from the first transmission, so it also covers a lost one */
+		rto_ms = estimator_update(&d->weak, rtt_ms, WEAK_K);
+		d->rto_ms = (rto_ms + 3 * d->rto_ms) / 4;
+	}
+
+	d->rto_ms = CLAMP(d->rto_ms, 1, CONFIG_COAP_RTO_MAX_MS);
+	d->updated_at = now;
+
+	LOG_DBG("%s sample %u ms, RTO %u ms", ex->retransmissions ? "Weak" : "Strong", rtt_ms,
+		d->rto_ms);
+
+out:
+	k_mutex_unlock(&lock);
+}
+
+int coap_rto_stats_get(const struct sockaddr *dst, struct coap_rto_stats *out)
+{
+	struct dest *d;
+	int err = -ENOENT;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	d = dest_find_locked(dst);
+	if (d != NULL) {
+		*out = (struct coap_rto_stats){
+			.strong_rtt_ms = d->strong.rtt_ms,
+			.strong_rttvar_ms = d->strong.rttvar_ms,
+			.weak_rtt_ms = d->weak.rtt_ms,
+			.weak_rttvar_ms = d->weak.rttvar_ms,
+			.rto_ms = d->rto_ms,
+			.strong_samples = d->strong.samples,
+			.weak_samples = d->weak.samples,
+			.retransmissions = d->retransmissions,
+			.timeouts = d->timeouts,
+		};
+		err = 0;
+	}
+	k_mutex_unlock(&lock);
+
+	return err;
+}
@@ -0,0 +1,418 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <modem/lte_lc.h>
+#include <modem/nrf_modem_lib.h>
+
+#include <cellfund/conn_mgr.h>
+
+LOG_MODULE_REGISTER(conn_mgr, CONFIG_CONN_MGR_LOG_LEVEL);
+
+#define EVT_CONNECTED BIT(0)
+
+static K_MUTEX_DEFINE(lock);
+static K_EVENT_DEFINE(link_events);
+
+static conn_mgr_handler_t subscribers[CONFIG_CONN_MGR_MAX_SUBSCRIBERS];
+
+static struct conn_mgr_state state;
+static struct conn_mgr_stats stats;
+
+static k_timeout_t attempt_timeout;
+static uint32_t backoff_s = CONFIG_CONN_MGR_BACKOFF_MIN;
+
+/* Start of the current attempt, and of the current registered and RRC
+ * connected periods, in uptime ms.
+ */
+static int64_t attempt_start;
+static int64_t registered_since;
+static int64_t rrc_since;
+
+static void timeout_work_fn(struct k_work *work);
+static void retry_work_fn(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(timeout_work, timeout_work_fn);
+static K_WORK_DELAYABLE_DEFINE(retry_work, retry_work_fn);
+
+static void publish(const struct conn_mgr_evt *evt)
+{
+	conn_mgr_handler_t handlers[CONFIG_CONN_MGR_MAX_SUBSCRIBERS];
+
+	k_mutex_lock(&lock, K_FOREVER);
+	memcpy(handlers, subscribers, sizeof(handlers));
+	k_mutex_unlock(&lock);
+
+	for (size_t i = 0; i < ARRAY_SIZE(handlers); i++) {
+		if (handlers[i] != NULL) {
+			handlers[i](evt);
+		}
+	}
+}
+
+/* Called with the lock held. */
+static void attempt_start_locked(void)
+{
+	attempt_start = k_uptime_get();
+	stats.attempts++;
+
+	if (!K_TIMEOUT_EQ(attempt_timeout, K_FOREVER)) {
+		k_work_reschedule(&timeout_work, attempt_timeout);
+	}
+}
+
+static void timeout_work_fn(struct k_work *work)
+{
+	struct conn_mgr_evt evt = { .type = CONN_MGR_EVT_CONNECT_TIMEOUT };
+	uint32_t delay_s;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	if (!state.requested || state.registered) {
+		k_mutex_unlock(&lock);
+		return;
+	}
+
+	stats.timeouts++;
+	delay_s = backoff_s;
+	backoff_s = MIN(backoff_s * 2, CONFIG_CONN_MGR_BACKOFF_MAX);
+	k_mutex_unlock(&lock);
+
+	LOG_WRN("Not registered in time, retrying in %u s", delay_s);
+
+	/* Stop searching until the retry, the modem would otherwise keep
+	 * scanning at full power.
+	 */
+	(void)lte_lc_func_mode_set(LTE_LC_FUNC_MODE_DEACTIVATE_LTE);
+	k_work_reschedule(&retry_work, K_SECONDS(delay_s));
+
+	publish(&evt);
+}
+
+static void retry_work_fn(struct k_work *work)
+{
+	int err;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	if (!state.requested || state.registered) {
+		k_mutex_unlock(&lock);
+		return;
+	}
+
+	attempt_start_locked();
+	k_mutex_unlock(&lock);
+
+	err = lte_lc_connect_async(NULL);
+	if (err) {
+		LOG_ERR("Failed to reconnect, error: %d", err);
+	}
+}
+
+static void registration_update(enum lte_lc_nw_reg_status status)
+{
+	struct conn_mgr_evt evt;
+	bool registered = status == LTE_LC_NW_REG_REGISTERED_HOME ||
+			  status == LTE_LC_NW_REG_REGISTERED_ROAMING;
+	int64_t now = k_uptime_get();
+
+	k_mutex_lock(&lock, K_FOREVER);
+	if (registered == state.registered) {
+		state.roaming = status == LTE_LC_NW_REG_REGISTERED_ROAMING;
+		k_mutex_unlock(&lock);
+		return;
+	}
+
+	state.registered = registered;
+	state.roaming = status == LTE_LC_NW_REG_REGISTERED_ROAMING;
+
+	if (registered) {
+		evt.type = CONN_MGR_EVT_CONNECTED;
+		evt.connect_ms = (uint32_t)(now - attempt_start);
+
+		stats.registrations++;
+		stats.connect_ms_last = evt.connect_ms;
+		stats.connect_ms_total += evt.connect_ms;
+		stats.connect_ms_max = MAX(stats.connect_ms_max, evt.connect_ms);
+		if (stats.registrations == 1 || evt.connect_ms < stats.connect_ms_min) {
+			stats.connect_ms_min = evt.connect_ms;
+		}
+
+		registered_since = now;
+		backoff_s = CONFIG_CONN_MGR_BACKOFF_MIN;
+		k_work_cancel_delayable(&timeout_work);
+		k_work_cancel_delayable(&retry_work);
+		k_event_post(&link_events, EVT_CONNECTED);
+	} else {
+		evt.type = CONN_MGR_EVT_DISCONNECTED;
+
+		stats.registered_ms_total += now - registered_since;
+		k_event_clear(&link_events, EVT_CONNECTED);
+
+		if (state.requested) {
+			/* The modem searches on its own, give it one timeout
+			 * before restarting.
+			 */
+			stats.drops++;
+			attempt_start_locked();
+		}
+	}
+	k_mutex_unlock(&lock);
+
+	if (registered) {
+		LOG_INF("Network registration status: %s, after %u ms",
+			status == LTE_LC_NW_REG_REGISTERED_HOME ?
+			"Connected - home network" : "Connected - roaming", evt.connect_ms);
+	} else {
+		LOG_INF("Network registration lost, status: %d", status);
+	}
+
+	publish(&evt);
+}
+
+static void rrc_update(enum lte_lc_rrc_mode mode)
+{
+	struct conn_mgr_evt evt;
+	bool connected = mode == LTE_LC_RRC_MODE_CONNECTED;
+	int64_t now = k_uptime_get();
+
+	k_mutex_lock(&lock, K_FOREVER);
+	if (connected == state.rrc_connected) {
+		k_mutex_unlock(&lock);
+		return;
+	}
+
+	state.rrc_connected = connected;
+	if (connected) {
+		rrc_since = now;
+	} else {
+		stats.rrc_connected_ms_total += now - rrc_since;
+	}
+	k_mutex_unlock(&lock);
+
+	LOG_DBG("RRC mode: %s", connected ? "Connected" : "Idle");
+
+	evt.type = connected ? CONN_MGR_EVT_RRC_CONNECTED : CONN_MGR_EVT_RRC_IDLE;
+	publish(&evt);
+}
+
+static void lte_handler(const struct lte_lc_evt *const lte_evt)
+{
+	struct conn_mgr_evt evt;
+
+	switch (lte_evt->type) {
+	case LTE_LC_EVT_NW_REG_STATUS:
+		registration_update(lte_evt->nw_reg_status);
+		return;
+	case LTE_LC_EVT_RRC_UPDATE:
+		rrc_update(lte_evt->rrc_mode);
+		return;
+#if defined(CONFIG_LTE_LC_PSM_MODULE)
+	case LTE_LC_EVT_PSM_UPDATE:
+		LOG_INF("PSM parameter update: Periodic TAU: %d s, Active time: %d s",
+			lte_evt->psm_cfg.tau, lte_evt->psm_cfg.active_time);
+		if (lte_evt->psm_cfg.active_time == -1) {
+			LOG_WRN("Network rejected PSM parameters");
+		}
+
+		evt.type = CONN_MGR_EVT_PSM_UPDATE;
+		evt.psm_cfg = lte_evt->psm_cfg;
+		k_mutex_lock(&lock, K_FOREVER);
+		state.psm_cfg = lte_evt->psm_cfg;
+		k_mutex_unlock(&lock);
+		break;
+#endif
+#if defined(CONFIG_LTE_LC_EDRX_MODULE)
+	case LTE_LC_EVT_EDRX_UPDATE:
+		LOG_INF("eDRX parameter update: eDRX: %d ms, PTW: %d ms",
+			(int)(lte_evt->edrx_cfg.edrx * 1000.0f),
+			(int)(lte_evt->edrx_cfg.ptw * 1000.0f));
+
+		evt.type = CONN_MGR_EVT_EDRX_UPDATE;
+		evt.edrx_cfg = lte_evt->edrx_cfg;
+		k_mutex_lock(&lock, K_FOREVER);
+		state.edrx_cfg = lte_evt->edrx_cfg;
+		k_mutex_unlock(&lock);
+		break;
+#endif
+	case LTE_LC_EVT_CELL_UPDATE:
+		LOG_INF("LTE cell changed: Cell ID: %d, Tracking area: %d",
+			lte_evt->cell.id, lte_evt->cell.tac);
+
+		evt.type = CONN_MGR_EVT_CELL_UPDATE;
+		evt.cell = lte_evt->cell;
+		k_mutex_lock(&lock, K_FOREVER);
+		state.cell = lte_evt->cell;
+		k_mutex_unlock(&lock);
+		break;
+	case LTE_LC_EVT_LTE_MODE_UPDATE:
+		LOG_INF("Active LTE mode: %s",
+			lte_evt->lte_mode == LTE_LC_LTE_MODE_LTEM ? "LTE-M" :
+			lte_evt->lte_mode == LTE_LC_LTE_MODE_NBIOT ? "NB-IoT" : "None");
+
+		evt.type = CONN_MGR_EVT_LTE_MODE_UPDATE;
+		evt.lte_mode = lte_evt->lte_mode;
+		k_mutex_lock(&lock, K_FOREVER);
+		state.lte_mode = lte_evt->lte_mode;
+		k_mutex_unlock(&lock);
+		break;
+#if defined(CONFIG_LTE_LC_MODEM_SLEEP_MODULE)
+	case LTE_LC_EVT_MODEM_SLEEP_ENTER:
+	case LTE_LC_EVT_MODEM_SLEEP_EXIT: {
+		bool asleep = lte_evt->type == LTE_LC_EVT_MODEM_SLEEP_ENTER;
+
+		LOG_DBG("Modem sleep %s, type: %d", asleep ? "enter" : "exit",
+			lte_evt->modem_sleep.type);
+
+		evt.type = asleep ? CONN_MGR_EVT_MODEM_SLEEP_ENTER : CONN_MGR_EVT_MODEM_SLEEP_EXIT;
+		evt.modem_sleep = lte_evt->modem_sleep;
+		k_mutex_lock(&lock, K_FOREVER);
+		state.modem_asleep = asleep;
+		k_mutex_unlock(&lock);
+		break;
+	}
+#endif
+#if defined(CONFIG_LTE_LC_NEIGHBOR_CELL_MEAS_MODULE)
+	case LTE_LC_EVT_NEIGHBOR_CELL_MEAS:
+		LOG_DBG("Neighbor cell measurement: %d neighbors",
+			lte_evt->cells_info.ncells_count);
+
+		evt.type = CONN_MGR_EVT_NEIGHBOR_CELL_MEAS;
+		evt.cells_info = lte_evt->cells_info;
+		break;
+#endif
+	default:
+		return;
+	}
+
+	publish(&evt);
+}
+
+int conn_mgr_init(void)
+{
+	int err;
+
+	LOG_INF("Initializing modem library");
+	err = nrf_modem_lib_init();
+	if (err) {
+		LOG_ERR("Failed to initialize the modem library, error: %d", err);
+		return err;
+	}
+
+#if defined(CONFIG_LTE_LC_PSM_MODULE)
+	state.psm_cfg.active_time = -1;
+#endif
+	lte_lc_register_handler(lte_handler);
+
+	return 0;
+}
+
+int conn_mgr_subscribe(conn_mgr_handler_t handler)
+{
+	int err = -ENOMEM;
+
+	if (handler == NULL) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+	for (size_t i = 0; i < ARRAY_SIZE(subscribers); i++) {
+		if (subscribers[i] == NULL || subscribers[i] == handler) {
+			subscribers[i] = handler;
+			err = 0;
+			break;
+		}
+	}
+	k_mutex_unlock(&lock);
+
+	return err;
+}
+
+void conn_mgr_unsubscribe(conn_mgr_handler_t handler)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+	for (size_t i = 0; i < ARRAY_SIZE(subscribers); i++) {
+		if (subscribers[i] == handler) {
+			subscribers[i] = NULL;
+		}
+	}
+	k_mutex_unlock(&lock);
+}
+
+int conn_mgr_connect(k_timeout_t timeout)
+{
+	int err;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	state.requested = true;
+	attempt_timeout = timeout;
+	backoff_s = CONFIG_CONN_MGR_BACKOFF_MIN;
+	k_work_cancel_delayable(&retry_work);
+	if (!state.registered) {
+		attempt_start_locked();
+	}
+	k_mutex_unlock(&lock);
+
+	LOG_INF("Connecting to LTE network");
+	err = lte_lc_connect_async(NULL);
+	if (err) {
+		LOG_ERR("Error in lte_lc_connect_async, error: %d", err);
+		return err;
+	}
+
+	return 0;
+}
+
+int conn_mgr_wait_connected(k_timeout_t timeout)
+{
+	if (k_event_wait(&link_events, EVT_CONNECTED, false, timeout) == 0) {
+		return -ETIMEDOUT;
+	}
+
+	return 0;
+}
+
+int conn_mgr_disconnect(void)
+{
+	int err;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	state.requested = false;
+	k_work_cancel_delayable(&timeout_work);
+	k_work_cancel_delayable(&retry_work);
+	k_mutex_unlock(&lock);
+
+	err = lte_lc_func_mode_set(LTE_LC_FUNC_MODE_DEACTIVATE_LTE);
+	if (err) {
+		LOG_ERR("Failed to deactivate LTE, error: %d", err);
+		return err;
+	}
+
+	return 0;
+}
+
+void conn_mgr_state_get(struct conn_mgr_state *out)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+	*out = state;
+	k_mutex_unlock(&lock);
+}
+
+void conn_mgr_stats_get(struct conn_mgr_stats *out)
+{
+	int64_t now = k_uptime_get();
+
+	k_mutex_lock(&lock, K_FOREVER);
+	*out = stats;
+	if (state.registered) {
+		out->registered_ms_total += now - registered_since;
+	}
+	if (state.rrc_connected) {
+		out->rrc_connected_ms_total += now - rrc_since;
+	}
+	k_mutex_unlock(&lock);
+}
@@ -0,0 +1,364 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/sys/byteorder.h>
+#if defined(CONFIG_RESOLVER)
+#include <cellfund/resolver.h>
+#endif
+
+#include <cellfund/echo_bench.h>
+
+LOG_MODULE_REGISTER(echo_bench, CONFIG_ECHO_BENCH_LOG_LEVEL);
+
+#define DGRAM_COUNT (CONFIG_ECHO_BENCH_BURSTS * CONFIG_ECHO_BENCH_BURST_LEN)
+#define DGRAM_SIZE_MIN MIN(CONFIG_ECHO_BENCH_SIZE_MIN, CONFIG_ECHO_BENCH_SIZE_MAX)
+#define DGRAM_SIZE_MAX MAX(CONFIG_ECHO_BENCH_SIZE_MIN, CONFIG_ECHO_BENCH_SIZE_MAX)
+
+/* Datagram header: magic, run, sequence number and send time in us since
+ * the start of the run, all big endian. The rest is a pattern.
+ */
+#define HDR_MAGIC 0x4542
+#define HDR_LEN 12
+
+static K_MUTEX_DEFINE(lock);
+static K_SEM_DEFINE(run_sem, 0, 1);
+static bool running;
+static bool result_valid;
+static struct echo_bench_result last_result;
+static struct sockaddr_storage server;
+static socklen_t server_len;
+
+/* State of the current run, only used by the benchmark thread */
+static uint16_t run_id;
+static int run_family;
+static int64_t start_ticks;
+static uint32_t tx_us[DGRAM_COUNT];
+static uint32_t rtt_us[DGRAM_COUNT];
+static uint32_t echoed[DIV_ROUND_UP(DGRAM_COUNT, 32)];
+static uint32_t seq_max;
+static uint32_t bytes_echoed;
+static uint32_t last_echo_us;
+static struct echo_bench_result result;
+static uint8_t tx_buf[DGRAM_SIZE_MAX];
+static uint8_t rx_buf[DGRAM_SIZE_MAX + 1];
+
+static uint32_t now_us(void)
+{
+	return (uint32_t)k_ticks_to_us_floor64(k_uptime_ticks() - start_ticks);
+}
+
+/* Every burst goes from the smallest to the largest size. */
+static size_t dgram_size(uint32_t seq)
+{
+	uint32_t step = seq % CONFIG_ECHO_BENCH_BURST_LEN;
+
+	if (CONFIG_ECHO_BENCH_BURST_LEN == 1) {
+		return DGRAM_SIZE_MIN;
+	}
+
+	return DGRAM_SIZE_MIN +
+	       (DGRAM_SIZE_MAX - DGRAM_SIZE_MIN) * step / (CONFIG_ECHO_BENCH_BURST_LEN - 1);
+}
+
+static void dgram_send(int sock, uint32_t seq)
+{
+	size_t len = dgram_size(seq);
+
+	tx_us[seq] = now_us();
+	sys_put_be16(HDR_MAGIC, &tx_buf[0]);
+	sys_put_be16(run_id, &tx_buf[2]);
+	sys_put_be32(seq, &tx_buf[4]);
+	sys_put_be32(tx_us[seq], &tx_buf[8]);
+	for (size_t i = HDR_LEN; i < len; i++) {
+		tx_buf[i] = (uint8_t)(seq + i);
+	}
+
+	if (zsock_send(sock, tx_buf, len, 0) < 0) {
+		LOG_DBG("Failed to send datagram %u, error: %d", seq, errno);
+		result.send_errors++;
+		return;
+	}
+
+	result.sent++;
+}
+
+static bool echo_valid(const uint8_t *buf, size_t len, uint32_t *seq)
+{
+	if (len < HDR_LEN || sys_get_be16(&buf[0]) != HDR_MAGIC ||
+	    sys_get_be16(&buf[2]) != run_id) {
+		return false;
+	}
+
+	*seq = sys_get_be32(&buf[4]);
+
+	return *seq < DGRAM_COUNT && len == dgram_size(*seq) &&
+	       sys_get_be32(&buf[8]) == tx_us[*seq];
+}
+
+static void echo_handle(const uint8_t *buf, size_t len)
+{
+	uint32_t now = now_us();
+	uint32_t seq;
+
+	if (!echo_valid(buf, len, &seq)) {
+		result.invalid++;
+		return;
+	}
+
+	if (echoed[seq / 32] & BIT(seq % 32)) {
+		result.duplicates++;
+		return;
+	}
+
+	echoed[seq / 32] |= BIT(seq % 32);
+	rtt_us[result.received++] = now - tx_us[seq];
+	bytes_echoed += len;
+	last_echo_us = now;
+
+	if (seq < seq_max) {
+		result.reordered++;
+	}
+	seq_max = MAX(seq_max, seq);
+
+#if defined(CONFIG_RESOLVER)
+	resolver_rtt_add(run_family, (now - tx_us[seq]) / USEC_PER_MSEC);
+#endif
+}
+
+/* Receives echoes until the deadline, or until all sent datagrams are echoed. */
+static int echoes_receive(int sock, int64_t deadline, bool until_all)
+{
+	struct zsock_pollfd fds = {
+		.fd = sock,
+		.events = ZSOCK_POLLIN,
+	};
+	int64_t remaining;
+	int ret;
+
+	while ((remaining = deadline - k_uptime_get()) > 0) {
+		if (until_all && result.received == result.sent) {
+			break;
+		}
+
+		ret = zsock_poll(&fds, 1, (int)remaining);
+		if (ret < 0) {
+			return -errno;
+		} else if (ret == 0) {
+			break;
+		}
+
+		ret = zsock_recv(sock, rx_buf, sizeof(rx_buf), ZSOCK_MSG_DONTWAIT);
+		if (ret < 0) {
+			if (errno == EAGAIN) {
+				continue;
+			}
+
+			return -errno;
+		}
+
+		echo_handle(rx_buf, ret);
+	}
+
+	return 0;
+}
+
+static int cmp_u32(const void *a, const void *b)
+{
+	uint32_t x = *(const uint32_t *)a;
+	uint32_t y = *(const uint32_t *)b;
+
+	return x < y ? -1 : x > y;
+}
+
+static uint32_t percentile(uint32_t pct)
+{
+	return rtt_us[(result.received - 1) * pct / 100];
+}
+
+static void result_finish(void)
+{
+	result.lost = result.sent - result.received;
+	result.duration_ms = last_echo_us / USEC_PER_MSEC;
+
+	if (result.received == 0) {
+		return;
+	}
+
+	qsort(rtt_us, result.received, sizeof(rtt_us[0]), cmp_u32);
+	result.rtt_us_min = rtt_us[0];
+	result.rtt_us_p50 = percentile(50);
+	result.rtt_us_p90 = percentile(90);
+	result.rtt_us_p99 = percentile(99);
+	result.rtt_us_max = rtt_us[result.received - 1];
+
+	if (last_echo_us > 0) {
+		result.goodput_bps = (uint64_t)bytes_echoed * 8 * USEC_PER_SEC / last_echo_us;
+	}
+}
+
+static void result_log(const struct echo_bench_result *res)
+{
+	LOG_INF("Echo benchmark: %u sent, %u echoed, %u lost (%u%%), %u reordered, "
+		"%u duplicates, %u invalid, %u send errors", res->sent, res->received, res->lost,
+		res->sent ? res->lost * 100 / res->sent : 0, res->reordered, res->duplicates,
+		res->invalid, res->send_errors);
+
+	if (res->received == 0) {
+		return;
+	}
+
+	LOG_INF("RTT: min %u us, p50 %u us, p90 %u us, p99 %u us, max %u us", res->rtt_us_min,
+		res->rtt_us_p50, res->rtt_us_p90, res->rtt_us_p99, res->rtt_us_max);
+	LOG_INF("Goodput: %u bit/s over %u ms", res->goodput_bps, res->duration_ms);
+}
+
+static int run(const struct sockaddr *addr, socklen_t addrlen)
+{
+	int64_t burst_time;
+	int sock;
+	int err = 0;
+
+	sock = zsock_socket(addr->sa_family, SOCK_DGRAM, IPPROTO_UDP);
+	if (sock < 0) {
+		LOG_ERR("Failed to create socket: %d", errno);
+		return -errno;
+	}
+
+	if (zsock_connect(sock, addr, addrlen) < 0) {
+		LOG_ERR("Connect failed: %d", errno);
+		err = -errno;
+		goto out;
+	}
+
+	memset(&result, 0, sizeof(result));
+	memset(echoed, 0, sizeof(echoed));
+	seq_max = 0;
+	bytes_echoed = 0;
+	last_echo_us = 0;
+	run_family = addr->sa_family;
+	run_id++;
+
+	LOG_INF("Running %u bursts of %u datagrams, %u to %u bytes, every %u ms",
+		CONFIG_ECHO_BENCH_BURSTS, CONFIG_ECHO_BENCH_BURST_LEN, DGRAM_SIZE_MIN,
+		DGRAM_SIZE_MAX, CONFIG_ECHO_BENCH_INTERVAL_MS);
+
+	start_ticks = k_uptime_ticks();
+	burst_time = k_uptime_get();
+
+	for (uint32_t burst = 0; burst < CONFIG_ECHO_BENCH_BURSTS; burst++) {
+		for (uint32_t i = 0; i < CONFIG_ECHO_BENCH_BURST_LEN; i++) {
+			dgram_send(sock, burst * CONFIG_ECHO_BENCH_BURST_LEN + i);
+		}
+
+		burst_time += CONFIG_ECHO_BENCH_INTERVAL_MS;
+		if (burst + 1 < CONFIG_ECHO_BENCH_BURSTS) {
+			err = echoes_receive(sock, burst_time, false);
+		} else {
+			err = echoes_receive(sock, k_uptime_get() + CONFIG_ECHO_BENCH_TIMEOUT_MS,
+					     true);
+		}
+
+		if (err) {
+			LOG_ERR("Failed to receive echoes, error: %d", err);
+			goto out;
+		}
+	}
+
+	result_finish();
+
+out:
+	(void)zsock_close(sock);
+
+	return err;
+}
+
+/* The server given to echo_bench_start(), or CONFIG_ECHO_BENCH_HOSTNAME. */
+static int server_get(struct sockaddr_storage *addr, socklen_t *addrlen)
+{
+#if defined(CONFIG_RESOLVER)
+	if (strlen(CONFIG_ECHO_BENCH_HOSTNAME) > 0) {
+		return resolver_lookup(CONFIG_ECHO_BENCH_HOSTNAME, CONFIG_ECHO_BENCH_PORT,
+				       SOCK_DGRAM, addr, addrlen);
+	}
+#endif
+
+	k_mutex_lock(&lock, K_FOREVER);
+	*addr = server;
+	*addrlen = server_len;
+	k_mutex_unlock(&lock);
+
+	return 0;
+}
+
+static void echo_bench_thread(void)
+{
+	struct sockaddr_storage addr;
+	socklen_t addrlen;
+
+	while (true) {
+		k_sem_take(&run_sem, K_FOREVER);
+
+		if (server_get(&addr, &addrlen) == 0 &&
+		    run((struct sockaddr *)&addr, addrlen) == 0) {
+			result_log(&result);
+
+			k_mutex_lock(&lock, K_FOREVER);
+			last_result = result;
+			result_valid = true;
+			k_mutex_unlock(&lock);
+		}
+
+		k_mutex_lock(&lock, K_FOREVER);
+		running = false;
+		k_mutex_unlock(&lock);
+	}
+}
+
+K_THREAD_DEFINE(echo_bench_tid, CONFIG_ECHO_BENCH_STACK_SIZE,
+		echo_bench_thread, NULL, NULL, NULL,
+		CONFIG_ECHO_BENCH_THREAD_PRIORITY, 0, 0);
+
+int echo_bench_start(const struct sockaddr *addr, socklen_t addrlen)
+{
+	if (addrlen > sizeof(server)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+	if (running) {
+		k_mutex_unlock(&lock);
+		return -EBUSY;
+	}
+
+	running = true;
+	memcpy(&server, addr, addrlen);
+	server_len = addrlen;
+	k_mutex_unlock(&lock);
+
+	k_sem_give(&run_sem);
+
+	return 0;
+}
+
+int echo_bench_result_get(struct echo_bench_result *out)
+{
+	int err = -ENODATA;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	if (result_valid) {
+		*out = last_result;
+		err = 0;
+	}
+	k_mutex_unlock(&lock);
+
+	return err;
+}
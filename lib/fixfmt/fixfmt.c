@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <nrf_modem_gnss.h>
+
+#include <cellfund/fixfmt.h>
+
+/* Rounds val / div to nearest, away from zero on ties. */
+static int64_t div_round(int64_t val, int64_t div)
+{
+	return val < 0 ? (val - div / 2) / div : (val + div / 2) / div;
+}
+
+int fixfmt_fixed(char *buf, size_t len, int64_t val, unsigned int decimals)
+{
+	char digits[20];
+	uint64_t mag = val < 0 ? -(uint64_t)val : (uint64_t)val;
+	size_t n = 0, out = 0;
+
+	if (decimals > 9) {
+		return -EINVAL;
+	}
+
+	/* Digits in reverse, with at least one before the decimal point. */
+	do {
+		digits[n++] = '0' + mag % 10;
+		mag /= 10;
+	} while (mag != 0 || n <= decimals);
+
+	if (len < (val < 0) + n + (decimals > 0) + 1) {
+		return -ENOMEM;
+	}
+
+	if (val < 0) {
+		buf[out++] = '-';
+	}
+
+	while (n > 0) {
+		if (n == decimals) {
+			buf[out++] = '.';
+		}
+		buf[out++] = digits[--n];
+	}
+
+	buf[out] = '\0';
+
+	return out;
+}
+
+int fixfmt_deg_e7(char *buf, size_t len, int32_t deg_e7)
+{
+	return fixfmt_fixed(buf, len, div_round(deg_e7, 10), 6);
+}
+
+int fixfmt_mm(char *buf, size_t len, int64_t mm)
+{
+	return fixfmt_fixed(buf, len, div_round(mm, 100), 1);
+}
+
+static char *put_num(char *p, uint32_t val, int width)
+{
+	for (int i = width - 1; i >= 0; i--) {
+		p[i] = '0' + val % 10;
+		val /= 10;
+	}
+
+	return p + width;
+}
+
+int fixfmt_iso8601(char *buf, size_t len, const struct nrf_modem_gnss_datetime *dt)
+{
+	char *p = buf;
+
+	if (len < FIXFMT_ISO8601_LEN) {
+		return -ENOMEM;
+	}
+
+	p = put_num(p, dt->year, 4);
+	*p++ = '-';
+	p = put_num(p, dt->month, 2);
+	*p++ = '-';
+	p = put_num(p, dt->day, 2);
+	*p++ = 'T';
+	p = put_num(p, dt->hour, 2);
+	*p++ = ':';
+	p = put_num(p, dt->minute, 2);
+	*p++ = ':';
+	p = put_num(p, dt->seconds, 2);
+	*p++ = '.';
+	p = put_num(p, dt->ms, 3);
+	*p++ = 'Z';
+	*p = '\0';
+
+	return p - buf;
+}
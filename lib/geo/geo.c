@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+
+#include <cellfund/geo.h>
+
+/* sin() for whole degrees from 0 to 90, Q15. */
+static const int16_t sin_table[91] = {
+	0, 572, 1144, 1715, 2286, 2856, 3425, 3993, 4560, 5126,
+	5690, 6252, 6813, 7371, 7927, 8481, 9032, 9580, 10126, 10668,
+	11207, 11743, 12275, 12803, 13328, 13848, 14364, 14876, 15383, 15886,
+	16383, 16876, 17364, 17846, 18323, 18794, 19260, 19720, 20173, 20621,
+	21062, 21497, 21925, 22347, 22762, 23170, 23571, 23964, 24351, 24730,
+	25101, 25465, 25821, 26169, 26509, 26841, 27165, 27481, 27788, 28087,
+	28377, 28659, 28932, 29196, 29451, 29697, 29934, 30162, 30381, 30591,
+	30791, 30982, 31163, 31335, 31498, 31650, 31794, 31927, 32051, 32165,
+	32269, 32364, 32448, 32523, 32587, 32642, 32687, 32722, 32747, 32762,
+	32767,
+};
+
+int32_t geo_sin_q15(int32_t deci_deg)
+{
+	int32_t angle = deci_deg % 3600;
+	int32_t sign = 1;
+	int32_t idx, frac, val;
+
+	if (angle < 0) {
+		angle += 3600;
+	}
+
+	if (angle >= 1800) {
+		angle -= 1800;
+		sign = -1;
+	}
+
+	if (angle > 900) {
+		angle = 1800 - angle;
+	}
+
+	idx = angle / 10;
+	frac = angle % 10;
+	val = sin_table[idx];
+	if (frac != 0) {
+		val += (sin_table[idx + 1] - val) * frac / 10;
+	}
+
+	return sign * val;
+}
+
+int32_t geo_cos_q15(int32_t deci_deg)
+{
+	return geo_sin_q15(deci_deg + 900);
+}
+
+uint32_t geo_isqrt64(uint64_t val)
+{
+	uint64_t res = 0;
+	uint64_t bit = 1ULL << 62;
+
+	while (bit > val) {
+		bit >>= 2;
+	}
+
+	while (bit != 0) {
+		if (val >= res + bit) {
+			val -= res + bit;
+			res = (res >> 1) + bit;
+		} else {
+			res >>= 1;
+		}
+		bit >>= 2;
+	}
+
+	return (uint32_t)res;
+}
+
+int32_t geo_lon_wrap(int64_t lon_e7)
+{
+	if (lon_e7 > 1800000000LL) {
+		lon_e7 -= 3600000000LL;
+	} else if (lon_e7 < -1800000000LL) {
+		lon_e7 += 3600000000LL;
+	}
+
+	return (int32_t)lon_e7;
+}
+
+void geo_frame_init(struct geo_frame *frame, int32_t lat_e7, int32_t lon_e7)
+{
+	frame->lat0_e7 = lat_e7;
+	frame->lon0_e7 = lon_e7;
+	frame->lon_scale_q16 = MAX(((int64_t)GEO_LAT_SCALE_Q16 *
+				    geo_cos_q15(lat_e7 / 1000000)) >> 15, 1);
+}
+
+void geo_to_local(const struct geo_frame *frame, int32_t lat_e7, int32_t lon_e7,
+		  int64_t *north_mm, int64_t *east_mm)
+{
+	*north_mm = ((int64_t)(lat_e7 - frame->lat0_e7) * GEO_LAT_SCALE_Q16) >> 16;
+	*east_mm = ((int64_t)geo_lon_wrap((int64_t)lon_e7 - frame->lon0_e7) *
+		    frame->lon_scale_q16) >> 16;
+}
+
+void geo_from_local(const struct geo_frame *frame, int64_t north_mm, int64_t east_mm,
+		    int32_t *lat_e7, int32_t *lon_e7)
+{
+	*lat_e7 = frame->lat0_e7 + (int32_t)((north_mm << 16) / GEO_LAT_SCALE_Q16);
+	*lon_e7 = geo_lon_wrap(frame->lon0_e7 + (east_mm << 16) / frame->lon_scale_q16);
+}
@@ -0,0 +1,316 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include <cellfund/geo.h>
+#include <cellfund/geofence.h>
+
+LOG_MODULE_REGISTER(geofence, CONFIG_GEOFENCE_LOG_LEVEL);
+
+#define GRID_SIZE CONFIG_GEOFENCE_GRID_SIZE
+#define GRID_CELLS (GRID_SIZE * GRID_SIZE)
+
+/* Keeps the squared distances within 64 bits. */
+#define MAX_RADIUS_M 1000000
+
+#define BITMAP_WORDS DIV_ROUND_UP(CONFIG_GEOFENCE_MAX_FENCES, 32)
+
+struct bbox {
+	int32_t lat_min;
+	int32_t lat_max;
+	int32_t lon_min;
+	int32_t lon_max;
+};
+
+static const struct geofence *fences;
+static size_t fence_count;
+static geofence_handler_t app_handler;
+
+/* Grid over the bounding box of all fences. The fences overlapping cell i are
+ * index_entries[cell_start[i]] up to index_entries[cell_start[i + 1]].
+ */
+static struct bbox grid_box;
+static uint16_t cell_start[GRID_CELLS + 1];
+static uint16_t index_entries[CONFIG_GEOFENCE_INDEX_ENTRIES];
+
+static uint32_t inside[BITMAP_WORDS];
+static bool inside_any;
+
+static int fence_bbox(const struct geofence *fence, struct bbox *box)
+{
+	struct geo_frame frame;
+	int32_t dlat, dlon, edge_lat;
+
+	switch (fence->type) {
+	case GEOFENCE_CIRCLE:
+		if (fence->circle.radius_m == 0 || fence->circle.radius_m > MAX_RADIUS_M) {
+			return -EINVAL;
+		}
+
+		dlat = ((int64_t)fence->circle.radius_m * 1000 << 16) / GEO_LAT_SCALE_Q16 + 1;
+
+		/* Degrees of longitude are shortest at the edge closest to the pole. */
+		edge_lat = MIN(abs(fence->circle.lat_e7) + dlat, 899000000);
+		geo_frame_init(&frame, edge_lat, 0);
+		dlon = ((int64_t)fence->circle.radius_m * 1000 << 16) / frame.lon_scale_q16 + 1;
+
+		box->lat_min = fence->circle.lat_e7 - dlat;
+		box->lat_max = fence->circle.lat_e7 + dlat;
+		box->lon_min = fence->circle.lon_e7 - dlon;
+		box->lon_max = fence->circle.lon_e7 + dlon;
+		return 0;
+	case GEOFENCE_POLYGON:
+		if (fence->polygon.vertices == NULL || fence->polygon.count < 3) {
+			return -EINVAL;
+		}
+
+		box->lat_min = box->lat_max = fence->polygon.vertices[0].lat_e7;
+		box->lon_min = box->lon_max = fence->polygon.vertices[0].lon_e7;
+
+		for (size_t i = 1; i < fence->polygon.count; i++) {
+			box->lat_min = MIN(box->lat_min, fence->polygon.vertices[i].lat_e7);
+			box->lat_max = MAX(box->lat_max, fence->polygon.vertices[i].lat_e7);
+			box->lon_min = MIN(box->lon_min, fence->polygon.vertices[i].lon_e7);
+			box->lon_max = MAX(box->lon_max, fence->polygon.vertices[i].lon_e7);
+		}
+		return 0;
+	default:
+		return -EINVAL;
+	}
+}
+
+static int grid_coord(int32_t val, int32_t min, int32_t max)
+{
+	int64_t cell = ((int64_t)val - min) * GRID_SIZE / ((int64_t)max - min + 1);
+
+	return CLAMP(cell, 0, GRID_SIZE - 1);
+}
+
+/* Calls fn for every grid cell overlapping a bounding box. */
+static void for_each_cell(const struct bbox *box, uint16_t fence_idx,
+			  void (*fn)(int cell, uint16_t fence_idx))
+{
+	int lat0 = grid_coord(box->lat_min, grid_box.lat_min, grid_box.lat_max);
+	int lat1 = grid_coord(box->lat_max, grid_box.lat_min, grid_box.lat_max);
+	int lon0 = grid_coord(box->lon_min, grid_box.lon_min, grid_box.lon_max);
+	int lon1 = grid_coord(box->lon_max, grid_box.lon_min, grid_box.lon_max);
+
+	for (int lat = lat0; lat <= lat1; lat++) {
+		for (int lon = lon0; lon <= lon1; lon++) {
+			fn(lat * GRID_SIZE + lon, fence_idx);
+		}
+	}
+}
+
+static void cell_count(int cell, uint16_t fence_idx)
+{
+	cell_start[cell + 1]++;
+}
+
+static void cell_fill(int cell, uint16_t fence_idx)
+{
+	/* cell_start[cell] is used as the fill position, it is restored afterwards. */
+	index_entries[cell_start[cell]++] = fence_idx;
+}
+
+int geofence_init(const struct geofence *table, size_t count, geofence_handler_t handler)
+{
+	struct bbox box;
+	uint32_t total = 0;
+	int err;
+
+	if (count == 0 || count > CONFIG_GEOFENCE_MAX_FENCES) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		err = fence_bbox(&table[i], &box);
+		if (err) {
+			LOG_ERR("Invalid fence %zu", i);
+			return err;
+		}
+
+		if (i == 0) {
+			grid_box = box;
+		} else {
+			grid_box.lat_min = MIN(grid_box.lat_min, box.lat_min);
+			grid_box.lat_max = MAX(grid_box.lat_max, box.lat_max);
+			grid_box.lon_min = MIN(grid_box.lon_min, box.lon_min);
+			grid_box.lon_max = MAX(grid_box.lon_max, box.lon_max);
+		}
+	}
+
+	memset(cell_start, 0, sizeof(cell_start));
+
+	for (size_t i = 0; i < count; i++) {
+		(void)fence_bbox(&table[i], &box);
+		for_each_cell(&box, i, cell_count);
+	}
+
+	for (int i = 0; i < GRID_CELLS; i++) {
+		total += cell_start[i + 1];
+		if (total > ARRAY_SIZE(index_entries)) {
+			LOG_ERR("Grid index needs more than %d entries",
+				CONFIG_GEOFENCE_INDEX_ENTRIES);
+			return -ENOMEM;
+		}
+		cell_start[i + 1] = total;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		(void)fence_bbox(&table[i], &box);
+		for_each_cell(&box, i, cell_fill);
+	}
+
+	/* Filling moved each start to the start of the next cell. */
+	memmove(&cell_start[1], &cell_start[0], GRID_CELLS * sizeof(cell_start[0]));
+	cell_start[0] = 0;
+
+	fences = table;
+	fence_count = count;
+	app_handler = handler;
+	memset(inside, 0, sizeof(inside));
+	inside_any = false;
+
+	LOG_INF("%zu fences indexed with %u grid entries", count, total);
+
+	return 0;
+}
+
+static bool circle_contains(const struct geofence *fence, int32_t lat_e7, int32_t lon_e7)
+{
+	struct geo_frame frame;
+	int64_t north, east, radius_mm;
+
+	geo_frame_init(&frame, fence->circle.lat_e7, fence->circle.lon_e7);
+	geo_to_local(&frame, lat_e7, lon_e7, &north, &east);
+	radius_mm = fence->circle.radius_m * 1000LL;
+
+	if (north > radius_mm || north < -radius_mm || east > radius_mm || east < -radius_mm) {
+		return false;
+	}
+
+	return north * north + east * east <= radius_mm * radius_mm;
+}
+
+/* Crossing number test, with coordinates relative to the point. */
+static bool polygon_contains(const struct geofence *fence, int32_t lat_e7, int32_t lon_e7)
+{
+	const struct geofence_vertex *vertices = fence->polygon.vertices;
+	size_t count = fence->polygon.count;
+	bool in = false;
+	int64_t ax, ay, bx, by, num, den;
+
+	bx = geo_lon_wrap((int64_t)vertices[count - 1].lon_e7 - lon_e7);
+	by = (int64_t)vertices[count - 1].lat_e7 - lat_e7;
+
+	for (size_t i = 0; i < count; i++) {
+		ax = bx;
+		ay = by;
+		bx = geo_lon_wrap((int64_t)vertices[i].lon_e7 - lon_e7);
+		by = (int64_t)vertices[i].lat_e7 - lat_e7;
+
+		if ((ay > 0) == (by > 0)) {
+			continue;
+		}
+
+		/* The edge crosses the point's latitude east of the point if the
+		 * intercept ax - ay * (bx - ax) / (by - ay) is positive.
+		 */
+		num = ax * (by - ay) - ay * (bx - ax);
+		den = by - ay;
+		if ((num > 0) == (den > 0) && num != 0) {
+			in = !in;
+		}
+	}
+
+	return in;
+}
+
+static bool fence_contains(const struct geofence *fence, int32_t lat_e7, int32_t lon_e7)
+{
+	if (fence->type == GEOFENCE_CIRCLE) {
+		return circle_contains(fence, lat_e7, lon_e7);
+	}
+
+	return polygon_contains(fence, lat_e7, lon_e7);
+}
+
+static void raise_event(enum geofence_evt_type type, uint16_t idx)
+{
+	struct geofence_evt evt = {
+		.type = type,
+		.idx = idx,
+		.fence = &fences[idx],
+	};
+
+	LOG_DBG("%s %s", type == GEOFENCE_EVT_ENTER ? "Entered" : "Left",
+		fences[idx].name);
+
+	if (app_handler != NULL) {
+		app_handler(&evt);
+	}
+}
+
+int geofence_update(int32_t lat_e7, int32_t lon_e7)
+{
+	uint32_t now_inside[BITMAP_WORDS] = {0};
+	uint32_t start = k_cycle_get_32();
+	uint32_t changed;
+	int cell, tested = 0, events = 0;
+
+	if (fences == NULL) {
+		return 0;
+	}
+
+	if (lat_e7 >= grid_box.lat_min && lat_e7 <= grid_box.lat_max &&
+	    lon_e7 >= grid_box.lon_min && lon_e7 <= grid_box.lon_max) {
+		cell = grid_coord(lat_e7, grid_box.lat_min, grid_box.lat_max) * GRID_SIZE +
+		       grid_coord(lon_e7, grid_box.lon_min, grid_box.lon_max);
+
+		for (int i = cell_start[cell]; i < cell_start[cell + 1]; i++) {
+			uint16_t idx = index_entries[i];
+
+			if (fence_contains(&fences[idx], lat_e7, lon_e7)) {
+				now_inside[idx / 32] |= BIT(idx % 32);
+			}
+			tested++;
+		}
+	}
+
+	inside_any = false;
+
+	for (int word = 0; word < BITMAP_WORDS; word++) {
+		changed = inside[word] ^ now_inside[word];
+		inside[word] = now_inside[word];
+		inside_any |= now_inside[word] != 0;
+
+		while (changed != 0) {
+			int bit = __builtin_ctz(changed);
+
+			changed &= changed - 1;
+			raise_event(now_inside[word] & BIT(bit) ? GEOFENCE_EVT_ENTER :
+								 GEOFENCE_EVT_EXIT,
+				    word * 32 + bit);
+			events++;
+		}
+	}
+
+	LOG_DBG("%d fences tested in %u us", tested,
+		k_cyc_to_us_floor32(k_cycle_get_32() - start));
+
+	return events;
+}
+
+bool geofence_inside_any(void)
+{
+	return inside_any;
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/spsc_lockfree.h>
+#include <zephyr/logging/log.h>
+#include <nrf_modem_gnss.h>
+
+#include <cellfund/gnss_pipeline.h>
+#include <cellfund/pvt_recording.h>
+
+LOG_MODULE_REGISTER(gnss_pipeline, CONFIG_GNSS_PIPELINE_LOG_LEVEL);
+
+/* The modem library is the only producer and the pipeline thread the only
+ * consumer, so the ring needs no locking on either side.
+ */
+SPSC_DEFINE(evt_ring, struct gnss_pipeline_evt, CONFIG_GNSS_PIPELINE_RING_SIZE);
+static K_SEM_DEFINE(evt_pending, 0, CONFIG_GNSS_PIPELINE_RING_SIZE);
+
+static gnss_pipeline_handler_t app_handler;
+
+static atomic_t stat_events;
+static atomic_t stat_processed;
+static atomic_t stat_dropped;
+static atomic_t stat_coalesced;
+static atomic_t stat_read_errors;
+static atomic_t stat_max_depth;
+
+/* Only written by the pipeline thread. */
+static uint32_t handler_us_total;
+static uint32_t handler_us_max;
+
+static bool event_has_pvt(int event)
+{
+	switch (event) {
+	case NRF_MODEM_GNSS_EVT_PVT:
+	case NRF_MODEM_GNSS_EVT_FIX:
+	case NRF_MODEM_GNSS_EVT_SLEEP_AFTER_FIX:
+		return true;
+	default:
+		return false;
+	}
+}
+
+/* Runs in the modem library's interrupt context. Only copies the event into
+ * the ring, everything else is left to the pipeline thread.
+ */
+static void gnss_isr_handler(int event)
+{
+	struct gnss_pipeline_evt *slot;
+	atomic_val_t depth;
+
+	atomic_inc(&stat_events);
+
+	slot = spsc_acquire(&evt_ring);
+	if (slot == NULL) {
+		atomic_inc(&stat_dropped);
+		return;
+	}
+
+	slot->id = event;
+	slot->has_pvt = false;
+
+	if (event_has_pvt(event)) {
+		if (nrf_modem_gnss_read(&slot->pvt, sizeof(slot->pvt),
+					NRF_MODEM_GNSS_DATA_PVT) == 0) {
+			slot->has_pvt = true;
+		} else {
+			atomic_inc(&stat_read_errors);
+			if (event == NRF_MODEM_GNSS_EVT_PVT) {
+				/* Nothing to deliver without the frame. */
+				spsc_drop_all(&evt_ring);
+				return;
+			}
+		}
+	}
+
+	spsc_produce(&evt_ring);
+	k_sem_give(&evt_pending);
+
+	depth = k_sem_count_get(&evt_pending);
+	if (depth > atomic_get(&stat_max_depth)) {
+		atomic_set(&stat_max_depth, depth);
+	}
+}
+
+static bool can_coalesce(const struct gnss_pipeline_evt *evt)
+{
+	if (!IS_ENABLED(CONFIG_GNSS_PIPELINE_COALESCE_PVT)) {
+		return false;
+	}
+
+	/* Only plain PVT frames without a fix are superseded by newer ones. */
+	return evt->id == NRF_MODEM_GNSS_EVT_PVT &&
+	       !(evt->pvt.flags & NRF_MODEM_GNSS_PVT_FLAG_FIX_VALID) &&
+	       k_sem_count_get(&evt_pending) > 0;
+}
+
+static void handler_run(const struct gnss_pipeline_evt *evt)
+{
+	uint32_t start = k_cycle_get_32();
+	uint32_t elapsed_us;
+
+	app_handler(evt);
+
+	elapsed_us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+	handler_us_total += elapsed_us;
+	handler_us_max = MAX(handler_us_max, elapsed_us);
+}
+
+static void gnss_pipeline_thread(void)
+{
+	struct gnss_pipeline_evt *evt;
+
+	while (true) {
+		k_sem_take(&evt_pending, K_FOREVER);
+
+		evt = spsc_consume(&evt_ring);
+		if (evt == NULL) {
+			continue;
+		}
+
+		if (IS_ENABLED(CONFIG_PVT_RECORD)) {
+			pvt_record_add(evt->id, evt->has_pvt ? &evt->pvt : NULL);
+		}
+
+		if (can_coalesce(evt)) {
+			atomic_inc(&stat_coalesced);
+		} else {
+			handler_run(evt);
+			atomic_inc(&stat_processed);
+		}
+
+		spsc_release(&evt_ring);
+	}
+}
+
+K_THREAD_DEFINE(gnss_pipeline_tid, CONFIG_GNSS_PIPELINE_STACK_SIZE,
+		gnss_pipeline_thread, NULL, NULL, NULL,
+		CONFIG_GNSS_PIPELINE_THREAD_PRIORITY, 0, 0);
+
+int gnss_pipeline_init(gnss_pipeline_handler_t handler)
+{
+	int err;
+
+	if (handler == NULL) {
+		return -EINVAL;
+	}
+
+	app_handler = handler;
+
+	err = nrf_modem_gnss_event_handler_set(gnss_isr_handler);
+	if (err) {
+		LOG_ERR("Failed to set GNSS event handler, error: %d", err);
+		return err;
+	}
+
+	return 0;
+}
+
+void gnss_pipeline_stats_get(struct gnss_pipeline_stats *stats)
+{
+	stats->events = atomic_get(&stat_events);
+	stats->processed = atomic_get(&stat_processed);
+	stats->dropped = atomic_get(&stat_dropped);
+	stats->coalesced = atomic_get(&stat_coalesced);
+	stats->read_errors = atomic_get(&stat_read_errors);
+	stats->max_depth = atomic_get(&stat_max_depth);
+	stats->handler_us_total = handler_us_total;
+	stats->handler_us_max = handler_us_max;
+}
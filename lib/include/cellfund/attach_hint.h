@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef CELLFUND_ATTACH_HINT_H_
+#define CELLFUND_ATTACH_HINT_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Last serving cell, as reported by AT%XMONITOR. */
+struct attach_hint_cell {
+	/** MCC and MNC digits as reported, with leading zeros, empty if no
+	 *  cell is known.
+	 */
+	char plmn[7];
+	uint32_t cell_id;
+	uint32_t earfcn;
+	uint16_t tac;
+	uint8_t band;
+};
+
+/** @brief Search time statistics, in ms. */
+struct attach_hint_stats {
+	/** Attaches with the band and network hints applied. */
+	uint32_t hinted;
+	uint32_t hinted_ms_total;
+	/** Attaches that fell back to a full search after the hint timeout. */
+	uint32_t fallbacks;
+	uint32_t fallback_ms_total;
+	/** Attaches without hints, when no cell was known. */
+	uint32_t full;
+	uint32_t full_ms_total;
+	/** Attaches that ended on the stored cell. */
+	uint32_t same_cell;
+};
+
+/**
+ * @brief Load the stored cell and start tracking the serving cell.
+ *
+ * Must be called after conn_mgr_init().
+ */
+int attach_hint_init(void);
+
+/**
+ * @brief Apply the hints of the last serving cell before an attach.
+ *
+ * Must be called while LTE is deactivated, right before conn_mgr_connect().
+ * Locks the modem to the band of the stored cell and selects its network,
+ * with automatic selection as fallback. If the modem is not registered
+ * within CONFIG_ATTACH_HINT_TIMEOUT, LTE is restarted with the hints
+ * removed.
+ *
+ * @retval 0 if hints were applied.
+ * @retval -ENOENT if no cell is known, the next attach does a full search.
+ */
+int attach_hint_apply(void);
+
+/** @brief Get the stored cell. */
+void attach_hint_cell_get(struct attach_hint_cell *cell);
+
+/** @brief Get the search time statistics. */
+void attach_hint_stats_get(struct attach_hint_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELLFUND_ATTACH_HINT_H_ */
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef CELLFUND_CELL_MEAS_H_
+#define CELLFUND_CELL_MEAS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Version in the first byte of an encoded record. */
+#define CELL_MEAS_RECORD_VERSION 1
+
+/** @brief Encoded length of a record with @p ncells neighbor cells. */
+#define CELL_MEAS_RECORD_LEN(ncells) (18 + 6 * (ncells))
+
+/** @brief Longest encoded record. */
+#define CELL_MEAS_RECORD_MAX_LEN CELL_MEAS_RECORD_LEN(CONFIG_CELL_MEAS_MAX_NCELLS)
+
+/** @brief RSRP of a cell that the modem could not measure. */
+#define CELL_MEAS_RSRP_UNKNOWN INT8_MIN
+
+/** @brief Neighbor cell. */
+struct cell_meas_ncell {
+	uint32_t earfcn;
+	uint16_t pci;
+	/** In dBm, or CELL_MEAS_RSRP_UNKNOWN. */
+	int8_t rsrp;
+};
+
+/** @brief Serving cell and the strongest neighbor cells. */
+struct cell_meas_record {
+	uint16_t mcc;
+	uint16_t mnc;
+	uint32_t cell_id;
+	uint16_t tac;
+	uint32_t earfcn;
+	uint16_t pci;
+	/** In dBm, or CELL_MEAS_RSRP_UNKNOWN. */
+	int8_t rsrp;
+	uint8_t ncell_count;
+	/** Sorted by RSRP, strongest first. */
+	struct cell_meas_ncell ncells[CONFIG_CELL_MEAS_MAX_NCELLS];
+};
+
+/** @brief Measurement statistics. */
+struct cell_meas_stats {
+	/** Completed measurements with a serving cell. */
+	uint32_t measurements;
+	/** Measurements that timed out or found no serving cell. */
+	uint32_t failures;
+	/** Measurements that matched a cached cell set. */
+	uint32_t duplicates;
+	/** Records added to the cache after an upload. */
+	uint32_t uploads;
+	/** Time from the request to the result, in ms. */
+	uint32_t meas_ms_total;
+};
+
+/**
+ * @brief Start receiving measurement results.
+ *
+ * Must be called after conn_mgr_init().
+ */
+int cell_meas_init(void);
+
+/**
+ * @brief Measure the serving and neighbor cells.
+ *
+ * Blocks for at most CONFIG_CELL_MEAS_TIMEOUT. LTE must be active.
+ *
+ * @retval 0 if @p record is filled and should be uploaded.
+ * @retval -EALREADY if @p record matches a cell set uploaded within
+ *         CONFIG_CELL_MEAS_CACHE_TTL. The record is still filled.
+ * @retval -ENOENT if the modem has no serving cell.
+ * @retval -ETIMEDOUT if no result arrived in time.
+ * @retval -EBUSY if a measurement is already running.
+ */
+int cell_meas_run(struct cell_meas_record *record);
+
+/**
+ * @brief Add an uploaded record to the cache of recent cell sets.
+ *
+ * The oldest entry is replaced when the cache is full.
+ */
+void cell_meas_cache_add(const struct cell_meas_record *record);
+
+/**
+ * @brief Encode a record in network byte order.
+ *
+ * The layout is the version and neighbor count (1 byte each), MCC and MNC
+ * (2 bytes each), cell ID (4 bytes), TAC (2 bytes), EARFCN (3 bytes), PCI
+ * (2 bytes) and RSRP in dBm (1 byte), followed by the EARFCN, PCI and RSRP
+ * of every neighbor cell.
+ *
+ * @return Encoded length, or -ENOMEM if @p buf is too short.
+ */
+int cell_meas_encode(const struct cell_meas_record *record, uint8_t *buf, size_t len);
+
+/** @brief Get the measurement statistics. */
+void cell_meas_stats_get(struct cell_meas_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELLFUND_CELL_MEAS_H_ */
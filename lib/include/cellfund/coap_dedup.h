@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef CELLFUND_COAP_DEDUP_H_
+#define CELLFUND_COAP_DEDUP_H_
+
+#include <stdint.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/coap.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Deduplication statistics. */
+struct coap_dedup_stats {
+	/** Confirmable and non-confirmable messages checked. */
+	uint32_t checked;
+	/** Messages that were already received. */
+	uint32_t duplicates;
+	/** Empty ACKs sent for new confirmable messages. */
+	uint32_t acks_sent;
+	/** Cached ACKs sent again for duplicates. */
+	uint32_t acks_replayed;
+	/** Entries replaced before they expired because the cache was full. */
+	uint32_t evicted;
+};
+
+/**
+ * @brief Check a received message and acknowledge it.
+ *
+ * Confirmable and non-confirmable messages are remembered by sender and
+ * message ID, for EXCHANGE_LIFETIME and NON_LIFETIME as in RFC 7252. A new
+ * confirmable message is acknowledged with an empty ACK. For a duplicate
+ * confirmable message the cached ACK is sent again. ACK and reset messages
+ * are not checked, they are matched to requests by the caller.
+ *
+ * @param sock Socket the message was received on, connected to @p src.
+ * @param src Sender of the message.
+ * @param msg Parsed message.
+ *
+ * @retval 0 if the message is new, or not checked, and should be processed.
+ * @retval -EALREADY if the message is a duplicate and should be ignored.
+ */
+int coap_dedup_rx(int sock, const struct sockaddr *src, const struct coap_packet *msg);
+
+/** @brief Get the deduplication statistics. */
+void coap_dedup_stats_get(struct coap_dedup_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELLFUND_COAP_DEDUP_H_ */
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef CELLFUND_COAP_EXCHANGE_H_
+#define CELLFUND_COAP_EXCHANGE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/coap.h>
+
+#include <cellfund/coap_rto.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief One confirmable request, from the first transmission to the response. */
+struct coap_exchange {
+	/** Retransmission timeout, retransmit with coap_rto_retransmit(). */
+	struct coap_rto_exchange rto;
+	/** Message ID of the request, matched by the ACK or reset. */
+	uint16_t id;
+	/** Token of the request, matched by the response. */
+	uint8_t token[COAP_TOKEN_MAX_LEN];
+	uint8_t token_len;
+	/** The request has been acknowledged and is not retransmitted any more. */
+	bool acked;
+};
+
+/** @brief What a received message is to the outstanding request. */
+enum coap_exchange_match {
+	/** Not for the request, ignore it. */
+	COAP_EXCHANGE_OTHER,
+	/** Empty ACK, stop retransmitting and wait for the separate response. */
+	COAP_EXCHANGE_ACKED,
+	/** The response, piggybacked on the ACK or separate. */
+	COAP_EXCHANGE_RESPONSE,
+	/** The server rejected the request with a reset. */
+	COAP_EXCHANGE_RESET,
+};
+
+/**
+ * @brief Start an exchange for @p request.
+ *
+ * Call just before the first transmission.
+ *
+ * @param ex Exchange to start.
+ * @param dst Destination, must stay valid until the exchange is done.
+ * @param request Confirmable request.
+ *
+ * @return Timeout for the first transmission, in ms.
+ */
+uint32_t coap_exchange_start(struct coap_exchange *ex, const struct sockaddr *dst,
+			     const struct coap_packet *request);
+
+/**
+ * @brief Match a received message to the request.
+ *
+ * The first ACK of the request, empty or with the response, finishes the
+ * round trip with coap_rto_done(). A separate response that arrives before
+ * any ACK gives no sample, as its round trip includes the time the server
+ * took. A confirmable separate response is acknowledged on @p sock, unless
+ * CONFIG_COAP_DEDUP is enabled and coap_dedup_rx() has already done so.
+ *
+ * @param ex Exchange.
+ * @param sock Socket the message was received on, connected to the server.
+ * @param msg Parsed message.
+ *
+ * @return What @p msg is to the request.
+ */
+enum coap_exchange_match coap_exchange_rx(struct coap_exchange *ex, int sock,
+					  const struct coap_packet *msg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELLFUND_COAP_EXCHANGE_H_ */
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef CELLFUND_COAP_RTO_H_
+#define CELLFUND_COAP_RTO_H_
+
+#include <stdint.h>
+#include <zephyr/net/socket.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief One confirmable exchange, from the first transmission to the ACK. */
+struct coap_rto_exchange {
+	/** Destination, must stay valid until the exchange is done. */
+	const struct sockaddr *dst;
+	/** First transmission, in ms of uptime. */
+	int64_t start;
+	/** Current retransmission timeout, in ms. */
+	uint32_t timeout_ms;
+	/** Backoff factor of this exchange, times two. */
+	uint8_t backoff_x2;
+	uint8_t retransmissions;
+};
+
+/** @brief Estimator state and counters of one destination. */
+struct coap_rto_stats {
+	/** Smoothed RTT and variance of exchanges without retransmissions. */
+	uint32_t strong_rtt_ms;
+	uint32_t strong_rttvar_ms;
+	/** Smoothed RTT and variance of exchanges with retransmissions. */
+	uint32_t weak_rtt_ms;
+	uint32_t weak_rttvar_ms;
+	/** Overall RTO the next exchange starts from. */
+	uint32_t rto_ms;
+	uint32_t strong_samples;
+	uint32_t weak_samples;
+	uint32_t retransmissions;
+	/** Exchanges that got no ACK after CONFIG_COAP_RTO_MAX_RETRANSMIT. */
+	uint32_t timeouts;
+};
+
+/**
+ * @brief Start an exchange with @p dst.
+ *
+ * Call just before the first transmission.
+ *
+ * @param ex Exchange to start.
+ * @param dst Destination.
+ *
+ * @return Timeout for the first transmission, in ms.
+ */
+uint32_t coap_rto_start(struct coap_rto_exchange *ex, const struct sockaddr *dst);
+
+/**
+ * @brief Back off after a timeout.
+ *
+ * Call when the timeout expires without an ACK, before retransmitting.
+ *
+ * @param ex Exchange.
+ *
+ * @return Timeout for the retransmission, in ms.
+ * @retval -ETIMEDOUT if the message has been retransmitted
+ *         CONFIG_COAP_RTO_MAX_RETRANSMIT times, the exchange has failed.
+ */
+int coap_rto_retransmit(struct coap_rto_exchange *ex);
+
+/**
+ * @brief Finish an exchange when its ACK or response is received.
+ *
+ * Updates the strong estimator if the message was not retransmitted, and the
+ * weak estimator if it was retransmitted once or twice. Later ACKs are
+ * ambiguous and not used.
+ *
+ * @param ex Exchange.
+ */
+void coap_rto_done(struct coap_rto_exchange *ex);
+
+/**
+ * @brief Get the estimator state and counters of @p dst.
+ *
+ * @retval 0 on success.
+ * @retval -ENOENT if there has been no exchange with @p dst.
+ */
+int coap_rto_stats_get(const struct sockaddr *dst, struct coap_rto_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELLFUND_COAP_RTO_H_ */
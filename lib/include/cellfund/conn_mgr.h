@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef CELLFUND_CONN_MGR_H_
+#define CELLFUND_CONN_MGR_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/kernel.h>
+#include <modem/lte_lc.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Connectivity events. */
+enum conn_mgr_evt_type {
+	/** Registered to a network. */
+	CONN_MGR_EVT_CONNECTED,
+	/** Registration lost or LTE deactivated. */
+	CONN_MGR_EVT_DISCONNECTED,
+	/** Not registered within the connect timeout, a retry is scheduled. */
+	CONN_MGR_EVT_CONNECT_TIMEOUT,
+	CONN_MGR_EVT_RRC_CONNECTED,
+	CONN_MGR_EVT_RRC_IDLE,
+	/** Needs CONFIG_LTE_LC_PSM_MODULE. */
+	CONN_MGR_EVT_PSM_UPDATE,
+	/** Needs CONFIG_LTE_LC_EDRX_MODULE. */
+	CONN_MGR_EVT_EDRX_UPDATE,
+	CONN_MGR_EVT_CELL_UPDATE,
+	CONN_MGR_EVT_LTE_MODE_UPDATE,
+	/** Modem sleep, needs CONFIG_LTE_LC_MODEM_SLEEP_MODULE and
+	 *  CONFIG_LTE_LC_MODEM_SLEEP_NOTIFICATIONS.
+	 */
+	CONN_MGR_EVT_MODEM_SLEEP_ENTER,
+	CONN_MGR_EVT_MODEM_SLEEP_EXIT,
+	/** Result of lte_lc_neighbor_cell_measurement(), needs
+	 *  CONFIG_LTE_LC_NEIGHBOR_CELL_MEAS_MODULE.
+	 */
+	CONN_MGR_EVT_NEIGHBOR_CELL_MEAS,
+};
+
+/** @brief Connectivity event. */
+struct conn_mgr_evt {
+	enum conn_mgr_evt_type type;
+	union {
+		/** CONN_MGR_EVT_CONNECTED: time from the connect request, in ms. */
+		uint32_t connect_ms;
+#if defined(CONFIG_LTE_LC_PSM_MODULE)
+		/** CONN_MGR_EVT_PSM_UPDATE */
+		struct lte_lc_psm_cfg psm_cfg;
+#endif
+#if defined(CONFIG_LTE_LC_EDRX_MODULE)
+		/** CONN_MGR_EVT_EDRX_UPDATE */
+		struct lte_lc_edrx_cfg edrx_cfg;
+#endif
+		/** CONN_MGR_EVT_CELL_UPDATE */
+		struct lte_lc_cell cell;
+		/** CONN_MGR_EVT_LTE_MODE_UPDATE */
+		enum lte_lc_lte_mode lte_mode;
+#if defined(CONFIG_LTE_LC_MODEM_SLEEP_MODULE)
+		/** CONN_MGR_EVT_MODEM_SLEEP_ENTER and CONN_MGR_EVT_MODEM_SLEEP_EXIT */
+		struct lte_lc_modem_sleep modem_sleep;
+#endif
+#if defined(CONFIG_LTE_LC_NEIGHBOR_CELL_MEAS_MODULE)
+		/** CONN_MGR_EVT_NEIGHBOR_CELL_MEAS: the neighbor cells are only
+		 *  valid during the handler call.
+		 */
+		struct lte_lc_cells_info cells_info;
+#endif
+	};
+};
+
+/**
+ * @brief Event handler.
+ *
+ * Called from the LTE link controller's context or the system work queue,
+ * so it must not block.
+ */
+typedef void (*conn_mgr_handler_t)(const struct conn_mgr_evt *evt);
+
+/** @brief Link state, as last reported by the modem. */
+struct conn_mgr_state {
+	/** Between conn_mgr_connect() and conn_mgr_disconnect(). */
+	bool requested;
+	bool registered;
+	bool roaming;
+	bool rrc_connected;
+	/** Between modem sleep enter and exit notifications, always false
+	 *  without CONFIG_LTE_LC_MODEM_SLEEP_MODULE.
+	 */
+	bool modem_asleep;
+	enum lte_lc_lte_mode lte_mode;
+#if defined(CONFIG_LTE_LC_PSM_MODULE)
+	/** Negotiated PSM timers, active time is -1 if PSM is not granted. */
+	struct lte_lc_psm_cfg psm_cfg;
+#endif
+#if defined(CONFIG_LTE_LC_EDRX_MODULE)
+	/** Negotiated eDRX timers. */
+	struct lte_lc_edrx_cfg edrx_cfg;
+#endif
+	/** Serving cell. Only the cell ID and tracking area code are set. */
+	struct lte_lc_cell cell;
+};
+
+/** @brief Connection statistics. */
+struct conn_mgr_stats {
+	/** Connect requests and automatic retries. */
+	uint32_t attempts;
+	/** Successful registrations. */
+	uint32_t registrations;
+	/** Attempts that timed out. */
+	uint32_t timeouts;
+	/** Registrations lost while a connection was requested. */
+	uint32_t drops;
+	/** Time from a connect request to registration, in ms. */
+	uint32_t connect_ms_last;
+	uint32_t connect_ms_min;
+	uint32_t connect_ms_max;
+	uint32_t connect_ms_total;
+	/** Time spent registered and in RRC connected mode, in ms. */
+	uint64_t registered_ms_total;
+	uint64_t rrc_connected_ms_total;
+};
+
+/**
+ * @brief Initialize the modem library and start tracking the link.
+ *
+ * Credentials and timers that must be set while the modem is offline can be
+ * written between this call and conn_mgr_connect().
+ */
+int conn_mgr_init(void);
+
+/**
+ * @brief Subscribe to connectivity events.
+ *
+ * @retval 0 on success.
+ * @retval -ENOMEM if CONFIG_CONN_MGR_MAX_SUBSCRIBERS handlers are subscribed.
+ */
+int conn_mgr_subscribe(conn_mgr_handler_t handler);
+
+/** @brief Remove a subscribed handler. */
+void conn_mgr_unsubscribe(conn_mgr_handler_t handler);
+
+/**
+ * @brief Start connecting to LTE, without waiting for registration.
+ *
+ * If the modem is not registered within @p timeout, LTE is deactivated and
+ * the attempt is repeated with an exponential backoff until it succeeds or
+ * conn_mgr_disconnect() is called. The same applies if registration is lost
+ * later.
+ *
+ * @param timeout Time to wait for registration in each attempt, or K_FOREVER
+ *                to leave the modem searching.
+ */
+int conn_mgr_connect(k_timeout_t timeout);
+
+/**
+ * @brief Wait until the modem is registered.
+ *
+ * @retval 0 if registered.
+ * @retval -ETIMEDOUT if not registered within @p timeout.
+ */
+int conn_mgr_wait_connected(k_timeout_t timeout);
+
+/**
+ * @brief Deactivate LTE and stop retrying.
+ *
+ * GNSS is left as it is.
+ */
+int conn_mgr_disconnect(void);
+
+/** @brief Get the current link state. */
+void conn_mgr_state_get(struct conn_mgr_state *state);
+
+/** @brief Get the connection statistics. */
+void conn_mgr_stats_get(struct conn_mgr_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELLFUND_CONN_MGR_H_ */
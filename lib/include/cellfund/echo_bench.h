@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef CELLFUND_ECHO_BENCH_H_
+#define CELLFUND_ECHO_BENCH_H_
+
+#include <stdint.h>
+#include <zephyr/net/socket.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Result of one benchmark run. */
+struct echo_bench_result {
+	/** Datagrams sent. */
+	uint32_t sent;
+	/** Datagrams that could not be sent. */
+	uint32_t send_errors;
+	/** Datagrams echoed, without duplicates. */
+	uint32_t received;
+	/** Datagrams not echoed before CONFIG_ECHO_BENCH_TIMEOUT_MS. */
+	uint32_t lost;
+	uint32_t duplicates;
+	/** Echoes that arrived after an echo of a later datagram. */
+	uint32_t reordered;
+	/** Echoes that do not match a sent datagram. */
+	uint32_t invalid;
+	/** Round-trip times, in microseconds. */
+	uint32_t rtt_us_min;
+	uint32_t rtt_us_p50;
+	uint32_t rtt_us_p90;
+	uint32_t rtt_us_p99;
+	uint32_t rtt_us_max;
+	/** Echoed bits per second, from the first send to the last echo. */
+	uint32_t goodput_bps;
+	/** Time from the first send to the last echo, in ms. */
+	uint32_t duration_ms;
+};
+
+/**
+ * @brief Start a benchmark run in the benchmark thread.
+ *
+ * The run uses its own socket, so the application can keep receiving on
+ * its socket. The result is logged when the run ends.
+ *
+ * @param addr Address of the echo server. Ignored if
+ *             CONFIG_ECHO_BENCH_HOSTNAME is set.
+ * @param addrlen Length of @p addr.
+ *
+ * @retval 0 on success.
+ * @retval -EBUSY if a run is in progress.
+ * @retval -EINVAL if @p addrlen is too long.
+ */
+int echo_bench_start(const struct sockaddr *addr, socklen_t addrlen);
+
+/**
+ * @brief Get the result of the last finished run.
+ *
+ * @retval 0 on success.
+ * @retval -ENODATA if no run has finished yet.
+ */
+int echo_bench_result_get(struct echo_bench_result *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELLFUND_ECHO_BENCH_H_ */
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef CELLFUND_FIXFMT_H_
+#define CELLFUND_FIXFMT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <nrf_modem_gnss.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Buffer size for any degree value, "-180.000000". */
+#define FIXFMT_DEG_LEN 12
+
+/** Buffer size for an ISO 8601 timestamp, "2026-01-01T00:00:00.000Z". */
+#define FIXFMT_ISO8601_LEN 25
+
+/**
+ * @brief Convert degrees to 1e-7 degrees, rounding to nearest.
+ *
+ * Works with soft-float, so callers do not need an FPU.
+ */
+static inline int32_t fixfmt_deg_to_e7(double deg)
+{
+	return (int32_t)(deg * 1e7 + (deg < 0 ? -0.5 : 0.5));
+}
+
+/**
+ * @brief Format a fixed-point value.
+ *
+ * All functions null-terminate the output.
+ *
+ * @param buf Output buffer.
+ * @param len Size of the output buffer.
+ * @param val Value, scaled by 10^@p decimals.
+ * @param decimals Number of decimals, at most 9.
+ *
+ * @return Length of the output, without the terminating null, on success.
+ * @retval -ENOMEM if the output does not fit.
+ */
+int fixfmt_fixed(char *buf, size_t len, int64_t val, unsigned int decimals);
+
+/** @brief Format 1e-7 degrees as degrees with 6 decimals, rounding to nearest. */
+int fixfmt_deg_e7(char *buf, size_t len, int32_t deg_e7);
+
+/** @brief Format millimetres as metres with 1 decimal, rounding to nearest. */
+int fixfmt_mm(char *buf, size_t len, int64_t mm);
+
+/** @brief Format a GNSS date and time as an ISO 8601 UTC timestamp. */
+int fixfmt_iso8601(char *buf, size_t len, const struct nrf_modem_gnss_datetime *dt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELLFUND_FIXFMT_H_ */
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef CELLFUND_GEO_H_
+#define CELLFUND_GEO_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Millimetres per 1e-7 degrees of latitude (11.132 mm), Q16. */
+#define GEO_LAT_SCALE_Q16 729547
+
+/**
+ * @brief Local flat-earth projection around an origin.
+ *
+ * Good to within a fraction of a percent for distances up to a few hundred
+ * kilometres from the origin.
+ */
+struct geo_frame {
+	/** Origin, in 1e-7 degrees. */
+	int32_t lat0_e7;
+	int32_t lon0_e7;
+	/** Millimetres per 1e-7 degrees of longitude at the origin, Q16. */
+	int32_t lon_scale_q16;
+};
+
+/** @brief Sine of an angle in 0.1 degrees, Q15. */
+int32_t geo_sin_q15(int32_t deci_deg);
+
+/** @brief Cosine of an angle in 0.1 degrees, Q15. */
+int32_t geo_cos_q15(int32_t deci_deg);
+
+/** @brief Integer square root. */
+uint32_t geo_isqrt64(uint64_t val);
+
+/** @brief Wrap a longitude in 1e-7 degrees to [-180, 180] degrees. */
+int32_t geo_lon_wrap(int64_t lon_e7);
+
+/** @brief Set up a projection with the origin at the given point. */
+void geo_frame_init(struct geo_frame *frame, int32_t lat_e7, int32_t lon_e7);
+
+/** @brief Project a point to millimetres north and east of the origin. */
+void geo_to_local(const struct geo_frame *frame, int32_t lat_e7, int32_t lon_e7,
+		  int64_t *north_mm, int64_t *east_mm);
+
+/** @brief Convert millimetres north and east of the origin back to a point. */
+void geo_from_local(const struct geo_frame *frame, int64_t north_mm, int64_t east_mm,
+		    int32_t *lat_e7, int32_t *lon_e7);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELLFUND_GEO_H_ */
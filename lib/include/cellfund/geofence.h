@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef CELLFUND_GEOFENCE_H_
+#define CELLFUND_GEOFENCE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Geofence shape. */
+enum geofence_type {
+	GEOFENCE_CIRCLE,
+	GEOFENCE_POLYGON,
+};
+
+/** @brief Polygon vertex. */
+struct geofence_vertex {
+	/** Latitude, in 1e-7 degrees. */
+	int32_t lat_e7;
+	/** Longitude, in 1e-7 degrees. */
+	int32_t lon_e7;
+};
+
+/**
+ * @brief Geofence.
+ *
+ * Fences are meant to be defined as const, so they stay in flash. Fences may
+ * not cross the antimeridian.
+ */
+struct geofence {
+	const char *name;
+	enum geofence_type type;
+	union {
+		struct {
+			/** Centre, in 1e-7 degrees. */
+			int32_t lat_e7;
+			int32_t lon_e7;
+			/** Radius, in metres. */
+			uint32_t radius_m;
+		} circle;
+		struct {
+			/** Vertices, in order. The polygon is closed implicitly. */
+			const struct geofence_vertex *vertices;
+			size_t count;
+		} polygon;
+	};
+};
+
+/** @brief Define a circle fence. */
+#define GEOFENCE_CIRCLE_INIT(_name, _lat_e7, _lon_e7, _radius_m)		\
+	{									\
+		.name = _name,							\
+		.type = GEOFENCE_CIRCLE,					\
+		.circle = { .lat_e7 = _lat_e7, .lon_e7 = _lon_e7,		\
+			    .radius_m = _radius_m },				\
+	}
+
+/** @brief Define a polygon fence from an array of vertices. */
+#define GEOFENCE_POLYGON_INIT(_name, _vertices)				\
+	{									\
+		.name = _name,							\
+		.type = GEOFENCE_POLYGON,					\
+		.polygon = { .vertices = _vertices,				\
+			     .count = ARRAY_SIZE(_vertices) },			\
+	}
+
+/** @brief Geofence event type. */
+enum geofence_evt_type {
+	GEOFENCE_EVT_ENTER,
+	GEOFENCE_EVT_EXIT,
+};
+
+/** @brief Geofence event. */
+struct geofence_evt {
+	enum geofence_evt_type type;
+	/** Index of the fence in the table passed to geofence_init(). */
+	uint16_t idx;
+	const struct geofence *fence;
+};
+
+/** @brief Geofence event handler, called from geofence_update(). */
+typedef void (*geofence_handler_t)(const struct geofence_evt *evt);
+
+/**
+ * @brief Index a table of fences.
+ *
+ * All positions are considered outside of all fences until the first update.
+ *
+ * @param fences Fences. Must stay valid while the library is used.
+ * @param count Number of fences, at most CONFIG_GEOFENCE_MAX_FENCES.
+ * @param handler Event handler, may be NULL.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if a fence is invalid or there are too many fences.
+ * @retval -ENOMEM if the index has too few entries, see
+ *         CONFIG_GEOFENCE_INDEX_ENTRIES.
+ */
+int geofence_init(const struct geofence *fences, size_t count, geofence_handler_t handler);
+
+/**
+ * @brief Evaluate a new position.
+ *
+ * Raises an event for every fence that was entered or left since the
+ * previous position.
+ *
+ * @return Number of events raised.
+ */
+int geofence_update(int32_t lat_e7, int32_t lon_e7);
+
+/** @brief Whether the latest position is inside any fence. */
+bool geofence_inside_any(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELLFUND_GEOFENCE_H_ */
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef CELLFUND_GNSS_PIPELINE_H_
+#define CELLFUND_GNSS_PIPELINE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <nrf_modem_gnss.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief GNSS event as delivered to the processing thread. */
+struct gnss_pipeline_evt {
+	/** GNSS event ID, one of NRF_MODEM_GNSS_EVT_*. */
+	int id;
+	/** True if @ref pvt was read from the modem when the event was raised. */
+	bool has_pvt;
+	/** PVT frame copied in the modem library's interrupt context. */
+	struct nrf_modem_gnss_pvt_data_frame pvt;
+};
+
+/** @brief Pipeline counters. */
+struct gnss_pipeline_stats {
+	/** Events raised by the modem library. */
+	uint32_t events;
+	/** Events handed to the application handler. */
+	uint32_t processed;
+	/** Events dropped because the ring was full. */
+	uint32_t dropped;
+	/** PVT frames skipped because a newer event was already queued. */
+	uint32_t coalesced;
+	/** Failed nrf_modem_gnss_read() calls. */
+	uint32_t read_errors;
+	/** Highest number of events waiting in the ring. */
+	uint32_t max_depth;
+	/** Time spent in the application handler, in microseconds. */
+	uint32_t handler_us_total;
+	/** Longest time spent in the application handler for one event, in microseconds. */
+	uint32_t handler_us_max;
+};
+
+/**
+ * @brief GNSS event handler, called from the pipeline thread.
+ *
+ * The event is only valid for the duration of the call.
+ */
+typedef void (*gnss_pipeline_handler_t)(const struct gnss_pipeline_evt *evt);
+
+/**
+ * @brief Register @p handler and install the pipeline as GNSS event handler.
+ *
+ * Replaces nrf_modem_gnss_event_handler_set() in the application.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if @p handler is NULL.
+ * @return Other negative values are errors from the modem library.
+ */
+int gnss_pipeline_init(gnss_pipeline_handler_t handler);
+
+/** @brief Get a snapshot of the pipeline counters. */
+void gnss_pipeline_stats_get(struct gnss_pipeline_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELLFUND_GNSS_PIPELINE_H_ */
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef CELLFUND_LTE_TIMER_H_
+#define CELLFUND_LTE_TIMER_H_
+
+#include <stdint.h>
+#include <modem/lte_lc.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Size of an encoded PSM timer, a string of 8 bits. */
+#define LTE_TIMER_PSM_BITS_LEN 9
+
+/** Size of an encoded eDRX cycle or paging time window, a string of 4 bits. */
+#define LTE_TIMER_EDRX_BITS_LEN 5
+
+/**
+ * @brief Encode a periodic TAU (T3412 extended, GPRS timer 3).
+ *
+ * @param seconds Requested value.
+ * @param bits Encoded value.
+ * @param actual Value that was encoded, in seconds. May be NULL.
+ */
+void lte_timer_tau_encode(uint32_t seconds, char bits[LTE_TIMER_PSM_BITS_LEN],
+			  uint32_t *actual);
+
+/**
+ * @brief Encode an active time (T3324, GPRS timer 2).
+ *
+ * @param seconds Requested value.
+ * @param bits Encoded value.
+ * @param actual Value that was encoded, in seconds. May be NULL.
+ */
+void lte_timer_active_time_encode(uint32_t seconds, char bits[LTE_TIMER_PSM_BITS_LEN],
+				  uint32_t *actual);
+
+/**
+ * @brief Encode an eDRX cycle.
+ *
+ * @param mode LTE_LC_LTE_MODE_LTEM or LTE_LC_LTE_MODE_NBIOT.
+ * @param ms Requested value.
+ * @param bits Encoded value.
+ * @param actual Value that was encoded, in ms. May be NULL.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if the mode is invalid.
+ */
+int lte_timer_edrx_encode(enum lte_lc_lte_mode mode, uint32_t ms,
+			  char bits[LTE_TIMER_EDRX_BITS_LEN], uint32_t *actual);
+
+/**
+ * @brief Encode a paging time window.
+ *
+ * @param mode LTE_LC_LTE_MODE_LTEM or LTE_LC_LTE_MODE_NBIOT.
+ * @param ms Requested value.
+ * @param bits Encoded value.
+ * @param actual Value that was encoded, in ms. May be NULL.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if the mode is invalid.
+ */
+int lte_timer_ptw_encode(enum lte_lc_lte_mode mode, uint32_t ms,
+			 char bits[LTE_TIMER_EDRX_BITS_LEN], uint32_t *actual);
+
+#if defined(CONFIG_LTE_LC_PSM_MODULE)
+/**
+ * @brief Request PSM with the given timers.
+ *
+ * Can be called at any time. When registered, the new values are
+ * negotiated with the network right away.
+ *
+ * @param tau Periodic TAU, in seconds.
+ * @param active_time Active time, in seconds.
+ *
+ * @return 0 on success, or a negative error code.
+ */
+int lte_timer_psm_set(uint32_t tau, uint32_t active_time);
+#endif
+
+#if defined(CONFIG_LTE_LC_EDRX_MODULE)
+/**
+ * @brief Request eDRX with the given timers.
+ *
+ * Can be called at any time. When registered, the new values are
+ * negotiated with the network right away.
+ *
+ * @param mode LTE_LC_LTE_MODE_LTEM or LTE_LC_LTE_MODE_NBIOT.
+ * @param edrx eDRX cycle, in ms.
+ * @param ptw Paging time window, in ms.
+ *
+ * @return 0 on success, or a negative error code.
+ */
+int lte_timer_edrx_set(enum lte_lc_lte_mode mode, uint32_t edrx, uint32_t ptw);
+#endif
+
+/**
+ * @brief Set the timers configured with Kconfig.
+ *
+ * Call before lte_lc_psm_req() and lte_lc_edrx_req(). Only sets the
+ * parameters, it does not request PSM or eDRX.
+ */
+int lte_timer_init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELLFUND_LTE_TIMER_H_ */
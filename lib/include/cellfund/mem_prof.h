@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef CELLFUND_MEM_PROF_H_
+#define CELLFUND_MEM_PROF_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Longest thread name kept, including the terminator. */
+#define MEM_PROF_NAME_LEN 24
+
+/** @brief High-water mark of a thread stack or a heap. */
+struct mem_prof_usage {
+	/** Thread or heap name. */
+	char name[MEM_PROF_NAME_LEN];
+	/** Kconfig option that sets the size, or NULL if not known. */
+	const char *kconfig;
+	/** Size, in bytes. */
+	size_t size;
+	/** Highest usage seen, in bytes. */
+	size_t peak;
+	/** The peak has exceeded the budget. */
+	bool over_budget;
+};
+
+/**
+ * @brief Sample all stacks and heaps now.
+ *
+ * Also done every CONFIG_MEM_PROF_INTERVAL seconds.
+ *
+ * @return Number of stacks and heaps over budget.
+ */
+int mem_prof_sample(void);
+
+/**
+ * @brief Get a thread stack by index, in the order threads were first seen.
+ *
+ * @retval 0 on success.
+ * @retval -ENOENT if @p idx is past the last thread.
+ */
+int mem_prof_stack_get(size_t idx, struct mem_prof_usage *usage);
+
+/**
+ * @brief Get a heap by index.
+ *
+ * The size is 0 if the heap could not be read yet.
+ *
+ * @retval 0 on success.
+ * @retval -ENOENT if @p idx is past the last heap.
+ */
+int mem_prof_heap_get(size_t idx, struct mem_prof_usage *usage);
+
+/** @brief Size for a peak usage, with CONFIG_MEM_PROF_MARGIN added. */
+size_t mem_prof_suggest(size_t peak);
+
+/** @brief Log every stack and heap with its suggested size. */
+void mem_prof_report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELLFUND_MEM_PROF_H_ */
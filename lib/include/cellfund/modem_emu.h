@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef CELLFUND_MODEM_EMU_H_
+#define CELLFUND_MODEM_EMU_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <modem/lte_lc.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief State of the emulated modem and network. */
+struct modem_emu_state {
+	/** LTE is activated. */
+	bool active;
+	/** The network has coverage. */
+	bool coverage;
+	bool registered;
+	bool rrc_connected;
+	/** The modem is in PSM. */
+	bool asleep;
+	enum lte_lc_lte_mode lte_mode;
+	/** Serving cell. */
+	struct lte_lc_cell cell;
+	/** Band of the serving cell. */
+	uint8_t band;
+	/** Signal to noise ratio, in dB. */
+	int8_t snr_db;
+	/** Granted periodic TAU, in seconds, -1 if PSM is not granted. */
+	int32_t psm_tau;
+	/** Granted active time, in seconds, -1 if PSM is not granted. */
+	int32_t psm_active_time;
+};
+
+/** @brief Emulator statistics. */
+struct modem_emu_stats {
+	uint32_t attaches;
+	/** Attaches that failed because of CONFIG_MODEM_EMU_ATTACH_FAILURES. */
+	uint32_t attach_failures;
+	uint32_t rrc_connections;
+	uint32_t psm_entries;
+	uint32_t cell_changes;
+};
+
+/**
+ * @brief Run one emulator command.
+ *
+ * The commands are the ones of the @c modem_emu shell command and of
+ * CONFIG_MODEM_EMU_SCRIPT:
+ *
+ * - @c coverage @c on|off: gain or lose coverage.
+ * - @c rrc @c connected|idle: change the RRC mode.
+ * - @c cell @c <id> @c <tac>: move to another serving cell.
+ * - @c signal @c <rsrp_dbm> @c <snr_db>: change the link quality.
+ * - @c sleep and @c wake: enter or leave PSM.
+ * - @c button @c <n>: press and release DK button @c n, starting from 1.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if the command is not valid.
+ * @retval -ENOTSUP if the command needs a feature that is not enabled.
+ */
+int modem_emu_exec(const char *cmd);
+
+/** @brief Get the state of the emulated modem and network. */
+void modem_emu_state_get(struct modem_emu_state *state);
+
+/** @brief Get the emulator statistics. */
+void modem_emu_stats_get(struct modem_emu_stats *stats);
+
+/**
+ * @brief Press and release a DK button.
+ *
+ * @param button Button number, starting from 1.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if the button does not exist.
+ * @retval -ENOTSUP if CONFIG_MODEM_EMU_DK is disabled.
+ */
+int modem_emu_button_press(uint8_t button);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELLFUND_MODEM_EMU_H_ */
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef CELLFUND_POS_FILTER_H_
+#define CELLFUND_POS_FILTER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <nrf_modem_gnss.h>
+#include <cellfund/geo.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Constant-velocity Kalman filter state for one axis, in mm and mm/s. */
+struct pos_filter_axis {
+	int64_t pos;
+	int64_t vel;
+	/* Covariance, in mm^2, mm^2/s and mm^2/s^2. */
+	int64_t p00;
+	int64_t p01;
+	int64_t p11;
+};
+
+/**
+ * @brief Position filter.
+ *
+ * Positions are filtered in millimetres north and east of an origin that is
+ * set at the first fix, so all filter arithmetic is done in integers.
+ */
+struct pos_filter {
+	bool valid;
+	/* GNSS time of the latest update, in ms. */
+	int64_t time_ms;
+	struct geo_frame frame;
+	struct pos_filter_axis north;
+	struct pos_filter_axis east;
+};
+
+/** @brief Filtered position. */
+struct pos_filter_output {
+	/** Latitude, in 1e-7 degrees. */
+	int32_t lat_e7;
+	/** Longitude, in 1e-7 degrees. */
+	int32_t lon_e7;
+	/** Estimated horizontal accuracy (1-sigma), in mm. */
+	uint32_t accuracy_mm;
+	/** Velocity north, in mm/s. */
+	int32_t vel_north_mm_s;
+	/** Velocity east, in mm/s. */
+	int32_t vel_east_mm_s;
+};
+
+/** @brief Reset the filter, the next update restarts it from the measurement. */
+void pos_filter_reset(struct pos_filter *filter);
+
+/**
+ * @brief Feed a PVT frame to the filter.
+ *
+ * Position, velocity and their accuracies are taken from the frame. The filter
+ * restarts from the measurement after a gap longer than
+ * CONFIG_POS_FILTER_MAX_GAP, or if the fix is too far from the origin.
+ *
+ * @param filter Filter.
+ * @param pvt PVT frame with a valid fix.
+ * @param out Filtered position.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if the frame has no valid fix.
+ */
+int pos_filter_update(struct pos_filter *filter,
+		      const struct nrf_modem_gnss_pvt_data_frame *pvt,
+		      struct pos_filter_output *out);
+
+/**
+ * @brief Replace position and accuracy in a PVT frame with the filtered values.
+ *
+ * Lets applications that work on PVT frames use the filter in place.
+ */
+void pos_filter_output_to_pvt(const struct pos_filter_output *out,
+			      struct nrf_modem_gnss_pvt_data_frame *pvt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELLFUND_POS_FILTER_H_ */
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef CELLFUND_PVT_RECORDING_H_
+#define CELLFUND_PVT_RECORDING_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <nrf_modem_gnss.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * A PVT recording is a header followed by entries, all little-endian. Entries
+ * embed struct nrf_modem_gnss_pvt_data_frame as laid out by the modem library
+ * that made the recording, so the header carries the entry size to catch
+ * recordings from an incompatible version.
+ */
+
+/** "PVTR" */
+#define PVT_RECORDING_MAGIC 0x52545650
+#define PVT_RECORDING_VERSION 1
+
+/** @brief Recording header. */
+struct pvt_recording_header {
+	uint32_t magic;
+	uint16_t version;
+	/** Size of struct pvt_recording_entry. */
+	uint16_t entry_size;
+};
+
+/** @brief One recorded GNSS event. */
+struct pvt_recording_entry {
+	/** Time since the start of the recording, in milliseconds. */
+	uint32_t time_ms;
+	/** GNSS event ID, one of NRF_MODEM_GNSS_EVT_*. */
+	int16_t event;
+	/** 1 if @ref pvt is valid. */
+	uint8_t has_pvt;
+	uint8_t reserved;
+	struct nrf_modem_gnss_pvt_data_frame pvt;
+};
+
+/**
+ * @brief Record one GNSS event.
+ *
+ * The entry is streamed over the console as "PVTREC" lines, which
+ * pvt_rec.py turns back into a recording file.
+ *
+ * @param event GNSS event ID.
+ * @param pvt PVT frame read for the event, or NULL.
+ */
+void pvt_record_add(int event, const struct nrf_modem_gnss_pvt_data_frame *pvt);
+
+/**
+ * @brief Replay @p data instead of CONFIG_PVT_REPLAY_FILE.
+ *
+ * Stops a running replay. The new recording is replayed from the next
+ * nrf_modem_gnss_start() and must stay valid while it is replayed.
+ *
+ * @param data Recording, a header followed by entries.
+ * @param len Size of @p data in bytes.
+ */
+void pvt_replay_recording_set(const void *data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELLFUND_PVT_RECORDING_H_ */
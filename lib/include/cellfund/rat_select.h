@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef CELLFUND_RAT_SELECT_H_
+#define CELLFUND_RAT_SELECT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Radio access technologies. */
+enum rat_select_rat {
+	RAT_SELECT_LTEM,
+	RAT_SELECT_NBIOT,
+	RAT_SELECT_RAT_COUNT,
+};
+
+/** @brief Statistics of one technology on one network. */
+struct rat_select_stats {
+	/** Number of exchanges measured. */
+	uint16_t samples;
+	/** Number of attaches measured. */
+	uint16_t attaches;
+	/** Rolling averages. */
+	uint32_t attach_ms;
+	uint32_t rtt_ms;
+	/** Goodput, in bytes per second. */
+	uint32_t goodput;
+};
+
+/**
+ * @brief Initialize the library and load persisted statistics.
+ *
+ * Must be called after the modem library is initialized and before the
+ * first rat_select_apply().
+ */
+int rat_select_init(void);
+
+/**
+ * @brief Set the system mode preference before LTE is activated.
+ *
+ * Picks a technology for the last network the modem was registered to,
+ * and starts measuring the attach time. The technologies enabled in the
+ * system mode are left as they are, only the preference is changed.
+ */
+int rat_select_apply(void);
+
+/**
+ * @brief Report a completed exchange.
+ *
+ * Updates the statistics of the current network and technology, and
+ * persists them.
+ *
+ * @param bytes Bytes sent and received.
+ * @param rtt_ms Time from sending the request to receiving the response.
+ */
+void rat_select_exchange_done(size_t bytes, uint32_t rtt_ms);
+
+/**
+ * @brief Get the statistics of a technology on the current network.
+ *
+ * @retval 0 on success.
+ * @retval -ENOENT if the network is not known yet.
+ */
+int rat_select_stats_get(enum rat_select_rat rat, struct rat_select_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELLFUND_RAT_SELECT_H_ */
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef CELLFUND_REACTOR_H_
+#define CELLFUND_REACTOR_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/sys/slist.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Called from the reactor thread when a file descriptor is ready.
+ *
+ * @param fd File descriptor.
+ * @param revents Returned poll events, ZSOCK_POLLIN, ZSOCK_POLLERR and so on.
+ * @param user_data User data given to reactor_fd_add().
+ */
+typedef void (*reactor_fd_cb_t)(int fd, short revents, void *user_data);
+
+struct reactor_timer;
+
+/** @brief Called from the reactor thread when a timer expires. */
+typedef void (*reactor_timer_cb_t)(struct reactor_timer *timer);
+
+/** @brief One-shot timer run by the reactor. Initialize with reactor_timer_init(). */
+struct reactor_timer {
+	sys_snode_t node;
+	int64_t expiry;
+	reactor_timer_cb_t cb;
+	bool active;
+};
+
+struct reactor_event;
+
+/**
+ * @brief Called from the reactor thread when an event was signalled.
+ *
+ * @param event The event.
+ * @param count Times the event was signalled since the last callback.
+ */
+typedef void (*reactor_event_cb_t)(struct reactor_event *event, uint64_t count);
+
+/** @brief Event that other threads signal to the reactor, backed by an eventfd. */
+struct reactor_event {
+	int fd;
+	reactor_event_cb_t cb;
+};
+
+/** @brief Reactor statistics. */
+struct reactor_stats {
+	/** Calls to zsock_poll(). */
+	uint32_t polls;
+	/** File descriptor callbacks, including events. */
+	uint32_t fd_callbacks;
+	/** Timer callbacks. */
+	uint32_t timer_callbacks;
+	/** Longest callback, in ms. Everything else waits for it. */
+	uint32_t callback_ms_max;
+};
+
+/**
+ * @brief Add a file descriptor, usually a socket.
+ *
+ * Can be called from any thread.
+ *
+ * @param fd File descriptor.
+ * @param events Poll events to wait for, usually ZSOCK_POLLIN.
+ * @param cb Called when @p fd is ready. Errors and hangups are always
+ *           reported, the callback should remove @p fd if it closes it.
+ * @param user_data Passed to @p cb.
+ *
+ * @retval 0 on success.
+ * @retval -EALREADY if @p fd was already added.
+ * @retval -ENOMEM if CONFIG_REACTOR_MAX_FDS are already added.
+ */
+int reactor_fd_add(int fd, short events, reactor_fd_cb_t cb, void *user_data);
+
+/**
+ * @brief Remove a file descriptor. It is not closed.
+ *
+ * @retval 0 on success.
+ * @retval -ENOENT if @p fd was not added.
+ */
+int reactor_fd_remove(int fd);
+
+/** @brief Initialize a timer. */
+void reactor_timer_init(struct reactor_timer *timer, reactor_timer_cb_t cb);
+
+/**
+ * @brief Start a timer, or restart it if it is running.
+ *
+ * Can be called from any thread.
+ *
+ * @param timer Timer.
+ * @param delay_ms Time until the callback is called.
+ */
+void reactor_timer_start(struct reactor_timer *timer, uint32_t delay_ms);
+
+/** @brief Stop a timer. Does nothing if it is not running. */
+void reactor_timer_stop(struct reactor_timer *timer);
+
+/**
+ * @brief Create an event and add its eventfd to the reactor.
+ *
+ * @retval 0 on success.
+ * @retval -ENOMEM if there is no free eventfd or reactor slot.
+ */
+int reactor_event_init(struct reactor_event *event, reactor_event_cb_t cb);
+
+/**
+ * @brief Signal an event, from any thread.
+ *
+ * Signals are counted until the callback runs.
+ */
+int reactor_event_signal(struct reactor_event *event);
+
+/**
+ * @brief Run the reactor on the calling thread.
+ *
+ * Waits with zsock_poll() for all file descriptors and the nearest timer,
+ * and calls the callbacks one at a time. Callbacks must not block.
+ *
+ * @retval 0 when reactor_stop() was called.
+ * @retval -errno if zsock_poll() failed.
+ */
+int reactor_run(void);
+
+/** @brief Make reactor_run() return, from any thread or callback. */
+void reactor_stop(void);
+
+/** @brief Get the reactor statistics. */
+void reactor_stats_get(struct reactor_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELLFUND_REACTOR_H_ */
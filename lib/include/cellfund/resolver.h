@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef CELLFUND_RESOLVER_H_
+#define CELLFUND_RESOLVER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/net/socket.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Address families of the default PDN. */
+struct resolver_pdn {
+	bool ipv4;
+	bool ipv6;
+	/** The IPv4 address is private or in the shared CGNAT range. */
+	bool ipv4_nat;
+};
+
+/** @brief Statistics of one address family. */
+struct resolver_family_stats {
+	/** Lookups that picked an address of this family. */
+	uint32_t lookups;
+	/** Round-trip times reported with resolver_rtt_add(), in ms. */
+	uint32_t rtt_count;
+	uint32_t rtt_ms_min;
+	uint32_t rtt_ms_max;
+	uint32_t rtt_ms_total;
+};
+
+/**
+ * @brief Resolve a hostname to one address, following the family policy.
+ *
+ * @param host Hostname.
+ * @param port Port, in host byte order.
+ * @param socktype SOCK_DGRAM or SOCK_STREAM.
+ * @param addr Resolved address, to be passed to zsock_connect().
+ * @param addrlen Length of @p addr for its family.
+ *
+ * @retval 0 on success.
+ * @retval -EIO if the lookup failed.
+ * @retval -ENOENT if no address of an allowed family was found.
+ */
+int resolver_lookup(const char *host, uint16_t port, int socktype,
+		    struct sockaddr_storage *addr, socklen_t *addrlen);
+
+/**
+ * @brief Get the address families of the default PDN.
+ *
+ * @retval 0 on success.
+ * @retval -ENOTCONN if the PDN has no address.
+ */
+int resolver_pdn_get(struct resolver_pdn *pdn);
+
+/** @brief Add a round-trip time to the statistics of @p family. */
+void resolver_rtt_add(int family, uint32_t rtt_ms);
+
+/**
+ * @brief Get the statistics of @p family.
+ *
+ * @retval 0 on success.
+ * @retval -EAFNOSUPPORT if @p family is not AF_INET or AF_INET6.
+ */
+int resolver_stats_get(int family, struct resolver_family_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELLFUND_RESOLVER_H_ */
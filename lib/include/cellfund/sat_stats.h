@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef CELLFUND_SAT_STATS_H_
+#define CELLFUND_SAT_STATS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <nrf_modem_gnss.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Statistics for one satellite signal. */
+struct sat_stats_sv {
+	/** Satellite ID. */
+	uint16_t sv;
+	/** Signal type, as in struct nrf_modem_gnss_sv. */
+	uint8_t signal;
+	/** True if the satellite was tracked in the latest epoch. */
+	bool visible;
+	/** Rolling C/N0 average in 0.1 dB-Hz. */
+	uint16_t cn0_avg;
+	/** Epochs in which the satellite was tracked. */
+	uint32_t epochs_tracked;
+	/** Percentage of tracked epochs in which the satellite was used in the fix. */
+	uint8_t used_in_fix_pct;
+	/** Total time the satellite has been tracked, in milliseconds. */
+	uint32_t visible_ms;
+};
+
+/** @brief Statistics across all satellites. */
+struct sat_stats_summary {
+	/** PVT epochs processed. */
+	uint32_t epochs;
+	/** Epochs with a valid fix. */
+	uint32_t fix_epochs;
+	/** Satellites tracked in the latest epoch. */
+	uint8_t tracked;
+	/** Satellites used in the fix in the latest epoch. */
+	uint8_t used_in_fix;
+	/** Mean C/N0 of the satellites tracked in the latest epoch, in 0.1 dB-Hz. */
+	uint16_t cn0_mean;
+	/** Entries in the statistics table. */
+	uint8_t entries;
+};
+
+/**
+ * @brief Update the statistics with one PVT epoch.
+ *
+ * Call once for every NRF_MODEM_GNSS_EVT_PVT event, after the frame has been read.
+ */
+void sat_stats_update(const struct nrf_modem_gnss_pvt_data_frame *pvt);
+
+/** @brief Get the statistics across all satellites. */
+void sat_stats_summary_get(struct sat_stats_summary *summary);
+
+/**
+ * @brief Get the statistics of one table entry.
+ *
+ * @param idx Entry index, from 0 to sat_stats_summary::entries - 1.
+ * @param out Statistics of the entry.
+ *
+ * @retval 0 on success.
+ * @retval -ENOENT if there is no entry at @p idx.
+ */
+int sat_stats_get(uint8_t idx, struct sat_stats_sv *out);
+
+/**
+ * @brief Get the statistics of one satellite signal.
+ *
+ * @retval 0 on success.
+ * @retval -ENOENT if the satellite has not been tracked.
+ */
+int sat_stats_sv_get(uint16_t sv, uint8_t signal, struct sat_stats_sv *out);
+
+/** @brief Clear all statistics. */
+void sat_stats_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELLFUND_SAT_STATS_H_ */
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef CELLFUND_TRACK_SIMPLIFY_H_
+#define CELLFUND_TRACK_SIMPLIFY_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Point of a track. */
+struct track_point {
+	/** Latitude, in 1e-7 degrees. */
+	int32_t lat_e7;
+	/** Longitude, in 1e-7 degrees. */
+	int32_t lon_e7;
+};
+
+/**
+ * @brief Simplify a track with the Douglas-Peucker algorithm.
+ *
+ * The first and last points are always kept. Of the others, only the points
+ * further than @p tolerance_mm from the simplified track are kept. Distances
+ * are computed in integer millimetres on a local flat-earth projection, which
+ * is accurate for tracks spanning up to a few hundred kilometres.
+ *
+ * @param points Track.
+ * @param count Number of points, at most CONFIG_TRACK_SIMPLIFY_MAX_POINTS.
+ * @param tolerance_mm Tolerance, in mm.
+ * @param kept Indices of the kept points, in ascending order. Must have room
+ *             for @p count indices.
+ *
+ * @return Number of kept points on success, or -EINVAL if @p count is too large.
+ */
+int track_simplify(const struct track_point *points, size_t count,
+		   uint32_t tolerance_mm, uint8_t *kept);
+
+/**
+ * @brief Streaming simplification state.
+ *
+ * An opening-window variant that never holds more than
+ * CONFIG_TRACK_SIMPLIFY_WINDOW points. It keeps a few more points than
+ * track_simplify() for the same tolerance.
+ */
+struct track_simplify_stream {
+	uint32_t tolerance_mm;
+	/* The first point is the last emitted one. */
+	struct track_point window[CONFIG_TRACK_SIMPLIFY_WINDOW];
+	size_t count;
+};
+
+/** @brief Set up a stream with the given tolerance, in mm. */
+void track_simplify_stream_init(struct track_simplify_stream *stream, uint32_t tolerance_mm);
+
+/**
+ * @brief Add a point to a stream.
+ *
+ * @param stream Stream.
+ * @param point New point.
+ * @param out Emitted point, valid if true is returned.
+ *
+ * @return true if a point was emitted.
+ */
+bool track_simplify_stream_push(struct track_simplify_stream *stream,
+				const struct track_point *point, struct track_point *out);
+
+/**
+ * @brief Emit the last point of a stream, ending the current segment.
+ *
+ * @return true if a point was emitted.
+ */
+bool track_simplify_stream_flush(struct track_simplify_stream *stream, struct track_point *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELLFUND_TRACK_SIMPLIFY_H_ */
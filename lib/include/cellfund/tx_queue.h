@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef CELLFUND_TX_QUEUE_H_
+#define CELLFUND_TX_QUEUE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Replace the data of a queued message of the same type instead of
+ *        queueing another one.
+ *
+ * Use for messages where only the latest matters, like keepalives and
+ * position reports. These messages are also held for
+ * CONFIG_TX_QUEUE_COALESCE_MS, so triggers in that window become one message.
+ */
+#define TX_QUEUE_COALESCE BIT(0)
+
+/**
+ * @brief Send one message, called from the sender thread.
+ *
+ * @param type Message type given to tx_queue_put().
+ * @param data Message data, valid until the callback returns.
+ * @param len Length of @p data.
+ *
+ * @return 0 on success, a negative error code otherwise.
+ */
+typedef int (*tx_queue_send_t)(uint8_t type, const uint8_t *data, size_t len);
+
+/** @brief Queue statistics. */
+struct tx_queue_stats {
+	/** Messages queued. */
+	uint32_t queued;
+	/** Messages that replaced the data of a queued message. */
+	uint32_t coalesced;
+	/** Messages dropped because the queue was full. */
+	uint32_t dropped;
+	/** Messages sent. */
+	uint32_t sent;
+	/** Messages the send callback failed on. */
+	uint32_t send_errors;
+	/** Messages held back by the rate limit or the coalescing window. */
+	uint32_t held;
+	/** Messages in the queue now. */
+	uint8_t depth;
+	/** Most messages in the queue at once. */
+	uint8_t depth_max;
+	/** Longest time a message waited in the queue, in ms. */
+	uint32_t wait_ms_max;
+	/** Longest time the send callback took, in ms. */
+	uint32_t send_ms_max;
+};
+
+/** @brief Statistics of one message type. */
+struct tx_queue_type_stats {
+	uint32_t queued;
+	uint32_t coalesced;
+	uint32_t dropped;
+	uint32_t sent;
+};
+
+/**
+ * @brief Set the send callback and start sending queued messages.
+ *
+ * Messages queued before this are kept and sent once it is called.
+ */
+void tx_queue_init(tx_queue_send_t send);
+
+/**
+ * @brief Queue a message without blocking on the socket.
+ *
+ * The data is copied, so the caller can reuse its buffer. Do not call
+ * from an interrupt.
+ *
+ * @param type Message type, passed on to the send callback.
+ * @param data Message data, may be NULL if @p len is 0.
+ * @param len Length of @p data, at most CONFIG_TX_QUEUE_DATA_MAX.
+ * @param flags TX_QUEUE_COALESCE or 0.
+ *
+ * @retval 0 on success, also when the oldest message was dropped to make
+ *           room with CONFIG_TX_QUEUE_DROP_OLDEST.
+ * @retval -EMSGSIZE if @p len is too long.
+ * @retval -ENOBUFS if the queue is full and CONFIG_TX_QUEUE_DROP_NEWEST is set.
+ */
+int tx_queue_put(uint8_t type, const void *data, size_t len, uint32_t flags);
+
+/** @brief Get the queue statistics. */
+void tx_queue_stats_get(struct tx_queue_stats *stats);
+
+/**
+ * @brief Get the statistics of one message type.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if @p type is not below CONFIG_TX_QUEUE_TYPES.
+ */
+int tx_queue_type_stats_get(uint8_t type, struct tx_queue_type_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELLFUND_TX_QUEUE_H_ */
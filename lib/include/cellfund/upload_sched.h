@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef CELLFUND_UPLOAD_SCHED_H_
+#define CELLFUND_UPLOAD_SCHED_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Link quality from the modem's connection evaluation. */
+struct upload_sched_quality {
+	/** RSRP, in dBm. */
+	int16_t rsrp_dbm;
+	/** SNR, in dB. */
+	int16_t snr_db;
+	/** Coverage enhancement level, 0 to 3. */
+	uint8_t ce_level;
+	/** Modem energy estimate, as enum lte_lc_energy_estimate. */
+	uint8_t energy_estimate;
+};
+
+/** @brief Scheduler statistics. */
+struct upload_sched_stats {
+	/** Uploads sent right away, because they were urgent or the link was good. */
+	uint32_t immediate;
+	/** Uploads deferred until the link improved. */
+	uint32_t deferred;
+	/** Uploads sent on a poor link because the deadline expired. */
+	uint32_t deadline_expired;
+	/** Connection evaluations that failed. */
+	uint32_t eval_errors;
+	/** Total and longest deferral, in ms. */
+	uint32_t wait_ms_total;
+	uint32_t wait_ms_max;
+};
+
+/**
+ * @brief Sample the link quality.
+ *
+ * The modem must be registered to a network.
+ *
+ * @retval 0 on success.
+ * @retval -EAGAIN if the modem could not evaluate the connection.
+ */
+int upload_sched_quality_get(struct upload_sched_quality *quality);
+
+/**
+ * @brief Relative energy per payload byte on a link.
+ *
+ * @param quality Link quality.
+ * @param payload_len Payload size, in bytes.
+ *
+ * @return Energy per byte, see CONFIG_UPLOAD_SCHED_MAX_ENERGY_PER_BYTE.
+ */
+uint32_t upload_sched_energy_per_byte(const struct upload_sched_quality *quality,
+				      size_t payload_len);
+
+/** @brief Whether a link is good enough to send a payload of the given size on. */
+bool upload_sched_quality_ok(const struct upload_sched_quality *quality, size_t payload_len);
+
+/**
+ * @brief Wait until it is a good time to upload.
+ *
+ * Urgent uploads return right away. Others are held until the link is good
+ * enough for the payload, or until CONFIG_UPLOAD_SCHED_DEADLINE expires.
+ * The modem must be registered to a network.
+ *
+ * @param urgent Send right away.
+ * @param payload_len Payload size, in bytes.
+ *
+ * @retval 0 when the link is good or the upload is urgent.
+ * @retval -ETIMEDOUT if the deadline expired first. The upload should still
+ *         be sent.
+ */
+int upload_sched_wait(bool urgent, size_t payload_len);
+
+/**
+ * @brief Check once whether it is a good time to upload.
+ *
+ * Takes a single connection evaluation instead of waiting on the link, so
+ * the caller can deactivate LTE while an upload is deferred and check again
+ * on its next attach. The deadline runs from the first check that deferred
+ * the upload. The modem must be registered to a network.
+ *
+ * @param urgent Send right away.
+ * @param payload_len Payload size, in bytes.
+ *
+ * @retval 0 when the link is good or the upload is urgent.
+ * @retval -EAGAIN if the link is poor. The upload should be deferred.
+ * @retval -ETIMEDOUT if the deadline expired. The upload should still be sent.
+ */
+int upload_sched_check(bool urgent, size_t payload_len);
+
+/** @brief Get the scheduler statistics. */
+void upload_sched_stats_get(struct upload_sched_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELLFUND_UPLOAD_SCHED_H_ */
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_ctrl.h>
+
+LOG_MODULE_REGISTER(log_bench, CONFIG_LOG_BENCH_LOG_LEVEL);
+
+#define BATCH 4
+
+enum msg_type {
+	MSG_NO_ARGS,
+	MSG_INTS,
+	MSG_STRING,
+	MSG_TYPE_COUNT,
+};
+
+static const char *const msg_names[] = {
+	[MSG_NO_ARGS] = "no arguments",
+	[MSG_INTS] = "5 integers",
+	[MSG_STRING] = "integers and a string",
+};
+
+/* Shaped like the PVT, fix and CoAP response logs of the lessons. */
+static void msg_log(enum msg_type type, uint32_t i)
+{
+	static const char payload[] = "Hello from the CoAP server";
+
+	switch (type) {
+	case MSG_NO_ARGS:
+		LOG_INF("Searching for GNSS satellites");
+		break;
+	case MSG_INTS:
+		LOG_INF("Fix: %d.%07d, %d.%07d, accuracy %u mm", 63, 4305000 + i, 10, 3951000 - i,
+			4200 + i);
+		break;
+	case MSG_STRING:
+		LOG_INF("CoAP response: Code 0x%x, Token 0x%02x%02x, Payload: %s", 0x45, i & 0xff,
+			(i >> 8) & 0xff, payload);
+		break;
+	default:
+		break;
+	}
+}
+
+static void flush(void)
+{
+	log_thread_trigger();
+	while (log_data_pending()) {
+		k_sleep(K_TICKS(1));
+	}
+}
+
+static int log_bench_run(void)
+{
+	for (int type = 0; type < MSG_TYPE_COUNT; type++) {
+		uint64_t call_cycles = 0;
+		uint64_t total_cycles = 0;
+		uint32_t count = 0;
+
+		flush();
+
+		for (uint32_t round = 0; round < CONFIG_LOG_BENCH_ROUNDS; round += BATCH) {
+			uint32_t start = k_cycle_get_32();
+
+			for (uint32_t i = round; i < MIN(round + BATCH, CONFIG_LOG_BENCH_ROUNDS); i++) {
+				msg_log(type, i);
+				count++;
+			}
+			call_cycles += k_cycle_get_32() - start;
+
+			/* Formatting and output happen in the log thread */
+			flush();
+			total_cycles += k_cycle_get_32() - start;
+		}
+
+		LOG_INF("Log call with %s: %u cycles per call, %u us per message until written",
+			msg_names[type], (uint32_t)(call_cycles / count),
+			k_cyc_to_us_floor32(total_cycles / count));
+	}
+
+	flush();
+
+	return 0;
+}
+
+SYS_INIT(log_bench_run, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
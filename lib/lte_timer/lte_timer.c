@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <modem/lte_lc.h>
+
+#include <cellfund/lte_timer.h>
+
+LOG_MODULE_REGISTER(lte_timer, CONFIG_LTE_TIMER_LOG_LEVEL);
+
+/* GPRS timers are a 3-bit unit followed by a 5-bit value. */
+#define GPRS_TIMER_VALUE_MAX 31
+
+struct gprs_timer_unit {
+	uint8_t bits;
+	uint32_t seconds;
+};
+
+/* 3GPP TS 24.008, table 10.5.163a. */
+static const struct gprs_timer_unit tau_units[] = {
+	{ 0x3, 2 },
+	{ 0x4, 30 },
+	{ 0x5, 60 },
+	{ 0x0, 600 },
+	{ 0x1, 3600 },
+	{ 0x2, 36000 },
+	{ 0x6, 1152000 },
+};
+
+/* 3GPP TS 24.008, table 10.5.163. */
+static const struct gprs_timer_unit active_time_units[] = {
+	{ 0x0, 2 },
+	{ 0x1, 60 },
+	{ 0x2, 360 },
+};
+
+/* eDRX cycles by code, 3GPP TS 24.008 table 10.5.5.32. NB-IoT only
+ * supports some of the codes.
+ */
+static const uint32_t edrx_ms[] = {
+	5120, 10240, 20480, 40960, 61440, 81920, 102400, 122880,
+	143360, 163840, 327680, 655360, 1310720, 2621440, 5242880, 10485760,
+};
+#define EDRX_NBIOT_CODES (BIT(2) | BIT(3) | BIT(5) | GENMASK(15, 9))
+
+#define PTW_STEP_LTEM_MS 1280
+#define PTW_STEP_NBIOT_MS 2560
+
+static void bits_to_str(uint32_t val, int count, char *str)
+{
+	for (int i = 0; i < count; i++) {
+		str[i] = val & BIT(count - 1 - i) ? '1' : '0';
+	}
+
+	str[count] = '\0';
+}
+
+static uint32_t abs_diff(uint32_t a, uint32_t b)
+{
+	return a > b ? a - b : b - a;
+}
+
+/* Picks the unit and value closest to the requested time, the longer one on ties. */
+static void gprs_timer_encode(const struct gprs_timer_unit *units, size_t count,
+			      uint32_t seconds, char *bits, uint32_t *actual)
+{
+	uint32_t best_val = 0, best_unit = 0, best = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		uint32_t val = MIN(((uint64_t)seconds + units[i].seconds / 2) / units[i].seconds,
+				   GPRS_TIMER_VALUE_MAX);
+		uint32_t time = val * units[i].seconds;
+
+		if (i == 0 || abs_diff(time, seconds) < abs_diff(best, seconds) ||
+		    (abs_diff(time, seconds) == abs_diff(best, seconds) && time > best)) {
+			best = time;
+			best_val = val;
+			best_unit = units[i].bits;
+		}
+	}
+
+	bits_to_str(best_unit << 5 | best_val, 8, bits);
+
+	if (actual != NULL) {
+		*actual = best;
+	}
+}
+
+void lte_timer_tau_encode(uint32_t seconds, char bits[LTE_TIMER_PSM_BITS_LEN],
+			  uint32_t *actual)
+{
+	gprs_timer_encode(tau_units, ARRAY_SIZE(tau_units), seconds, bits, actual);
+}
+
+void lte_timer_active_time_encode(uint32_t seconds, char bits[LTE_TIMER_PSM_BITS_LEN],
+				  uint32_t *actual)
+{
+	gprs_timer_encode(active_time_units, ARRAY_SIZE(active_time_units), seconds, bits,
+			  actual);
+}
+
+int lte_timer_edrx_encode(enum lte_lc_lte_mode mode, uint32_t ms,
+			  char bits[LTE_TIMER_EDRX_BITS_LEN], uint32_t *actual)
+{
+	uint32_t codes;
+	int best = -1;
+
+	switch (mode) {
+	case LTE_LC_LTE_MODE_LTEM:
+		codes = GENMASK(15, 0);
+		break;
+	case LTE_LC_LTE_MODE_NBIOT:
+		codes = EDRX_NBIOT_CODES;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	for (int i = 0; i < (int)ARRAY_SIZE(edrx_ms); i++) {
+		if (!(codes & BIT(i))) {
+			continue;
+		}
+
+		if (best < 0 || abs_diff(edrx_ms[i], ms) <= abs_diff(edrx_ms[best], ms)) {
+			best = i;
+		}
+	}
+
+	bits_to_str(best, 4, bits);
+
+	if (actual != NULL) {
+		*actual = edrx_ms[best];
+	}
+
+	return 0;
+}
+
+int lte_timer_ptw_encode(enum lte_lc_lte_mode mode, uint32_t ms,
+			 char bits[LTE_TIMER_EDRX_BITS_LEN], uint32_t *actual)
+{
+	uint32_t step, code;
+
+	switch (mode) {
+	case LTE_LC_LTE_MODE_LTEM:
+		step = PTW_STEP_LTEM_MS;
+		break;
+	case LTE_LC_LTE_MODE_NBIOT:
+		step = PTW_STEP_NBIOT_MS;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	/* Code n is a window of n + 1 steps. */
+	code = CLAMP((ms + step / 2) / step, 1, 16) - 1;
+
+	bits_to_str(code, 4, bits);
+
+	if (actual != NULL) {
+		*actual = (code + 1) * step;
+	}
+
+	return 0;
+}
+
+#if defined(CONFIG_LTE_LC_PSM_MODULE)
+static int psm_param_set(uint32_t tau, uint32_t active_time)
+{
+	char tau_bits[LTE_TIMER_PSM_BITS_LEN];
+	char active_time_bits[LTE_TIMER_PSM_BITS_LEN];
+	uint32_t tau_actual, active_time_actual;
+	int err;
+
+	lte_timer_tau_encode(tau, tau_bits, &tau_actual);
+	lte_timer_active_time_encode(active_time, active_time_bits, &active_time_actual);
+
+	err = lte_lc_psm_param_set(tau_bits, active_time_bits);
+	if (err) {
+		LOG_ERR("Failed to set PSM parameters, error: %d", err);
+		return err;
+	}
+
+	LOG_INF("PSM: TAU %u s (%s), active time %u s (%s)", tau_actual, tau_bits,
+		active_time_actual, active_time_bits);
+
+	return 0;
+}
+#endif /* CONFIG_LTE_LC_PSM_MODULE */
+
+#if defined(CONFIG_LTE_LC_EDRX_MODULE)
+static int edrx_param_set(enum lte_lc_lte_mode mode, uint32_t edrx, uint32_t ptw)
+{
+	char edrx_bits[LTE_TIMER_EDRX_BITS_LEN];
+	char ptw_bits[LTE_TIMER_EDRX_BITS_LEN];
+	uint32_t edrx_actual, ptw_actual;
+	int err;
+
+	err = lte_timer_edrx_encode(mode, edrx, edrx_bits, &edrx_actual);
+	if (err) {
+		return err;
+	}
+
+	(void)lte_timer_ptw_encode(mode, ptw, ptw_bits, &ptw_actual);
+
+	err = lte_lc_edrx_param_set(mode, edrx_bits);
+	if (err) {
+		LOG_ERR("Failed to set eDRX parameter, error: %d", err);
+		return err;
+	}
+
+	err = lte_lc_ptw_set(mode, ptw_bits);
+	if (err) {
+		LOG_ERR("Failed to set PTW, error: %d", err);
+		return err;
+	}
+
+	LOG_INF("eDRX (%s): cycle %u ms (%s), PTW %u ms (%s)",
+		mode == LTE_LC_LTE_MODE_LTEM ? "LTE-M" : "NB-IoT",
+		edrx_actual, edrx_bits, ptw_actual, ptw_bits);
+
+	return 0;
+}
+#endif /* CONFIG_LTE_LC_EDRX_MODULE */
+
+#if defined(CONFIG_LTE_LC_PSM_MODULE)
+int lte_timer_psm_set(uint32_t tau, uint32_t active_time)
+{
+	int err;
+
+	err = psm_param_set(tau, active_time);
+	if (err) {
+		return err;
+	}
+
+	/* Requesting PSM again sends the new values to the network. */
+	return lte_lc_psm_req(true);
+}
+#endif /* CONFIG_LTE_LC_PSM_MODULE */
+
+#if defined(CONFIG_LTE_LC_EDRX_MODULE)
+int lte_timer_edrx_set(enum lte_lc_lte_mode mode, uint32_t edrx, uint32_t ptw)
+{
+	int err;
+
+	err = edrx_param_set(mode, edrx, ptw);
+	if (err) {
+		return err;
+	}
+
+	return lte_lc_edrx_req(true);
+}
+#endif /* CONFIG_LTE_LC_EDRX_MODULE */
+
+int lte_timer_init(void)
+{
+	int err = 0;
+
+#if defined(CONFIG_LTE_TIMER_PSM)
+	err = psm_param_set(CONFIG_LTE_TIMER_PSM_TAU, CONFIG_LTE_TIMER_PSM_ACTIVE_TIME);
+	if (err) {
+		return err;
+	}
+#endif
+
+#if defined(CONFIG_LTE_TIMER_EDRX)
+	err = edrx_param_set(LTE_LC_LTE_MODE_LTEM, CONFIG_LTE_TIMER_EDRX_LTE_M,
+			     CONFIG_LTE_TIMER_PTW_LTE_M);
+	if (err) {
+		return err;
+	}
+
+	err = edrx_param_set(LTE_LC_LTE_MODE_NBIOT, CONFIG_LTE_TIMER_EDRX_NBIOT,
+			     CONFIG_LTE_TIMER_PTW_NBIOT);
+#endif
+
+	return err;
+}
@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/sys_heap.h>
+#if defined(CONFIG_NRF_MODEM_LIB_MEM_DIAG)
+#include <modem/nrf_modem_lib.h>
+#endif
+
+#include <cellfund/mem_prof.h>
+
+LOG_MODULE_REGISTER(mem_prof, CONFIG_MEM_PROF_LOG_LEVEL);
+
+/* Suggested sizes are rounded up to this many bytes. */
+#define SIZE_ALIGN 64
+
+#if defined(CONFIG_HEAP_MEM_POOL_SIZE) && CONFIG_HEAP_MEM_POOL_SIZE > 0
+#define HAS_SYSTEM_HEAP 1
+#else
+#define HAS_SYSTEM_HEAP 0
+#endif
+
+enum heap_id {
+#if HAS_SYSTEM_HEAP
+	HEAP_SYSTEM,
+#endif
+#if defined(CONFIG_NRF_MODEM_LIB_MEM_DIAG)
+	HEAP_MODEM_LIB,
+	HEAP_MODEM_SHMEM_TX,
+#endif
+	HEAP_COUNT,
+};
+
+struct stack_entry {
+	const struct k_thread *thread;
+	struct mem_prof_usage usage;
+};
+
+/* Threads whose stack size is set by a Kconfig option. */
+static const struct {
+	const char *name;
+	const char *kconfig;
+} stack_options[] = {
+	{ "main", "CONFIG_MAIN_STACK_SIZE" },
+	{ "sysworkq", "CONFIG_SYSTEM_WORKQUEUE_STACK_SIZE" },
+	{ "logging", "CONFIG_LOG_PROCESS_THREAD_STACK_SIZE" },
+	{ "idle", "CONFIG_IDLE_STACK_SIZE" },
+	{ "shell_uart", "CONFIG_SHELL_STACK_SIZE" },
+	{ "gnss_pipeline_tid", "CONFIG_GNSS_PIPELINE_STACK_SIZE" },
+};
+
+static K_MUTEX_DEFINE(lock);
+static struct stack_entry stacks[CONFIG_MEM_PROF_MAX_THREADS];
+static size_t stack_count;
+static struct mem_prof_usage heaps[MAX(HEAP_COUNT, 1)];
+static int over_budget;
+
+#if HAS_SYSTEM_HEAP
+extern struct k_heap _system_heap;
+#endif
+
+static void sample_work_fn(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(sample_work, sample_work_fn);
+
+static const char *stack_kconfig(const char *name)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(stack_options); i++) {
+		if (strcmp(name, stack_options[i].name) == 0) {
+			return stack_options[i].kconfig;
+		}
+	}
+
+	return NULL;
+}
+
+/* Called with the lock held. Returns true the first time the budget is exceeded. */
+static bool usage_update_locked(struct mem_prof_usage *usage, size_t used, int budget)
+{
+	usage->peak = MAX(usage->peak, used);
+	if (usage->over_budget || usage->peak * 100 <= usage->size * budget) {
+		return false;
+	}
+
+	usage->over_budget = true;
+	over_budget++;
+
+	return true;
+}
+
+static void budget_exceeded(const struct mem_prof_usage *usage, int budget)
+{
+	LOG_ERR("%s uses %u of %u bytes, over the %d%% budget", usage->name,
+		(uint32_t)usage->peak, (uint32_t)usage->size, budget);
+
+	if (IS_ENABLED(CONFIG_MEM_PROF_BUDGET_FATAL)) {
+		k_panic();
+	}
+}
+
+static void stack_sample(const struct k_thread *thread, void *user_data)
+{
+	struct stack_entry *entry = NULL;
+	const char *name = k_thread_name_get((k_tid_t)thread);
+	struct mem_prof_usage exceeded;
+	size_t unused;
+	bool first;
+
+	ARG_UNUSED(user_data);
+
+	if (k_thread_stack_space_get(thread, &unused) != 0) {
+		return;
+	}
+
+	if (name == NULL || name[0] == '\0') {
+		name = "unnamed";
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+	for (size_t i = 0; i < stack_count; i++) {
+		if (stacks[i].thread == thread && strcmp(stacks[i].usage.name, name) == 0) {
+			entry = &stacks[i];
+			break;
+		}
+	}
+
+	if (entry == NULL) {
+		if (stack_count == ARRAY_SIZE(stacks)) {
+			k_mutex_unlock(&lock);
+			LOG_WRN("Thread %s not tracked, increase CONFIG_MEM_PROF_MAX_THREADS", name);
+			return;
+		}
+
+		entry = &stacks[stack_count++];
+		entry->thread = thread;
+		strncpy(entry->usage.name, name, sizeof(entry->usage.name) - 1);
+		entry->usage.kconfig = stack_kconfig(name);
+		entry->usage.size = thread->stack_info.size;
+	}
+
+	first = usage_update_locked(&entry->usage, entry->usage.size - unused,
+				    CONFIG_MEM_PROF_STACK_BUDGET);
+	exceeded = entry->usage;
+	k_mutex_unlock(&lock);
+
+	if (first) {
+		budget_exceeded(&exceeded, CONFIG_MEM_PROF_STACK_BUDGET);
+	}
+}
+
+static void heap_set(enum heap_id id, const char *name, const char *kconfig,
+		     const struct sys_memory_stats *stats)
+{
+	struct mem_prof_usage *usage = &heaps[id];
+	struct mem_prof_usage exceeded;
+	bool first;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	if (usage->size == 0) {
+		strncpy(usage->name, name, sizeof(usage->name) - 1);
+		usage->kconfig = kconfig;
+		/* Usable bytes, without the heap's own metadata */
+		usage->size = stats->free_bytes + stats->allocated_bytes;
+	}
+
+	first = usage_update_locked(usage, stats->max_allocated_bytes, CONFIG_MEM_PROF_HEAP_BUDGET);
+	exceeded = *usage;
+	k_mutex_unlock(&lock);
+
+	if (first) {
+		budget_exceeded(&exceeded, CONFIG_MEM_PROF_HEAP_BUDGET);
+	}
+}
+
+static void heaps_sample(void)
+{
+	struct sys_memory_stats stats;
+
+#if HAS_SYSTEM_HEAP
+	if (sys_heap_runtime_stats_get(&_system_heap.heap, &stats) == 0) {
+		heap_set(HEAP_SYSTEM, "system heap", "CONFIG_HEAP_MEM_POOL_SIZE", &stats);
+	}
+#endif
+
+#if defined(CONFIG_NRF_MODEM_LIB_MEM_DIAG)
+	struct nrf_modem_lib_diag_stats diag;
+
+	if (nrf_modem_lib_diag_stats_get(&diag) == 0) {
+		heap_set(HEAP_MODEM_LIB, "modem library heap", "CONFIG_NRF_MODEM_LIB_HEAP_SIZE",
+			 &diag.library.heap);
+		heap_set(HEAP_MODEM_SHMEM_TX, "modem TX memory", "CONFIG_NRF_MODEM_LIB_SHMEM_TX_SIZE",
+			 &diag.shmem.heap);
+	}
+#endif
+
+	ARG_UNUSED(stats);
+}
+
+int mem_prof_sample(void)
+{
+	int count;
+
+	k_thread_foreach_unlocked(stack_sample, NULL);
+	heaps_sample();
+
+	k_mutex_lock(&lock, K_FOREVER);
+	count = over_budget;
+	k_mutex_unlock(&lock);
+
+	return count;
+}
+
+static void sample_work_fn(struct k_work *work)
+{
+	(void)mem_prof_sample();
+	k_work_reschedule(&sample_work, K_SECONDS(CONFIG_MEM_PROF_INTERVAL));
+}
+
+int mem_prof_stack_get(size_t idx, struct mem_prof_usage *usage)
+{
+	int err = -ENOENT;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	if (idx < stack_count) {
+		*usage = stacks[idx].usage;
+		err = 0;
+	}
+	k_mutex_unlock(&lock);
+
+	return err;
+}
+
+int mem_prof_heap_get(size_t idx, struct mem_prof_usage *usage)
+{
+	int err = -ENOENT;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	if (idx < HEAP_COUNT) {
+		*usage = heaps[idx];
+		err = 0;
+	}
+	k_mutex_unlock(&lock);
+
+	return err;
+}
+
+size_t mem_prof_suggest(size_t peak)
+{
+	return ROUND_UP(peak * (100 + CONFIG_MEM_PROF_MARGIN) / 100, SIZE_ALIGN);
+}
+
+static void usage_log(const struct mem_prof_usage *usage)
+{
+	LOG_INF("%-20s %6u / %6u bytes%s, suggested %s=%u", usage->name, (uint32_t)usage->peak,
+		(uint32_t)usage->size, usage->over_budget ? " (over budget)" : "",
+		usage->kconfig != NULL ? usage->kconfig : "size",
+		(uint32_t)mem_prof_suggest(usage->peak));
+}
+
+void mem_prof_report(void)
+{
+	struct mem_prof_usage usage;
+
+	(void)mem_prof_sample();
+
+	for (size_t i = 0; mem_prof_stack_get(i, &usage) == 0; i++) {
+		usage_log(&usage);
+	}
+
+	for (size_t i = 0; mem_prof_heap_get(i, &usage) == 0; i++) {
+		if (usage.size > 0) {
+			usage_log(&usage);
+		}
+	}
+}
+
+static int mem_prof_init(void)
+{
+	k_work_schedule(&sample_work, K_SECONDS(CONFIG_MEM_PROF_INTERVAL));
+
+	return 0;
+}
+
+SYS_INIT(mem_prof_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+
+#include <cellfund/mem_prof.h>
+
+static void usage_print(const struct shell *sh, const struct mem_prof_usage *usage)
+{
+	shell_print(sh, "%-20s %6u %6u %3u%% %c %6u  %s", usage->name, (uint32_t)usage->size,
+		    (uint32_t)usage->peak, (uint32_t)(usage->peak * 100 / MAX(usage->size, 1)),
+		    usage->over_budget ? '!' : ' ', (uint32_t)mem_prof_suggest(usage->peak),
+		    usage->kconfig != NULL ? usage->kconfig : "");
+}
+
+static int cmd_mem_prof_show(const struct shell *sh, size_t argc, char **argv)
+{
+	struct mem_prof_usage usage;
+	int over;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	over = mem_prof_sample();
+
+	shell_print(sh, "name                   size   peak  use   suggest option");
+	for (size_t i = 0; mem_prof_stack_get(i, &usage) == 0; i++) {
+		usage_print(sh, &usage);
+	}
+
+	for (size_t i = 0; mem_prof_heap_get(i, &usage) == 0; i++) {
+		if (usage.size > 0) {
+			usage_print(sh, &usage);
+		}
+	}
+
+	shell_print(sh, "%d over budget", over);
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_mem_prof,
+	SHELL_CMD(show, NULL, "Show stack and heap high-water marks", cmd_mem_prof_show),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(mem_prof, &sub_mem_prof, "Stack and heap profiler", NULL);
@@ -0,0 +1,201 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+"""Stand-in for the UDP echo and CoAP servers of the lessons, for native_sim.
+
+Echoes UDP datagrams on port 2444, like udp-echo.nordicsemi.academy, and
+answers plain CoAP requests on port 5683. A PUT or POST is answered with
+2.04 Changed and stores its payload, a GET is answered with 2.05 Content and
+the payload stored last, whatever the resource. Confirmable requests get a
+piggybacked response, others a non-confirmable one. With --separate,
+confirmable requests get an empty ACK and the response follows that many ms
+later as a confirmable message, retransmitted until it is acknowledged.
+
+Usage: emu_server.py [--echo-port PORT] [--coap-port PORT] [--separate MS]
+"""
+
+import argparse
+import selectors
+import socket
+import struct
+import time
+
+COAP_CON = 0
+COAP_NON = 1
+COAP_ACK = 2
+COAP_RST = 3
+
+# ACK_TIMEOUT and MAX_RETRANSMIT of RFC 7252, without the random factor
+ACK_TIMEOUT = 2.0
+MAX_RETRANSMIT = 4
+
+COAP_GET = 0x01
+COAP_POST = 0x02
+COAP_PUT = 0x03
+COAP_CHANGED = 0x44
+COAP_CONTENT = 0x45
+COAP_METHOD_NOT_ALLOWED = 0x85
+
+COAP_OPTION_URI_PATH = 11
+COAP_OPTION_CONTENT_FORMAT = 12
+COAP_FORMAT_TEXT_PLAIN = 0
+
+
+def options_parse(data):
+    """Returns the options as (number, value) pairs and the payload."""
+    options = []
+    number = 0
+    pos = 0
+
+    while pos < len(data) and data[pos] != 0xff:
+        delta = data[pos] >> 4
+        length = data[pos] & 0x0f
+        pos += 1
+        values = []
+        for nibble in (delta, length):
+            if nibble == 13:
+                values.append(data[pos] + 13)
+                pos += 1
+            elif nibble == 14:
+                values.append(struct.unpack_from('>H', data, pos)[0] + 269)
+                pos += 2
+            elif nibble == 15:
+                raise ValueError('Reserved option nibble')
+            else:
+                values.append(nibble)
+        number += values[0]
+        options.append((number, data[pos:pos + values[1]]))
+        pos += values[1]
+
+    return options, data[pos + 1:]
+
+
+class CoapServer:
+    def __init__(self, separate=None):
+        self.payload = b''
+        self.mid = 0
+        self.separate = separate
+        self.sock = None
+        # Separate responses by message ID: [due, transmissions, datagram, address]
+        self.pending = {}
+
+    def next_mid(self):
+        self.mid = (self.mid + 1) & 0xffff
+        return self.mid
+
+    def timeout(self):
+        """Returns the time until the next separate response is due, or None."""
+        if not self.pending:
+            return None
+        return max(min(p[0] for p in self.pending.values()) - time.monotonic(), 0)
+
+    def poll(self):
+        """Sends and retransmits the separate responses that are due."""
+        now = time.monotonic()
+        for mid, pending in list(self.pending.items()):
+            due, sent, reply, addr = pending
+            if due > now:
+                continue
+            if sent > MAX_RETRANSMIT:
+                print(f'Separate response 0x{mid:04x} not acknowledged')
+                del self.pending[mid]
+                continue
+            self.sock.sendto(reply, addr)
+            pending[0] = now + ACK_TIMEOUT * 2 ** sent
+            pending[1] = sent + 1
+
+    def handle(self, data, addr):
+        if len(data) < 4 or data[0] >> 6 != 1:
+            return None
+
+        msg_type = (data[0] >> 4) & 0x3
+        tkl = data[0] & 0x0f
+        code = data[1]
+        mid = struct.unpack_from('>H', data, 2)[0]
+        token = data[4:4 + tkl]
+
+        if msg_type in (COAP_ACK, COAP_RST) and mid in self.pending:
+            sent = self.pending.pop(mid)[1]
+            kind = 'acknowledged' if msg_type == COAP_ACK else 'reset'
+            print(f'Separate response 0x{mid:04x} {kind} after {sent} transmissions')
+            return None
+
+        if msg_type not in (COAP_CON, COAP_NON) or code == 0:
+            # ACKs, resets and pings carry no request
+            return None
+
+        options, payload = options_parse(data[4 + tkl:])
+        path = '/'.join(v.decode(errors='replace') for n, v in options
+                        if n == COAP_OPTION_URI_PATH)
+        print(f'CoAP {code >> 5}.{code & 0x1f:02d} /{path}, {len(payload)} bytes')
+
+        body = b''
+        if code in (COAP_PUT, COAP_POST):
+            self.payload = payload
+            code = COAP_CHANGED
+        elif code == COAP_GET:
+            body = self.payload
+            code = COAP_CONTENT
+        else:
+            code = COAP_METHOD_NOT_ALLOWED
+
+        ack = None
+        if msg_type == COAP_CON and self.separate is not None:
+            ack = struct.pack('>BBH', 0x40 | COAP_ACK << 4, 0, mid)
+            mid = self.next_mid()
+        elif msg_type == COAP_CON:
+            msg_type = COAP_ACK
+        else:
+            mid = self.next_mid()
+
+        reply = struct.pack('>BBH', 0x40 | msg_type << 4 | tkl, code, mid) + token
+        if body:
+            # Content-Format, delta 12, one byte long
+            reply += bytes([0xc1, COAP_FORMAT_TEXT_PLAIN, 0xff]) + body
+
+        if ack is not None:
+            self.pending[mid] = [time.monotonic() + self.separate / 1000, 0, reply, addr]
+            return ack
+
+        return reply
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('--echo-port', type=int, default=2444)
+    parser.add_argument('--coap-port', type=int, default=5683)
+    parser.add_argument('--separate', type=int, metavar='MS',
+                        help='answer confirmable requests separately, after MS ms')
+    args = parser.parse_args()
+
+    sel = selectors.DefaultSelector()
+    coap = CoapServer(args.separate)
+
+    for port, handler in ((args.echo_port, lambda data, addr: data),
+                          (args.coap_port, coap.handle)):
+        sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        sock.bind(('0.0.0.0', port))
+        sel.register(sock, selectors.EVENT_READ, handler)
+        print(f'Listening on UDP port {port}')
+    coap.sock = sock
+
+    while True:
+        events = sel.select(coap.timeout())
+        coap.poll()
+        for key, _ in events:
+            data, addr = key.fileobj.recvfrom(2048)
+            try:
+                reply = key.data(data, addr)
+            except (ValueError, IndexError, struct.error):
+                print(f'Malformed datagram from {addr[0]}:{addr[1]}')
+                continue
+            if reply is not None:
+                key.fileobj.sendto(reply, addr)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,972 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <modem/lte_lc.h>
+#include <modem/nrf_modem_lib.h>
+
+#include <cellfund/modem_emu.h>
+
+LOG_MODULE_REGISTER(modem_emu, CONFIG_MODEM_EMU_LOG_LEVEL);
+
+#define MAX_HANDLERS 4
+#define EVT_QUEUE_SIZE 16
+#define CMD_LEN_MAX 48
+
+#define RSRP_OFFSET 140
+#define SNR_OFFSET 24
+
+/* Returned by the modem when the connection cannot be evaluated. */
+#define CONN_EVAL_NO_CELL 1
+
+/* Only the LTE link control modules that are enabled are emulated, the
+ * others have no types or prototypes in lte_lc.h.
+ */
+#if defined(CONFIG_LTE_LC_PSM_MODULE)
+/* Defaults of LTE link control: TAU 1 hour, active time 1 minute. */
+#define PSM_RPTAU_DEFAULT "00100001"
+#define PSM_RAT_DEFAULT "00100001"
+
+/* GPRS timer units by their 3-bit code, in seconds. -1 means deactivated.
+ * 3GPP TS 24.008, tables 10.5.163a and 10.5.163.
+ */
+static const int32_t tau_units[] = { 600, 3600, 36000, 2, 30, 60, 1152000, -1 };
+static const int32_t active_time_units[] = { 2, 60, 360, -1, -1, -1, -1, -1 };
+#endif
+
+#if defined(CONFIG_LTE_LC_EDRX_MODULE)
+/* eDRX cycles by code, 3GPP TS 24.008 table 10.5.5.32. */
+static const uint32_t edrx_ms[] = {
+	5120, 10240, 20480, 40960, 61440, 81920, 102400, 122880,
+	143360, 163840, 327680, 655360, 1310720, 2621440, 5242880, 10485760,
+};
+
+#define PTW_STEP_LTEM_MS 1280
+#define PTW_STEP_NBIOT_MS 2560
+#endif
+
+struct emu_cell {
+	uint32_t id;
+	uint32_t tac;
+	uint32_t earfcn;
+	uint16_t pci;
+	uint8_t band;
+};
+
+/* The serving cell after boot is the first one, the others are neighbors. */
+static const struct emu_cell cells[] = {
+	{ 0x0012bf0a, 0x0b0e, 6400, 281, 20 },
+	{ 0x0012bf0b, 0x0b0e, 1450, 282, 3 },
+	{ 0x0012c401, 0x0b0f, 9410, 17, 28 },
+};
+
+static K_MUTEX_DEFINE(lock);
+static struct modem_emu_state state = {
+	.coverage = true,
+	.snr_db = 10,
+	.psm_tau = -1,
+	.psm_active_time = -1,
+};
+static struct modem_emu_stats stats;
+static lte_lc_evt_handler_t handlers[MAX_HANDLERS];
+static size_t cell_idx;
+static uint32_t attach_failures_left = CONFIG_MODEM_EMU_ATTACH_FAILURES;
+static enum lte_lc_system_mode system_mode = LTE_LC_SYSTEM_MODE_LTEM_NBIOT_GPS;
+static enum lte_lc_system_mode_preference system_pref = LTE_LC_SYSTEM_MODE_PREFER_AUTO;
+
+#if defined(CONFIG_LTE_LC_PSM_MODULE)
+static bool psm_requested;
+static char psm_rptau[9] = PSM_RPTAU_DEFAULT;
+static char psm_rat[9] = PSM_RAT_DEFAULT;
+#endif
+
+#if defined(CONFIG_LTE_LC_EDRX_MODULE)
+static bool edrx_requested;
+/* eDRX and PTW codes for LTE-M and NB-IoT */
+static uint8_t edrx_code[2] = { 0x2, 0x2 };
+static uint8_t ptw_code[2] = { 0x3, 0x3 };
+#endif
+
+#if defined(CONFIG_LTE_LC_NEIGHBOR_CELL_MEAS_MODULE)
+static struct lte_lc_ncell ncells[ARRAY_SIZE(cells) - 1];
+#endif
+static const char *script_pos;
+
+K_MSGQ_DEFINE(evt_queue, sizeof(struct lte_lc_evt), EVT_QUEUE_SIZE, 4);
+
+static void evt_work_fn(struct k_work *work);
+static void attach_work_fn(struct k_work *work);
+static void rrc_idle_work_fn(struct k_work *work);
+static void sleep_work_fn(struct k_work *work);
+static void cell_work_fn(struct k_work *work);
+#if defined(CONFIG_LTE_LC_NEIGHBOR_CELL_MEAS_MODULE)
+static void ncellmeas_work_fn(struct k_work *work);
+#endif
+static void script_work_fn(struct k_work *work);
+
+static K_WORK_DEFINE(evt_work, evt_work_fn);
+static K_WORK_DELAYABLE_DEFINE(attach_work, attach_work_fn);
+static K_WORK_DELAYABLE_DEFINE(rrc_idle_work, rrc_idle_work_fn);
+static K_WORK_DELAYABLE_DEFINE(sleep_work, sleep_work_fn);
+static K_WORK_DELAYABLE_DEFINE(cell_work, cell_work_fn);
+#if defined(CONFIG_LTE_LC_NEIGHBOR_CELL_MEAS_MODULE)
+static K_WORK_DELAYABLE_DEFINE(ncellmeas_work, ncellmeas_work_fn);
+#endif
+static K_WORK_DELAYABLE_DEFINE(script_work, script_work_fn);
+
+/* Events are delivered from the system work queue, never from the caller
+ * of an LTE link control function, like LTE link control does.
+ */
+static void evt_post(const struct lte_lc_evt *evt)
+{
+	if (k_msgq_put(&evt_queue, evt, K_NO_WAIT) != 0) {
+		LOG_WRN("Event queue full, event %d dropped", evt->type);
+		return;
+	}
+
+	k_work_submit(&evt_work);
+}
+
+static void evt_work_fn(struct k_work *work)
+{
+	lte_lc_evt_handler_t copy[MAX_HANDLERS];
+	struct lte_lc_evt evt;
+
+	while (k_msgq_get(&evt_queue, &evt, K_NO_WAIT) == 0) {
+		k_mutex_lock(&lock, K_FOREVER);
+		memcpy(copy, handlers, sizeof(copy));
+		k_mutex_unlock(&lock);
+
+		for (size_t i = 0; i < ARRAY_SIZE(copy); i++) {
+			if (copy[i] != NULL) {
+				copy[i](&evt);
+			}
+		}
+	}
+}
+
+static void reg_status_post(enum lte_lc_nw_reg_status status)
+{
+	struct lte_lc_evt evt = {
+		.type = LTE_LC_EVT_NW_REG_STATUS,
+		.nw_reg_status = status,
+	};
+
+	evt_post(&evt);
+}
+
+static void cell_post(void)
+{
+	struct lte_lc_evt evt = {
+		.type = LTE_LC_EVT_CELL_UPDATE,
+	};
+
+	k_mutex_lock(&lock, K_FOREVER);
+	evt.cell = state.cell;
+	k_mutex_unlock(&lock);
+
+	evt_post(&evt);
+}
+
+#if defined(CONFIG_LTE_LC_PSM_MODULE) || defined(CONFIG_LTE_LC_EDRX_MODULE)
+static int bits_parse(const char *bits, size_t len)
+{
+	int val = 0;
+
+	if (bits == NULL || strlen(bits) != len) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < len; i++) {
+		if (bits[i] != '0' && bits[i] != '1') {
+			return -EINVAL;
+		}
+
+		val = val << 1 | (bits[i] - '0');
+	}
+
+	return val;
+}
+#endif
+
+#if defined(CONFIG_LTE_LC_PSM_MODULE)
+/* A 3-bit unit followed by a 5-bit value. */
+static int gprs_timer_decode(const char *bits, const int32_t units[8])
+{
+	int val = bits_parse(bits, 8);
+
+	if (val < 0 || units[val >> 5] < 0) {
+		return -1;
+	}
+
+	return units[val >> 5] * (val & 0x1f);
+}
+
+/* Called with the lock held. The network grants what was requested. */
+static void psm_grant_locked(void)
+{
+	if (psm_requested) {
+		state.psm_tau = gprs_timer_decode(psm_rptau, tau_units);
+		state.psm_active_time = gprs_timer_decode(psm_rat, active_time_units);
+	} else {
+		state.psm_tau = -1;
+		state.psm_active_time = -1;
+	}
+}
+
+static void psm_post(void)
+{
+	struct lte_lc_evt evt = {
+		.type = LTE_LC_EVT_PSM_UPDATE,
+	};
+
+	k_mutex_lock(&lock, K_FOREVER);
+	psm_grant_locked();
+	evt.psm_cfg.tau = state.psm_tau;
+	evt.psm_cfg.active_time = state.psm_active_time;
+	k_mutex_unlock(&lock);
+
+	evt_post(&evt);
+}
+#endif
+
+#if defined(CONFIG_LTE_LC_EDRX_MODULE)
+static int mode_idx(enum lte_lc_lte_mode mode)
+{
+	return mode == LTE_LC_LTE_MODE_NBIOT ? 1 : 0;
+}
+
+static void edrx_post(void)
+{
+	struct lte_lc_evt evt = {
+		.type = LTE_LC_EVT_EDRX_UPDATE,
+	};
+	int idx;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	idx = mode_idx(state.lte_mode);
+	evt.edrx_cfg.mode = state.lte_mode;
+	if (edrx_requested) {
+		evt.edrx_cfg.edrx = edrx_ms[edrx_code[idx]] / 1000.0f;
+		evt.edrx_cfg.ptw = (ptw_code[idx] + 1) *
+				   (idx ? PTW_STEP_NBIOT_MS : PTW_STEP_LTEM_MS) / 1000.0f;
+	}
+	k_mutex_unlock(&lock);
+
+	evt_post(&evt);
+}
+#endif
+
+static enum lte_lc_lte_mode lte_mode_pick(void)
+{
+	switch (system_mode) {
+	case LTE_LC_SYSTEM_MODE_NBIOT:
+	case LTE_LC_SYSTEM_MODE_NBIOT_GPS:
+		return LTE_LC_LTE_MODE_NBIOT;
+	case LTE_LC_SYSTEM_MODE_LTEM_NBIOT:
+	case LTE_LC_SYSTEM_MODE_LTEM_NBIOT_GPS:
+		return system_pref == LTE_LC_SYSTEM_MODE_PREFER_NBIOT ||
+		       system_pref == LTE_LC_SYSTEM_MODE_PREFER_NBIOT_PLMN_PRIO ?
+		       LTE_LC_LTE_MODE_NBIOT : LTE_LC_LTE_MODE_LTEM;
+	default:
+		return LTE_LC_LTE_MODE_LTEM;
+	}
+}
+
+static void sleep_exit(void)
+{
+#if defined(CONFIG_LTE_LC_MODEM_SLEEP_MODULE)
+	struct lte_lc_evt evt = {
+		.type = LTE_LC_EVT_MODEM_SLEEP_EXIT,
+		.modem_sleep.type = LTE_LC_MODEM_SLEEP_PSM,
+	};
+#endif
+
+	k_mutex_lock(&lock, K_FOREVER);
+	if (!state.asleep) {
+		k_mutex_unlock(&lock);
+		return;
+	}
+
+	state.asleep = false;
+	k_mutex_unlock(&lock);
+
+	LOG_DBG("Leaving PSM");
+#if defined(CONFIG_LTE_LC_MODEM_SLEEP_MODULE)
+	evt_post(&evt);
+#endif
+}
+
+static void sleep_enter(void)
+{
+#if defined(CONFIG_LTE_LC_MODEM_SLEEP_MODULE)
+	struct lte_lc_evt evt = {
+		.type = LTE_LC_EVT_MODEM_SLEEP_ENTER,
+		.modem_sleep.type = LTE_LC_MODEM_SLEEP_PSM,
+	};
+#endif
+
+	k_mutex_lock(&lock, K_FOREVER);
+	if (!state.registered || state.asleep || state.rrc_connected) {
+		k_mutex_unlock(&lock);
+		return;
+	}
+
+	state.asleep = true;
+	stats.psm_entries++;
+#if defined(CONFIG_LTE_LC_MODEM_SLEEP_MODULE)
+	evt.modem_sleep.time = (int64_t)MAX(state.psm_tau, 0) * MSEC_PER_SEC;
+#endif
+	k_mutex_unlock(&lock);
+
+	LOG_DBG("Entering PSM");
+#if defined(CONFIG_LTE_LC_MODEM_SLEEP_MODULE)
+	evt_post(&evt);
+#endif
+}
+
+static void rrc_set(bool connected)
+{
+	struct lte_lc_evt evt = {
+		.type = LTE_LC_EVT_RRC_UPDATE,
+		.rrc_mode = connected ? LTE_LC_RRC_MODE_CONNECTED : LTE_LC_RRC_MODE_IDLE,
+	};
+	int active_time;
+
+	if (connected) {
+		sleep_exit();
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+	if (connected == state.rrc_connected || (connected && !state.registered)) {
+		k_mutex_unlock(&lock);
+		return;
+	}
+
+	state.rrc_connected = connected;
+	active_time = state.psm_active_time;
+	if (connected) {
+		stats.rrc_connections++;
+	}
+	k_mutex_unlock(&lock);
+
+	evt_post(&evt);
+
+	if (connected) {
+		k_work_cancel_delayable(&sleep_work);
+		k_work_reschedule(&rrc_idle_work, K_MSEC(CONFIG_MODEM_EMU_RRC_INACTIVITY_MS));
+	} else {
+		k_work_cancel_delayable(&rrc_idle_work);
+		if (active_time >= 0) {
+			k_work_reschedule(&sleep_work, K_SECONDS(active_time));
+		}
+	}
+}
+
+/* Registration lost, because of a lost coverage or a deactivated LTE. */
+static void registration_lost(enum lte_lc_nw_reg_status status)
+{
+	bool registered;
+
+	rrc_set(false);
+	k_work_cancel_delayable(&sleep_work);
+
+	k_mutex_lock(&lock, K_FOREVER);
+	registered = state.registered;
+	state.registered = false;
+	state.asleep = false;
+	k_mutex_unlock(&lock);
+
+	if (registered || status == LTE_LC_NW_REG_SEARCHING) {
+		reg_status_post(status);
+	}
+}
+
+static void attach_work_fn(struct k_work *work)
+{
+	struct lte_lc_evt evt = {
+		.type = LTE_LC_EVT_LTE_MODE_UPDATE,
+	};
+#if defined(CONFIG_LTE_LC_EDRX_MODULE)
+	bool edrx;
+#endif
+
+	k_mutex_lock(&lock, K_FOREVER);
+	if (!state.active || !state.coverage || state.registered) {
+		k_mutex_unlock(&lock);
+		return;
+	}
+
+	if (attach_failures_left > 0) {
+		attach_failures_left--;
+		stats.attach_failures++;
+		k_mutex_unlock(&lock);
+		LOG_INF("Attach fails, %u more will fail", attach_failures_left);
+		return;
+	}
+
+	state.registered = true;
+	state.lte_mode = lte_mode_pick();
+	evt.lte_mode = state.lte_mode;
+#if defined(CONFIG_LTE_LC_EDRX_MODULE)
+	edrx = edrx_requested;
+#endif
+	stats.attaches++;
+	k_mutex_unlock(&lock);
+
+	LOG_DBG("Registered, %s", evt.lte_mode == LTE_LC_LTE_MODE_NBIOT ? "NB-IoT" : "LTE-M");
+
+	cell_post();
+	evt_post(&evt);
+	rrc_set(true);
+	reg_status_post(LTE_LC_NW_REG_REGISTERED_HOME);
+#if defined(CONFIG_LTE_LC_PSM_MODULE)
+	psm_post();
+#endif
+#if defined(CONFIG_LTE_LC_EDRX_MODULE)
+	if (edrx) {
+		edrx_post();
+	}
+#endif
+}
+
+static void rrc_idle_work_fn(struct k_work *work)
+{
+	rrc_set(false);
+}
+
+static void sleep_work_fn(struct k_work *work)
+{
+	sleep_enter();
+}
+
+static void cell_set(uint32_t id, uint32_t tac, const struct emu_cell *radio)
+{
+	bool registered;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	state.cell.id = id;
+	state.cell.tac = tac;
+	if (radio != NULL) {
+		state.cell.earfcn = radio->earfcn;
+		state.cell.phys_cell_id = radio->pci;
+		state.band = radio->band;
+	}
+	state.cell.measurement_time = k_uptime_get();
+	registered = state.registered;
+	stats.cell_changes++;
+	k_mutex_unlock(&lock);
+
+	if (registered) {
+		cell_post();
+	}
+}
+
+static void cell_work_fn(struct k_work *work)
+{
+	cell_idx = (cell_idx + 1) % ARRAY_SIZE(cells);
+	cell_set(cells[cell_idx].id, cells[cell_idx].tac, &cells[cell_idx]);
+
+	k_work_reschedule(&cell_work, K_SECONDS(CONFIG_MODEM_EMU_CELL_CHANGE_INTERVAL));
+}
+
+#if defined(CONFIG_LTE_LC_NEIGHBOR_CELL_MEAS_MODULE)
+static void ncellmeas_work_fn(struct k_work *work)
+{
+	struct lte_lc_evt evt = {
+		.type = LTE_LC_EVT_NEIGHBOR_CELL_MEAS,
+		.cells_info.neighbor_cells = ncells,
+	};
+	size_t count = 0;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	evt.cells_info.current_cell = state.cell;
+	if (!state.registered) {
+		evt.cells_info.current_cell.id = LTE_LC_CELL_EUTRAN_ID_INVALID;
+	} else {
+		/* Every other emulated cell is heard, weaker than the serving cell. */
+		for (size_t i = 0; i < ARRAY_SIZE(cells); i++) {
+			if (cells[i].id == state.cell.id) {
+				continue;
+			}
+
+			if (count == ARRAY_SIZE(ncells)) {
+				break;
+			}
+
+			ncells[count] = (struct lte_lc_ncell) {
+				.earfcn = cells[i].earfcn,
+				.phys_cell_id = cells[i].pci,
+				.rsrp = MAX(state.cell.rsrp - 6 * (int16_t)(count + 1), 0),
+				.rsrq = state.cell.rsrq,
+			};
+			count++;
+		}
+	}
+	evt.cells_info.ncells_count = count;
+	k_mutex_unlock(&lock);
+
+	evt_post(&evt);
+}
+#endif
+
+static void activate(void)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+	if (state.active) {
+		k_mutex_unlock(&lock);
+		return;
+	}
+
+	state.active = true;
+	k_mutex_unlock(&lock);
+
+	reg_status_post(LTE_LC_NW_REG_SEARCHING);
+	k_work_reschedule(&attach_work, K_MSEC(CONFIG_MODEM_EMU_ATTACH_MS));
+}
+
+static void deactivate(void)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+	state.active = false;
+	k_mutex_unlock(&lock);
+
+	k_work_cancel_delayable(&attach_work);
+	registration_lost(LTE_LC_NW_REG_NOT_REGISTERED);
+}
+
+static void coverage_set(bool coverage)
+{
+	bool active;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	state.coverage = coverage;
+	active = state.active;
+	k_mutex_unlock(&lock);
+
+	if (!active) {
+		return;
+	}
+
+	if (coverage) {
+		k_work_reschedule(&attach_work, K_MSEC(CONFIG_MODEM_EMU_ATTACH_MS));
+	} else {
+		k_work_cancel_delayable(&attach_work);
+		registration_lost(LTE_LC_NW_REG_SEARCHING);
+	}
+}
+
+static void signal_set(int rsrp_dbm, int snr_db)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+	state.cell.rsrp = CLAMP(rsrp_dbm + RSRP_OFFSET, 0, 97);
+	state.snr_db = CLAMP(snr_db, -24, 103);
+	k_mutex_unlock(&lock);
+}
+
+/* Splits off the next whitespace-separated word of *str. */
+static char *word_next(char **str)
+{
+	char *word = *str;
+	char *end;
+
+	while (*word == ' ') {
+		word++;
+	}
+
+	if (*word == '\0') {
+		return NULL;
+	}
+
+	end = strchr(word, ' ');
+	if (end != NULL) {
+		*end = '\0';
+		*str = end + 1;
+	} else {
+		*str = word + strlen(word);
+	}
+
+	return word;
+}
+
+int modem_emu_exec(const char *cmd)
+{
+	char buf[CMD_LEN_MAX];
+	char *pos = buf;
+	char *name, *arg1, *arg2;
+
+	if (strlen(cmd) >= sizeof(buf)) {
+		return -EINVAL;
+	}
+
+	strcpy(buf, cmd);
+	name = word_next(&pos);
+	arg1 = word_next(&pos);
+	arg2 = word_next(&pos);
+
+	if (name == NULL) {
+		return -EINVAL;
+	}
+
+	LOG_DBG("Command: %s", cmd);
+
+	if (strcmp(name, "coverage") == 0 && arg1 != NULL) {
+		if (strcmp(arg1, "on") != 0 && strcmp(arg1, "off") != 0) {
+			return -EINVAL;
+		}
+
+		coverage_set(strcmp(arg1, "on") == 0);
+	} else if (strcmp(name, "rrc") == 0 && arg1 != NULL) {
+		if (strcmp(arg1, "connected") != 0 && strcmp(arg1, "idle") != 0) {
+			return -EINVAL;
+		}
+
+		rrc_set(strcmp(arg1, "connected") == 0);
+	} else if (strcmp(name, "cell") == 0 && arg2 != NULL) {
+		cell_set(strtoul(arg1, NULL, 0), strtoul(arg2, NULL, 0), NULL);
+	} else if (strcmp(name, "signal") == 0 && arg2 != NULL) {
+		signal_set(strtol(arg1, NULL, 10), strtol(arg2, NULL, 10));
+	} else if (strcmp(name, "sleep") == 0) {
+		k_work_cancel_delayable(&rrc_idle_work);
+		rrc_set(false);
+		k_work_cancel_delayable(&sleep_work);
+		sleep_enter();
+	} else if (strcmp(name, "wake") == 0) {
+		rrc_set(true);
+	} else if (strcmp(name, "button") == 0 && arg1 != NULL) {
+		return modem_emu_button_press(strtoul(arg1, NULL, 10));
+	} else {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/* Runs the script step at script_pos and schedules the next one. */
+static void script_work_fn(struct k_work *work)
+{
+	char step[CMD_LEN_MAX];
+	const char *end;
+	char *cmd;
+	size_t len;
+	int err;
+
+	if (script_pos != NULL) {
+		end = strchr(script_pos, ';');
+		len = end != NULL ? (size_t)(end - script_pos) : strlen(script_pos);
+		if (len >= sizeof(step)) {
+			LOG_ERR("Script step too long: %.*s", (int)len, script_pos);
+			return;
+		}
+
+		memcpy(step, script_pos, len);
+		step[len] = '\0';
+
+		/* Skip the delay */
+		strtoul(step, &cmd, 10);
+		err = modem_emu_exec(cmd);
+		if (err) {
+			LOG_ERR("Script step failed: %s, error: %d", step, err);
+		}
+
+		script_pos = end != NULL ? end + 1 : NULL;
+	} else {
+		script_pos = CONFIG_MODEM_EMU_SCRIPT;
+	}
+
+	if (script_pos != NULL && script_pos[strspn(script_pos, " ")] != '\0') {
+		k_work_reschedule(&script_work, K_MSEC(strtoul(script_pos, NULL, 10)));
+	}
+}
+
+void modem_emu_state_get(struct modem_emu_state *out)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+	*out = state;
+	k_mutex_unlock(&lock);
+}
+
+void modem_emu_stats_get(struct modem_emu_stats *out)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+	*out = stats;
+	k_mutex_unlock(&lock);
+}
+
+#if !defined(CONFIG_MODEM_EMU_DK)
+int modem_emu_button_press(uint8_t button)
+{
+	ARG_UNUSED(button);
+
+	return -ENOTSUP;
+}
+#endif
+
+int nrf_modem_lib_init(void)
+{
+	state.cell = (struct lte_lc_cell) {
+		.mcc = 242,
+		.mnc = 1,
+		.id = cells[0].id,
+		.tac = cells[0].tac,
+		.earfcn = cells[0].earfcn,
+		.phys_cell_id = cells[0].pci,
+		.rsrq = 20,
+	};
+	state.band = cells[0].band;
+	signal_set(-95, state.snr_db);
+
+	LOG_INF("Modem emulator: attach %u ms, RRC inactivity %u ms, %u failed attaches",
+		CONFIG_MODEM_EMU_ATTACH_MS, CONFIG_MODEM_EMU_RRC_INACTIVITY_MS,
+		CONFIG_MODEM_EMU_ATTACH_FAILURES);
+
+	if (CONFIG_MODEM_EMU_CELL_CHANGE_INTERVAL > 0) {
+		k_work_schedule(&cell_work, K_SECONDS(CONFIG_MODEM_EMU_CELL_CHANGE_INTERVAL));
+	}
+
+	if (strlen(CONFIG_MODEM_EMU_SCRIPT) > 0) {
+		k_work_schedule(&script_work, K_NO_WAIT);
+	}
+
+	return 0;
+}
+
+int nrf_modem_lib_shutdown(void)
+{
+	deactivate();
+	k_work_cancel_delayable(&cell_work);
+	k_work_cancel_delayable(&script_work);
+
+	return 0;
+}
+
+void lte_lc_register_handler(lte_lc_evt_handler_t handler)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+	for (size_t i = 0; i < ARRAY_SIZE(handlers); i++) {
+		if (handlers[i] == handler) {
+			break;
+		}
+
+		if (handlers[i] == NULL) {
+			handlers[i] = handler;
+			break;
+		}
+	}
+	k_mutex_unlock(&lock);
+}
+
+int lte_lc_connect_async(lte_lc_evt_handler_t handler)
+{
+	if (handler != NULL) {
+		lte_lc_register_handler(handler);
+	}
+
+	activate();
+
+	return 0;
+}
+
+int lte_lc_func_mode_set(enum lte_lc_func_mode mode)
+{
+	switch (mode) {
+	case LTE_LC_FUNC_MODE_NORMAL:
+	case LTE_LC_FUNC_MODE_ACTIVATE_LTE:
+		activate();
+		break;
+	case LTE_LC_FUNC_MODE_POWER_OFF:
+	case LTE_LC_FUNC_MODE_OFFLINE:
+	case LTE_LC_FUNC_MODE_DEACTIVATE_LTE:
+		deactivate();
+		break;
+	default:
+		/* GNSS is handled by the PVT replay. */
+		break;
+	}
+
+	return 0;
+}
+
+int lte_lc_power_off(void)
+{
+	return lte_lc_func_mode_set(LTE_LC_FUNC_MODE_POWER_OFF);
+}
+
+int lte_lc_system_mode_set(enum lte_lc_system_mode mode,
+			   enum lte_lc_system_mode_preference preference)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+	system_mode = mode;
+	system_pref = preference;
+	k_mutex_unlock(&lock);
+
+	return 0;
+}
+
+int lte_lc_system_mode_get(enum lte_lc_system_mode *mode,
+			   enum lte_lc_system_mode_preference *preference)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+	*mode = system_mode;
+	if (preference != NULL) {
+		*preference = system_pref;
+	}
+	k_mutex_unlock(&lock);
+
+	return 0;
+}
+
+#if defined(CONFIG_LTE_LC_PSM_MODULE)
+int lte_lc_psm_param_set(const char *rptau, const char *rat)
+{
+	if ((rptau != NULL && bits_parse(rptau, 8) < 0) ||
+	    (rat != NULL && bits_parse(rat, 8) < 0)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+	strcpy(psm_rptau, rptau != NULL ? rptau : PSM_RPTAU_DEFAULT);
+	strcpy(psm_rat, rat != NULL ? rat : PSM_RAT_DEFAULT);
+	k_mutex_unlock(&lock);
+
+	return 0;
+}
+
+int lte_lc_psm_req(bool enable)
+{
+	bool registered;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	psm_requested = enable;
+	registered = state.registered;
+	k_mutex_unlock(&lock);
+
+	if (registered) {
+		psm_post();
+	}
+
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_LTE_LC_EDRX_MODULE)
+static int edrx_code_set(enum lte_lc_lte_mode mode, const char *bits, uint8_t codes[2])
+{
+	int code = bits_parse(bits, 4);
+
+	if (code < 0 || (mode != LTE_LC_LTE_MODE_LTEM && mode != LTE_LC_LTE_MODE_NBIOT)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+	codes[mode_idx(mode)] = code;
+	k_mutex_unlock(&lock);
+
+	return 0;
+}
+
+int lte_lc_edrx_param_set(enum lte_lc_lte_mode mode, const char *edrx)
+{
+	return edrx_code_set(mode, edrx, edrx_code);
+}
+
+int lte_lc_ptw_set(enum lte_lc_lte_mode mode, const char *ptw)
+{
+	return edrx_code_set(mode, ptw, ptw_code);
+}
+
+int lte_lc_edrx_req(bool enable)
+{
+	bool registered;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	edrx_requested = enable;
+	registered = state.registered;
+	k_mutex_unlock(&lock);
+
+	if (registered) {
+		edrx_post();
+	}
+
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_LTE_LC_CONN_EVAL_MODULE)
+int lte_lc_conn_eval_params_get(struct lte_lc_conn_eval_params *params)
+{
+	int rsrp_dbm;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	if (!state.registered || state.asleep) {
+		k_mutex_unlock(&lock);
+		return CONN_EVAL_NO_CELL;
+	}
+
+	memset(params, 0, sizeof(*params));
+	params->rrc_state = state.rrc_connected ? LTE_LC_RRC_MODE_CONNECTED :
+						  LTE_LC_RRC_MODE_IDLE;
+	params->rsrp = state.cell.rsrp;
+	params->rsrq = state.cell.rsrq;
+	params->snr = state.snr_db + SNR_OFFSET;
+	params->earfcn = state.cell.earfcn;
+	params->phy_cid = state.cell.phys_cell_id;
+	params->band = state.band;
+	params->mcc = state.cell.mcc;
+	params->mnc = state.cell.mnc;
+	params->cell_id = state.cell.id;
+	params->tau_trig = LTE_LC_CELL_IN_TAI_LIST;
+	rsrp_dbm = state.cell.rsrp - RSRP_OFFSET;
+	k_mutex_unlock(&lock);
+
+	/* Coarse thresholds, a weaker signal needs more repetitions. */
+	params->ce_level = rsrp_dbm >= -110 ? LTE_LC_CE_LEVEL_0 :
+			   rsrp_dbm >= -120 ? LTE_LC_CE_LEVEL_1 : LTE_LC_CE_LEVEL_2;
+	params->energy_estimate = rsrp_dbm >= -85 ? LTE_LC_ENERGY_CONSUMPTION_EFFICIENT :
+				  rsrp_dbm >= -95 ? LTE_LC_ENERGY_CONSUMPTION_REDUCED :
+				  rsrp_dbm >= -105 ? LTE_LC_ENERGY_CONSUMPTION_NORMAL :
+				  rsrp_dbm >= -115 ? LTE_LC_ENERGY_CONSUMPTION_INCREASED :
+						     LTE_LC_ENERGY_CONSUMPTION_EXCESSIVE;
+
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_LTE_LC_NEIGHBOR_CELL_MEAS_MODULE)
+int lte_lc_neighbor_cell_measurement(struct lte_lc_ncellmeas_params *params)
+{
+	ARG_UNUSED(params);
+
+	if (k_work_delayable_is_pending(&ncellmeas_work)) {
+		return -EINPROGRESS;
+	}
+
+	k_work_schedule(&ncellmeas_work, K_MSEC(CONFIG_MODEM_EMU_NCELLMEAS_MS));
+
+	return 0;
+}
+
+int lte_lc_neighbor_cell_measurement_cancel(void)
+{
+	struct lte_lc_evt evt = {
+		.type = LTE_LC_EVT_NEIGHBOR_CELL_MEAS,
+		.cells_info.current_cell.id = LTE_LC_CELL_EUTRAN_ID_INVALID,
+	};
+
+	if (k_work_delayable_is_pending(&ncellmeas_work)) {
+		k_work_cancel_delayable(&ncellmeas_work);
+
+		/* Like the modem, report a measurement that found nothing. */
+		evt_post(&evt);
+	}
+
+	return 0;
+}
+#endif
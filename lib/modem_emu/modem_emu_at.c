@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+#include <nrf_errno.h>
+#include <nrf_modem_at.h>
+#include <modem/lte_lc.h>
+#include <modem/modem_key_mgmt.h>
+#if defined(CONFIG_TLS_CREDENTIALS)
+#include <zephyr/net/tls_credentials.h>
+#endif
+
+#include <cellfund/modem_emu.h>
+
+LOG_MODULE_DECLARE(modem_emu, CONFIG_MODEM_EMU_LOG_LEVEL);
+
+#define CMD_LEN_MAX 128
+#define RESPONSE_LEN_MAX 160
+#define CRED_MAX 8
+
+#define IMEI "351358811331223"
+#define FW_VERSION "mfw_nrf91x1_emu"
+
+struct cred {
+	nrf_sec_tag_t sec_tag;
+	enum modem_key_mgmt_cred_type type;
+	/* As written */
+	uint8_t *data;
+	size_t len;
+	/* As given to the TLS credentials */
+	uint8_t *tls_data;
+	size_t tls_len;
+};
+
+static K_MUTEX_DEFINE(cred_lock);
+static struct cred creds[CRED_MAX];
+
+/* Writes the response to a command that reads something, without the final OK. */
+static int response_get(const char *cmd, char *buf, size_t len)
+{
+	struct modem_emu_state state;
+	char plmn[7];
+
+	modem_emu_state_get(&state);
+	snprintf(plmn, sizeof(plmn), "%03u%02u", state.cell.mcc, state.cell.mnc);
+
+	if (strcmp(cmd, "AT%XMONITOR") == 0) {
+		if (!state.registered) {
+			snprintf(buf, len, "%%XMONITOR: %d", state.active ?
+				 LTE_LC_NW_REG_SEARCHING : LTE_LC_NW_REG_NOT_REGISTERED);
+			return 0;
+		}
+
+		snprintf(buf, len, "%%XMONITOR: %d,\"EMU\",\"EMU\",\"%s\",\"%04X\",%d,%u,"
+			 "\"%08X\",%u,%u,%d,%d,\"\",\"11100000\",\"11100000\",\"01001001\"",
+			 LTE_LC_NW_REG_REGISTERED_HOME, plmn, state.cell.tac, state.lte_mode,
+			 state.band, state.cell.id, state.cell.phys_cell_id, state.cell.earfcn,
+			 state.cell.rsrp, state.snr_db + 24);
+	} else if (strcmp(cmd, "AT+COPS?") == 0) {
+		if (!state.registered) {
+			snprintf(buf, len, "+COPS: 0");
+			return 0;
+		}
+
+		snprintf(buf, len, "+COPS: 0,2,\"%s\",%d", plmn, state.lte_mode);
+	} else if (strcmp(cmd, "AT+CGPADDR=0") == 0) {
+		const char *ipv4 = CONFIG_MODEM_EMU_PDN_IPV4;
+		const char *ipv6 = CONFIG_MODEM_EMU_PDN_IPV6;
+
+		if (!state.registered || (ipv4[0] == '\0' && ipv6[0] == '\0')) {
+			snprintf(buf, len, "+CGPADDR: 0");
+		} else if (ipv4[0] != '\0' && ipv6[0] != '\0') {
+			snprintf(buf, len, "+CGPADDR: 0,\"%s\",\"%s\"", ipv4, ipv6);
+		} else {
+			snprintf(buf, len, "+CGPADDR: 0,\"%s\"", ipv4[0] != '\0' ? ipv4 : ipv6);
+		}
+	} else if (strcmp(cmd, "AT+CGSN") == 0) {
+		snprintf(buf, len, "%s", IMEI);
+	} else if (strcmp(cmd, "AT+CGSN=1") == 0) {
+		snprintf(buf, len, "+CGSN: \"%s\"", IMEI);
+	} else if (strcmp(cmd, "AT+CGMR") == 0) {
+		snprintf(buf, len, "%s", FW_VERSION);
+	} else {
+		buf[0] = '\0';
+		return -ENOENT;
+	}
+
+	return 0;
+}
+
+/* Commands that change the state. The rest are accepted and ignored. */
+static void cmd_apply(const char *cmd)
+{
+	int mode;
+
+	if (sscanf(cmd, "AT+CFUN=%d", &mode) == 1) {
+		(void)lte_lc_func_mode_set(mode);
+	}
+}
+
+static int cmd_vformat(char *buf, size_t len, const char *fmt, va_list args)
+{
+	int ret = vsnprintf(buf, len, fmt, args);
+
+	if (ret < 0 || (size_t)ret >= len) {
+		return -NRF_E2BIG;
+	}
+
+	LOG_DBG("AT: %s", buf);
+
+	return 0;
+}
+
+int nrf_modem_at_printf(const char *fmt, ...)
+{
+	char cmd[CMD_LEN_MAX];
+	va_list args;
+	int err;
+
+	va_start(args, fmt);
+	err = cmd_vformat(cmd, sizeof(cmd), fmt, args);
+	va_end(args);
+
+	if (err) {
+		return err;
+	}
+
+	cmd_apply(cmd);
+
+	return 0;
+}
+
+int nrf_modem_at_scanf(const char *cmd, const char *fmt, ...)
+{
+	char response[RESPONSE_LEN_MAX];
+	va_list args;
+	int ret;
+
+	LOG_DBG("AT: %s", cmd);
+
+	if (response_get(cmd, response, sizeof(response)) != 0) {
+		return -NRF_EBADMSG;
+	}
+
+	va_start(args, fmt);
+	ret = vsscanf(response, fmt, args);
+	va_end(args);
+
+	return ret > 0 ? ret : -NRF_EBADMSG;
+}
+
+int nrf_modem_at_cmd(void *buf, size_t len, const char *fmt, ...)
+{
+	char cmd[CMD_LEN_MAX];
+	char response[RESPONSE_LEN_MAX];
+	va_list args;
+	int ret;
+
+	va_start(args, fmt);
+	ret = cmd_vformat(cmd, sizeof(cmd), fmt, args);
+	va_end(args);
+
+	if (ret) {
+		return ret;
+	}
+
+	cmd_apply(cmd);
+
+	if (response_get(cmd, response, sizeof(response)) == 0) {
+		ret = snprintf(buf, len, "%s\r\nOK\r\n", response);
+	} else {
+		ret = snprintf(buf, len, "OK\r\n");
+	}
+
+	return (size_t)ret < len ? 0 : -NRF_E2BIG;
+}
+
+#if defined(CONFIG_TLS_CREDENTIALS)
+static enum tls_credential_type tls_type(enum modem_key_mgmt_cred_type type)
+{
+	switch (type) {
+	case MODEM_KEY_MGMT_CRED_TYPE_CA_CHAIN:
+		return TLS_CREDENTIAL_CA_CERTIFICATE;
+	case MODEM_KEY_MGMT_CRED_TYPE_PUBLIC_CERT:
+		return TLS_CREDENTIAL_SERVER_CERTIFICATE;
+	case MODEM_KEY_MGMT_CRED_TYPE_PRIVATE_CERT:
+		return TLS_CREDENTIAL_PRIVATE_KEY;
+	case MODEM_KEY_MGMT_CRED_TYPE_PSK:
+		return TLS_CREDENTIAL_PSK;
+	case MODEM_KEY_MGMT_CRED_TYPE_IDENTITY:
+		return TLS_CREDENTIAL_PSK_ID;
+	default:
+		return TLS_CREDENTIAL_NONE;
+	}
+}
+#endif
+
+/* Called with the lock held. */
+static struct cred *cred_find_locked(nrf_sec_tag_t sec_tag, enum modem_key_mgmt_cred_type type)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(creds); i++) {
+		if (creds[i].data != NULL && creds[i].sec_tag == sec_tag &&
+		    creds[i].type == type) {
+			return &creds[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Called with the lock held. */
+static void cred_free_locked(struct cred *cred)
+{
+#if defined(CONFIG_TLS_CREDENTIALS)
+	(void)tls_credential_delete(cred->sec_tag, tls_type(cred->type));
+#endif
+	if (cred->tls_data != cred->data) {
+		k_free(cred->tls_data);
+	}
+	k_free(cred->data);
+	memset(cred, 0, sizeof(*cred));
+}
+
+/* Called with the lock held. The modem takes PSKs as hexadecimal strings and
+ * certificates without a terminator, the TLS credentials want binary PSKs and
+ * terminated PEM certificates.
+ */
+static int cred_tls_add_locked(struct cred *cred)
+{
+	cred->tls_data = cred->data;
+	cred->tls_len = cred->len;
+
+	if (cred->type == MODEM_KEY_MGMT_CRED_TYPE_PSK) {
+		cred->tls_data = k_malloc(cred->len / 2);
+		if (cred->tls_data == NULL) {
+			return -ENOMEM;
+		}
+
+		cred->tls_len = hex2bin(cred->data, cred->len, cred->tls_data, cred->len / 2);
+		if (cred->tls_len == 0) {
+			return -EINVAL;
+		}
+	} else if (cred->type != MODEM_KEY_MGMT_CRED_TYPE_IDENTITY) {
+		/* Include the terminator that data was allocated with */
+		cred->tls_len++;
+	}
+
+#if defined(CONFIG_TLS_CREDENTIALS)
+	return tls_credential_add(cred->sec_tag, tls_type(cred->type), cred->tls_data,
+				  cred->tls_len);
+#else
+	return 0;
+#endif
+}
+
+int modem_key_mgmt_write(nrf_sec_tag_t sec_tag, enum modem_key_mgmt_cred_type cred_type,
+			 const void *buf, size_t len)
+{
+	struct cred *cred;
+	int err = -ENOMEM;
+
+	if (buf == NULL || len == 0) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&cred_lock, K_FOREVER);
+	cred = cred_find_locked(sec_tag, cred_type);
+	if (cred != NULL) {
+		cred_free_locked(cred);
+	}
+
+	cred = NULL;
+	for (size_t i = 0; i < ARRAY_SIZE(creds); i++) {
+		if (creds[i].data == NULL) {
+			cred = &creds[i];
+			break;
+		}
+	}
+
+	if (cred == NULL) {
+		goto out;
+	}
+
+	cred->data = k_malloc(len + 1);
+	if (cred->data == NULL) {
+		goto out;
+	}
+
+	memcpy(cred->data, buf, len);
+	cred->data[len] = '\0';
+	cred->len = len;
+	cred->sec_tag = sec_tag;
+	cred->type = cred_type;
+
+	err = cred_tls_add_locked(cred);
+	if (err) {
+		LOG_ERR("Credential %d of tag %u not usable, error: %d", cred_type, sec_tag, err);
+		cred_free_locked(cred);
+	}
+
+out:
+	k_mutex_unlock(&cred_lock);
+
+	return err;
+}
+
+int modem_key_mgmt_delete(nrf_sec_tag_t sec_tag, enum modem_key_mgmt_cred_type cred_type)
+{
+	struct cred *cred;
+	int err = -ENOENT;
+
+	k_mutex_lock(&cred_lock, K_FOREVER);
+	cred = cred_find_locked(sec_tag, cred_type);
+	if (cred != NULL) {
+		cred_free_locked(cred);
+		err = 0;
+	}
+	k_mutex_unlock(&cred_lock);
+
+	return err;
+}
+
+int modem_key_mgmt_cmp(nrf_sec_tag_t sec_tag, enum modem_key_mgmt_cred_type cred_type,
+		       const void *buf, size_t len)
+{
+	struct cred *cred;
+	int ret;
+
+	k_mutex_lock(&cred_lock, K_FOREVER);
+	cred = cred_find_locked(sec_tag, cred_type);
+	if (cred == NULL) {
+		ret = -ENOENT;
+	} else {
+		ret = cred->len == len && memcmp(cred->data, buf, len) == 0 ? 0 : 1;
+	}
+	k_mutex_unlock(&cred_lock);
+
+	return ret;
+}
+
+int modem_key_mgmt_exists(nrf_sec_tag_t sec_tag, enum modem_key_mgmt_cred_type cred_type,
+			  bool *exists)
+{
+	k_mutex_lock(&cred_lock, K_FOREVER);
+	*exists = cred_find_locked(sec_tag, cred_type) != NULL;
+	k_mutex_unlock(&cred_lock);
+
+	return 0;
+}
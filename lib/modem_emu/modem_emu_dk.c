@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <dk_buttons_and_leds.h>
+
+#include <cellfund/modem_emu.h>
+
+LOG_MODULE_DECLARE(modem_emu, CONFIG_MODEM_EMU_LOG_LEVEL);
+
+#define BUTTON_COUNT 4
+#define LED_COUNT 4
+#define PRESS_MS 100
+
+static K_MUTEX_DEFINE(lock);
+static button_handler_t button_handler;
+static uint32_t button_state;
+static uint32_t button_changed;
+static uint32_t pressed_mask;
+static uint32_t led_state;
+
+static void button_work_fn(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(button_work, button_work_fn);
+
+/* Called with the lock held. */
+static void buttons_set_locked(uint32_t state)
+{
+	button_changed |= button_state ^ state;
+	button_state = state;
+}
+
+/* Presses the pending buttons, then releases them PRESS_MS later, from the
+ * system work queue like the DK library does.
+ */
+static void button_work_fn(struct k_work *work)
+{
+	button_handler_t handler;
+	uint32_t state, changed;
+	bool again;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	if (button_state == 0) {
+		state = pressed_mask;
+		pressed_mask = 0;
+	} else {
+		state = 0;
+	}
+	changed = button_state ^ state;
+	buttons_set_locked(state);
+	handler = button_handler;
+	again = state != 0 || pressed_mask != 0;
+	k_mutex_unlock(&lock);
+
+	if (handler != NULL && changed != 0) {
+		handler(state, changed);
+	}
+
+	if (again) {
+		k_work_reschedule(&button_work, K_MSEC(PRESS_MS));
+	}
+}
+
+int modem_emu_button_press(uint8_t button)
+{
+	if (button < 1 || button > BUTTON_COUNT) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+	pressed_mask |= BIT(button - 1);
+	k_mutex_unlock(&lock);
+
+	LOG_INF("Button %u pressed", button);
+	k_work_schedule(&button_work, K_NO_WAIT);
+
+	return 0;
+}
+
+int dk_buttons_init(button_handler_t handler)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+	button_handler = handler;
+	k_mutex_unlock(&lock);
+
+	return 0;
+}
+
+void dk_read_buttons(uint32_t *state, uint32_t *has_changed)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+	if (state != NULL) {
+		*state = button_state;
+	}
+	if (has_changed != NULL) {
+		*has_changed = button_changed;
+	}
+	button_changed = 0;
+	k_mutex_unlock(&lock);
+}
+
+uint32_t dk_get_buttons(void)
+{
+	uint32_t state;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	state = button_state;
+	k_mutex_unlock(&lock);
+
+	return state;
+}
+
+int dk_leds_init(void)
+{
+	return 0;
+}
+
+int dk_set_leds_state(uint32_t leds_on_mask, uint32_t leds_off_mask)
+{
+	uint32_t old, new;
+
+	if ((leds_on_mask | leds_off_mask) & ~BIT_MASK(LED_COUNT)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+	old = led_state;
+	led_state = (led_state | leds_on_mask) & ~leds_off_mask;
+	new = led_state;
+	k_mutex_unlock(&lock);
+
+	for (uint8_t i = 0; i < LED_COUNT; i++) {
+		if ((old ^ new) & BIT(i)) {
+			LOG_INF("LED %u %s", i + 1, new & BIT(i) ? "on" : "off");
+		}
+	}
+
+	return 0;
+}
+
+int dk_set_leds(uint32_t leds)
+{
+	return dk_set_leds_state(leds, ~leds & BIT_MASK(LED_COUNT));
+}
+
+int dk_set_led(uint8_t led_idx, uint32_t val)
+{
+	if (led_idx >= LED_COUNT) {
+		return -EINVAL;
+	}
+
+	return val ? dk_set_leds_state(BIT(led_idx), 0) : dk_set_leds_state(0, BIT(led_idx));
+}
+
+int dk_set_led_on(uint8_t led_idx)
+{
+	return dk_set_led(led_idx, 1);
+}
+
+int dk_set_led_off(uint8_t led_idx)
+{
+	return dk_set_led(led_idx, 0);
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+
+#include <cellfund/modem_emu.h>
+
+static int cmd_modem_emu_show(const struct shell *sh, size_t argc, char **argv)
+{
+	struct modem_emu_state state;
+	struct modem_emu_stats stats;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	modem_emu_state_get(&state);
+	modem_emu_stats_get(&stats);
+
+	shell_print(sh, "LTE %s, coverage %s, %s, RRC %s%s",
+		    state.active ? "active" : "inactive", state.coverage ? "on" : "off",
+		    state.registered ? "registered" : "not registered",
+		    state.rrc_connected ? "connected" : "idle", state.asleep ? ", in PSM" : "");
+	shell_print(sh, "Cell 0x%08x, TAC 0x%04x, band %u, RSRP %d dBm, SNR %d dB",
+		    state.cell.id, state.cell.tac, state.band, state.cell.rsrp - 140,
+		    state.snr_db);
+	shell_print(sh, "PSM: TAU %d s, active time %d s", state.psm_tau,
+		    state.psm_active_time);
+	shell_print(sh, "Attaches: %u, failed: %u, RRC connections: %u, PSM entries: %u, "
+		    "cell changes: %u", stats.attaches, stats.attach_failures,
+		    stats.rrc_connections, stats.psm_entries, stats.cell_changes);
+
+	return 0;
+}
+
+/* Runs the command line after "modem_emu" as an emulator command. */
+static int cmd_modem_emu_exec(const struct shell *sh, size_t argc, char **argv)
+{
+	char cmd[48];
+	size_t off = 0;
+	int err;
+
+	for (size_t i = 0; i < argc && off < sizeof(cmd); i++) {
+		off += snprintf(&cmd[off], sizeof(cmd) - off, "%s%s", i ? " " : "", argv[i]);
+	}
+
+	if (off >= sizeof(cmd)) {
+		shell_error(sh, "Command too long");
+		return -EINVAL;
+	}
+
+	err = modem_emu_exec(cmd);
+	if (err) {
+		shell_error(sh, "Failed: %d", err);
+	}
+
+	return err;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_modem_emu,
+	SHELL_CMD(show, NULL, "Show the emulated modem state", cmd_modem_emu_show),
+	SHELL_CMD_ARG(coverage, NULL, "Gain or lose coverage: on|off", cmd_modem_emu_exec,
+		      2, 0),
+	SHELL_CMD_ARG(rrc, NULL, "Change the RRC mode: connected|idle", cmd_modem_emu_exec,
+		      2, 0),
+	SHELL_CMD_ARG(cell, NULL, "Move to a cell: <id> <tac>", cmd_modem_emu_exec, 3, 0),
+	SHELL_CMD_ARG(signal, NULL, "Change the link quality: <rsrp_dbm> <snr_db>",
+		      cmd_modem_emu_exec, 3, 0),
+	SHELL_CMD(sleep, NULL, "Enter PSM", cmd_modem_emu_exec),
+	SHELL_CMD(wake, NULL, "Leave PSM", cmd_modem_emu_exec),
+	SHELL_CMD_ARG(button, NULL, "Press a DK button: <n>", cmd_modem_emu_exec, 2, 0),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(modem_emu, &sub_modem_emu, "Modem emulator", NULL);
@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+"""Lossy UDP proxy with latency, for the native_sim builds.
+
+Forwards datagrams between the clients and a server, dropping each one with
+the given probability and delaying it by the given latency plus a uniform
+jitter, in both directions. Datagrams overtake each other when the jitter is
+larger than the time between them. Put it in front of emu_server.py to see
+how CONFIG_COAP_RTO adapts, for example:
+
+    emu_server.py &
+    udp_proxy.py --port 5783 --server 5683 --loss 0.2 --latency 400 --jitter 800
+
+and build with CONFIG_COAP_SERVER_PORT=5783.
+"""
+
+import argparse
+import heapq
+import random
+import selectors
+import socket
+import time
+
+
+class Proxy:
+    def __init__(self, args):
+        self.args = args
+        self.server = (args.server_host, args.server)
+        self.sel = selectors.DefaultSelector()
+        self.queue = []
+        self.seq = 0
+        self.stats = {'forwarded': 0, 'dropped': 0}
+
+        self.sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        self.sock.bind(('0.0.0.0', args.port))
+        self.sel.register(self.sock, selectors.EVENT_READ, None)
+        # One upstream socket per client, so replies find their way back
+        self.upstream = {}
+
+    def schedule(self, sock, data, addr):
+        if random.random() < self.args.loss:
+            self.stats['dropped'] += 1
+            return
+
+        delay = (self.args.latency + random.uniform(0, self.args.jitter)) / 1000
+        self.seq += 1
+        heapq.heappush(self.queue, (time.monotonic() + delay, self.seq, sock, data, addr))
+
+    def receive(self, sock, client):
+        data, addr = sock.recvfrom(2048)
+        if client is None:
+            upstream = self.upstream.get(addr)
+            if upstream is None:
+                upstream = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+                self.sel.register(upstream, selectors.EVENT_READ, addr)
+                self.upstream[addr] = upstream
+                print(f'New client {addr[0]}:{addr[1]}')
+            self.schedule(upstream, data, self.server)
+        else:
+            self.schedule(self.sock, data, client)
+
+    def run(self):
+        print(f'Forwarding UDP port {self.args.port} to {self.server[0]}:{self.server[1]}, '
+              f'{self.args.loss:.0%} loss, {self.args.latency} ms latency, '
+              f'{self.args.jitter} ms jitter')
+
+        while True:
+            timeout = None
+            if self.queue:
+                timeout = max(self.queue[0][0] - time.monotonic(), 0)
+
+            for key, _ in self.sel.select(timeout):
+                self.receive(key.fileobj, key.data)
+
+            now = time.monotonic()
+            while self.queue and self.queue[0][0] <= now:
+                _, _, sock, data, addr = heapq.heappop(self.queue)
+                sock.sendto(data, addr)
+                self.stats['forwarded'] += 1
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('--port', type=int, default=5783, help='port to listen on')
+    parser.add_argument('--server', type=int, default=5683, help='server port')
+    parser.add_argument('--server-host', default='127.0.0.1')
+    parser.add_argument('--loss', type=float, default=0.0,
+                        help='probability that a datagram is dropped, 0 to 1')
+    parser.add_argument('--latency', type=int, default=0, help='one-way latency, in ms')
+    parser.add_argument('--jitter', type=int, default=0,
+                        help='largest random latency added, in ms')
+    parser.add_argument('--seed', type=int, help='seed of the loss and jitter')
+    args = parser.parse_args()
+
+    random.seed(args.seed)
+    proxy = Proxy(args)
+    try:
+        proxy.run()
+    except KeyboardInterrupt:
+        print(f'{proxy.stats["forwarded"]} forwarded, {proxy.stats["dropped"]} dropped')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <nrf_modem_gnss.h>
+
+#include <cellfund/geo.h>
+#include <cellfund/pos_filter.h>
+
+/* Kalman gains are Q16. */
+#define GAIN_SHIFT 16
+
+/* Restart the filter when a fix is further than 100 km from the origin. */
+#define MAX_OFFSET_MM 100000000LL
+
+/* Covariance limits. They keep every intermediate product within 64 bits for
+ * gaps up to 600 s and process noise up to 10 m/s^2.
+ */
+#define P00_MAX 100000000000000LL
+#define P01_MAX 1000000000000LL
+#define P11_MAX 10000000000LL
+
+#define MIN_ACCURACY_MM 1000
+#define MIN_SPEED_ACCURACY_MM_S 100
+
+#define ACCEL_VAR ((int64_t)CONFIG_POS_FILTER_ACCEL_NOISE * CONFIG_POS_FILTER_ACCEL_NOISE)
+
+/* Days since 1970-01-01 of a civil date. */
+static int64_t days_from_civil(int32_t year, uint32_t month, uint32_t day)
+{
+	int32_t era;
+	uint32_t yoe, doy, doe;
+
+	year -= month <= 2;
+	era = (year >= 0 ? year : year - 399) / 400;
+	yoe = (uint32_t)(year - era * 400);
+	doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+	doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+	return (int64_t)era * 146097 + doe - 719468;
+}
+
+static int64_t gnss_time_ms(const struct nrf_modem_gnss_datetime *dt)
+{
+	int64_t days = days_from_civil(dt->year, dt->month, dt->day);
+
+	return (((days * 24 + dt->hour) * 60 + dt->minute) * 60 + dt->seconds) * 1000 + dt->ms;
+}
+
+static void axis_init(struct pos_filter_axis *axis, int64_t pos, int64_t vel,
+		      int64_t r_pos, int64_t r_vel)
+{
+	axis->pos = pos;
+	axis->vel = vel;
+	axis->p00 = MIN(r_pos, P00_MAX);
+	axis->p01 = 0;
+	axis->p11 = MIN(r_vel, P11_MAX);
+}
+
+static void axis_clamp(struct pos_filter_axis *axis)
+{
+	axis->p00 = CLAMP(axis->p00, 1, P00_MAX);
+	axis->p01 = CLAMP(axis->p01, -P01_MAX, P01_MAX);
+	axis->p11 = CLAMP(axis->p11, 1, P11_MAX);
+}
+
+/* Constant-velocity prediction with white noise acceleration. Divisions are
+ * interleaved with the multiplications to stay within 64 bits.
+ */
+static void axis_predict(struct pos_filter_axis *axis, int64_t dt_ms)
+{
+	int64_t p11_dt = axis->p11 * dt_ms / 1000;
+	int64_t q_dt2 = ACCEL_VAR * dt_ms / 1000 * dt_ms / 1000;
+	int64_t q_dt3_2 = q_dt2 / 2000 * dt_ms;
+	int64_t q_dt4_4 = q_dt3_2 / 2000 * dt_ms;
+
+	axis->pos += axis->vel * dt_ms / 1000;
+	axis->p00 += 2 * axis->p01 * dt_ms / 1000 + p11_dt * dt_ms / 1000 + q_dt4_4;
+	axis->p01 += p11_dt + q_dt3_2;
+	axis->p11 += q_dt2;
+
+	axis_clamp(axis);
+}
+
+/* Scalar measurement update of state @p idx, 0 for position and 1 for velocity. */
+static void axis_update(struct pos_filter_axis *axis, int idx, int64_t meas, int64_t var)
+{
+	/* Row idx of the covariance, which by symmetry is also column idx. */
+	int64_t pi0 = idx == 0 ? axis->p00 : axis->p01;
+	int64_t pi1 = idx == 0 ? axis->p01 : axis->p11;
+	int64_t innov = meas - (idx == 0 ? axis->pos : axis->vel);
+	int64_t s = (idx == 0 ? axis->p00 : axis->p11) + var;
+	int64_t k0 = (pi0 << GAIN_SHIFT) / s;
+	int64_t k1 = (pi1 << GAIN_SHIFT) / s;
+
+	axis->pos += (k0 * innov) >> GAIN_SHIFT;
+	axis->vel += (k1 * innov) >> GAIN_SHIFT;
+
+	axis->p00 -= (k0 * pi0) >> GAIN_SHIFT;
+	axis->p01 -= (k0 * pi1) >> GAIN_SHIFT;
+	axis->p11 -= (k1 * pi1) >> GAIN_SHIFT;
+
+	axis_clamp(axis);
+}
+
+void pos_filter_reset(struct pos_filter *filter)
+{
+	memset(filter, 0, sizeof(*filter));
+}
+
+int pos_filter_update(struct pos_filter *filter,
+		      const struct nrf_modem_gnss_pvt_data_frame *pvt,
+		      struct pos_filter_output *out)
+{
+	int32_t lat_e7, lon_e7, speed, heading, vel_north, vel_east, acc;
+	int64_t time_ms, dt_ms, north, east, r_pos, r_vel;
+
+	if (!(pvt->flags & NRF_MODEM_GNSS_PVT_FLAG_FIX_VALID)) {
+		return -EINVAL;
+	}
+
+	/* The only double-precision operations, converting the fix to integers. */
+	lat_e7 = (int32_t)(pvt->latitude * 1e7);
+	lon_e7 = (int32_t)(pvt->longitude * 1e7);
+
+	speed = (int32_t)(pvt->speed * 1000.0f);
+	heading = (int32_t)(pvt->heading * 10.0f);
+	vel_north = ((int64_t)speed * geo_cos_q15(heading)) >> 15;
+	vel_east = ((int64_t)speed * geo_sin_q15(heading)) >> 15;
+
+	acc = MAX((int32_t)(pvt->accuracy * 1000.0f), MIN_ACCURACY_MM);
+	r_pos = (int64_t)acc * acc;
+	acc = MAX((int32_t)(pvt->speed_accuracy * 1000.0f), MIN_SPEED_ACCURACY_MM_S);
+	r_vel = (int64_t)acc * acc;
+
+	time_ms = gnss_time_ms(&pvt->datetime);
+	dt_ms = time_ms - filter->time_ms;
+
+	geo_to_local(&filter->frame, lat_e7, lon_e7, &north, &east);
+
+	if (!filter->valid || dt_ms < 0 || dt_ms > CONFIG_POS_FILTER_MAX_GAP * 1000LL ||
+	    north > MAX_OFFSET_MM || north < -MAX_OFFSET_MM ||
+	    east > MAX_OFFSET_MM || east < -MAX_OFFSET_MM) {
+		/* Restart from the measurement, with the origin at the fix. */
+		geo_frame_init(&filter->frame, lat_e7, lon_e7);
+		axis_init(&filter->north, 0, vel_north, r_pos, r_vel);
+		axis_init(&filter->east, 0, vel_east, r_pos, r_vel);
+		filter->valid = true;
+	} else {
+		axis_predict(&filter->north, dt_ms);
+		axis_predict(&filter->east, dt_ms);
+
+		axis_update(&filter->north, 0, north, r_pos);
+		axis_update(&filter->east, 0, east, r_pos);
+		axis_update(&filter->north, 1, vel_north, r_vel);
+		axis_update(&filter->east, 1, vel_east, r_vel);
+	}
+
+	filter->time_ms = time_ms;
+
+	geo_from_local(&filter->frame, filter->north.pos, filter->east.pos,
+		       &out->lat_e7, &out->lon_e7);
+	out->accuracy_mm = geo_isqrt64(filter->north.p00 + filter->east.p00);
+	out->vel_north_mm_s = (int32_t)filter->north.vel;
+	out->vel_east_mm_s = (int32_t)filter->east.vel;
+
+	return 0;
+}
+
+void pos_filter_output_to_pvt(const struct pos_filter_output *out,
+			      struct nrf_modem_gnss_pvt_data_frame *pvt)
+{
+	pvt->latitude = out->lat_e7 / 1e7;
+	pvt->longitude = out->lon_e7 / 1e7;
+	pvt->accuracy = out->accuracy_mm / 1000.0f;
+}
@@ -0,0 +1,99 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+"""Turn a GNSS track written as CSV into entries of a PVT recording.
+
+The entries are written as C initializers of struct pvt_recording_entry, so
+the compiler of the build lays them out and the track replays on any target.
+CONFIG_PVT_REPLAY_FILE runs this for files that end in .csv.
+
+Each line is one GNSS event, with the columns:
+
+    time_ms    time since the start of the track
+    event      NRF_MODEM_GNSS_EVT_ name without the prefix, for example FIX
+    latitude, longitude, altitude, accuracy, speed, heading
+               PVT fields, all empty for an event without a PVT frame
+    datetime   UTC as 2026-05-04T08:00:01.000, or empty
+    flags      NRF_MODEM_GNSS_PVT_FLAG_ names without the prefix, joined by |
+    sats       tracked/used satellites, for example 7/5
+
+Lines that start with # are comments.
+
+Usage: pvt_csv.py track.csv entries.inc
+"""
+
+import csv
+import os
+import sys
+from datetime import datetime
+
+# GPS PRNs given to the satellites of a line, in order
+SVS = (2, 5, 7, 12, 13, 15, 18, 20, 24, 29, 30, 31)
+# GPS L1 C/A
+SIGNAL_GPS_L1_CA = 1
+
+
+def sv_init(idx, used):
+    flags = 'NRF_MODEM_GNSS_SV_FLAG_USED_IN_FIX' if idx < used else '0'
+    return (f'{{ .sv = {SVS[idx]}, .signal = {SIGNAL_GPS_L1_CA}, .cn0 = {420 - 15 * idx}, '
+            f'.elevation = {80 - 6 * idx}, .azimuth = {(37 * idx) % 360}, .flags = {flags} }}')
+
+
+def pvt_init(row):
+    lat, lon, alt, acc, speed, heading, dt, flags, sats = row
+    fields = [f'.latitude = {float(lat)!r}', f'.longitude = {float(lon)!r}',
+              f'.altitude = {float(alt)!r}f', f'.accuracy = {float(acc)!r}f',
+              f'.speed = {float(speed)!r}f', f'.heading = {float(heading)!r}f']
+
+    if dt:
+        t = datetime.fromisoformat(dt)
+        fields.append(f'.datetime = {{ .year = {t.year}, .month = {t.month}, .day = {t.day}, '
+                      f'.hour = {t.hour}, .minute = {t.minute}, .seconds = {t.second}, '
+                      f'.ms = {t.microsecond // 1000} }}')
+
+    if flags:
+        fields.append('.flags = ' + ' | '.join(f'NRF_MODEM_GNSS_PVT_FLAG_{f.strip()}'
+                                               for f in flags.split('|')))
+
+    tracked, used = (int(n) for n in (sats or '0/0').split('/'))
+    if tracked > len(SVS) or used > tracked:
+        raise ValueError(f'Bad satellite count {sats}')
+    if tracked:
+        fields.append('.sv = {\n\t\t\t' +
+                      ',\n\t\t\t'.join(sv_init(i, used) for i in range(tracked)) + ' }')
+
+    return '{\n\t\t' + ',\n\t\t'.join(fields) + ' }'
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(__doc__)
+
+    entries = []
+    with open(sys.argv[1], newline='') as track:
+        rows = csv.reader(line for line in track if line.strip() and not line.startswith('#'))
+        for num, row in enumerate(rows, 1):
+            if len(row) != 11:
+                sys.exit(f'{sys.argv[1]}: event {num} has {len(row)} columns, not 11')
+
+            time_ms, event = int(row[0]), row[1].strip()
+            entry = f'{{ .time_ms = {time_ms}, .event = NRF_MODEM_GNSS_EVT_{event}'
+            if row[2]:
+                entry += f', .has_pvt = 1,\n\t.pvt = {pvt_init(row[2:])}'
+            entries.append(entry + ' },\n')
+
+    if not entries:
+        sys.exit(f'{sys.argv[1]}: no events')
+
+    os.makedirs(os.path.dirname(os.path.abspath(sys.argv[2])), exist_ok=True)
+    with open(sys.argv[2], 'w') as out:
+        out.write(f'/* Generated by pvt_csv.py from {os.path.basename(sys.argv[1])} */\n')
+        out.writelines(entries)
+
+
+if __name__ == '__main__':
+    main()
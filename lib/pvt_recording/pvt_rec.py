@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+"""Turn PVTREC console lines from a CONFIG_PVT_RECORD build into a PVT recording.
+
+Usage: pvt_rec.py console.log recording.bin
+"""
+
+import re
+import struct
+import sys
+
+PVT_RECORDING_MAGIC = 0x52545650
+PVT_RECORDING_VERSION = 1
+
+LINE_RE = re.compile(r'PVTREC (\d+) (\d+) ([0-9a-f]+)')
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(__doc__)
+
+    entries = {}
+    with open(sys.argv[1], errors='replace') as log:
+        for line in log:
+            match = LINE_RE.search(line)
+            if not match:
+                continue
+            seq, offset, data = match.groups()
+            entries.setdefault(int(seq), {})[int(offset)] = bytes.fromhex(data)
+
+    blobs = []
+    for seq in sorted(entries):
+        chunks = entries[seq]
+        blob = b''
+        for offset in sorted(chunks):
+            if offset != len(blob):
+                break
+            blob += chunks[offset]
+        blobs.append(blob)
+
+    if not blobs:
+        sys.exit('No PVTREC lines found')
+
+    # Lines may be lost at the start or end of a capture, keep whole entries only.
+    entry_size = max(len(blob) for blob in blobs)
+    complete = [blob for blob in blobs if len(blob) == entry_size]
+    if len(complete) != len(blobs):
+        print(f'Skipped {len(blobs) - len(complete)} incomplete entries', file=sys.stderr)
+
+    with open(sys.argv[2], 'wb') as out:
+        out.write(struct.pack('<IHH', PVT_RECORDING_MAGIC, PVT_RECORDING_VERSION, entry_size))
+        for blob in complete:
+            out.write(blob)
+
+    print(f'Wrote {len(complete)} entries of {entry_size} bytes')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#include <cellfund/pvt_recording.h>
+
+/* Bytes per console line. Each line carries the entry sequence number and
+ * offset, so lines interleaved with other output can still be reassembled.
+ */
+#define LINE_BYTES 32
+
+static uint32_t entry_seq;
+static int64_t start_time;
+
+void pvt_record_add(int event, const struct nrf_modem_gnss_pvt_data_frame *pvt)
+{
+	struct pvt_recording_entry entry = { 0 };
+	const uint8_t *data = (const uint8_t *)&entry;
+	char hex[2 * LINE_BYTES + 1];
+
+	if (entry_seq == 0) {
+		start_time = k_uptime_get();
+	}
+
+	entry.time_ms = (uint32_t)(k_uptime_get() - start_time);
+	entry.event = event;
+	if (pvt != NULL) {
+		entry.has_pvt = 1;
+		entry.pvt = *pvt;
+	}
+
+	for (size_t off = 0; off < sizeof(entry); off += LINE_BYTES) {
+		size_t len = MIN(LINE_BYTES, sizeof(entry) - off);
+
+		bin2hex(data + off, len, hex, sizeof(hex));
+		printk("PVTREC %u %zu %s\n", entry_seq, off, hex);
+	}
+
+	entry_seq++;
+}
@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <nrf_modem_gnss.h>
+
+#include <cellfund/pvt_recording.h>
+#if defined(CONFIG_GNSS_PIPELINE)
+#include <cellfund/gnss_pipeline.h>
+#endif
+
+LOG_MODULE_REGISTER(pvt_replay, CONFIG_PVT_RECORDING_LOG_LEVEL);
+
+#if defined(PVT_REPLAY_EMBEDDED)
+static const uint8_t embedded[] = {
+#include "pvt_replay_data.inc"
+};
+
+static const uint8_t *recording = embedded;
+static size_t recording_len = sizeof(embedded);
+#elif defined(PVT_REPLAY_EMBEDDED_TRACK)
+/* A track written as CSV, laid out by the compiler. The header is added at boot. */
+static const struct pvt_recording_entry track[] = {
+#include "pvt_replay_track.inc"
+};
+
+static struct {
+	struct pvt_recording_header header;
+	struct pvt_recording_entry entries[ARRAY_SIZE(track)];
+} embedded;
+
+BUILD_ASSERT(offsetof(__typeof__(embedded), entries) == sizeof(struct pvt_recording_header),
+	     "Recording must not be padded");
+
+static const uint8_t *recording = (const uint8_t *)&embedded;
+static size_t recording_len = sizeof(embedded);
+
+static int track_init(void)
+{
+	embedded.header = (struct pvt_recording_header){
+		.magic = PVT_RECORDING_MAGIC,
+		.version = PVT_RECORDING_VERSION,
+		.entry_size = sizeof(struct pvt_recording_entry),
+	};
+	memcpy(embedded.entries, track, sizeof(track));
+
+	return 0;
+}
+
+SYS_INIT(track_init, APPLICATION, 0);
+#else
+static const uint8_t *recording;
+static size_t recording_len;
+#endif
+
+#define ENTRY_OFFSET(idx) \
+	(sizeof(struct pvt_recording_header) + (idx) * sizeof(struct pvt_recording_entry))
+
+static nrf_modem_gnss_event_handler_type_t event_handler;
+static size_t entry_count;
+static size_t next_entry;
+static uint32_t fixes;
+
+/* Entry of the latest event, returned by nrf_modem_gnss_read() */
+static struct pvt_recording_entry current;
+
+static void replay_timer_handler(struct k_timer *timer);
+static void report_work_fn(struct k_work *work);
+
+static K_TIMER_DEFINE(replay_timer, replay_timer_handler, NULL);
+static K_WORK_DELAYABLE_DEFINE(report_work, report_work_fn);
+
+static uint32_t entry_time_get(size_t idx)
+{
+	uint32_t time_ms;
+
+	memcpy(&time_ms, &recording[ENTRY_OFFSET(idx) +
+				    offsetof(struct pvt_recording_entry, time_ms)],
+	       sizeof(time_ms));
+
+	return time_ms;
+}
+
+static void report_work_fn(struct k_work *work)
+{
+	LOG_INF("Replay finished: %zu events, %u fixes", entry_count, fixes);
+
+#if defined(CONFIG_GNSS_PIPELINE)
+	struct gnss_pipeline_stats stats;
+
+	gnss_pipeline_stats_get(&stats);
+	LOG_INF("Pipeline: %u processed, %u coalesced, %u dropped",
+		stats.processed, stats.coalesced, stats.dropped);
+	LOG_INF("Handler time per event: %u us average, %u us max",
+		stats.processed ? stats.handler_us_total / stats.processed : 0,
+		stats.handler_us_max);
+#endif
+}
+
+static void replay_schedule_next(void)
+{
+	uint32_t next_time;
+
+	if (next_entry >= entry_count) {
+		if (!IS_ENABLED(CONFIG_PVT_REPLAY_LOOP)) {
+			/* Give the application time to process the last event. */
+			k_work_schedule(&report_work, K_SECONDS(1));
+			return;
+		}
+
+		next_entry = 0;
+	}
+
+	next_time = entry_time_get(next_entry);
+	if (next_time < current.time_ms) {
+		/* Looping back to the start of the recording. */
+		next_time = current.time_ms;
+	}
+
+	k_timer_start(&replay_timer,
+		      K_MSEC((next_time - current.time_ms) / CONFIG_PVT_REPLAY_SPEEDUP),
+		      K_NO_WAIT);
+}
+
+static void replay_timer_handler(struct k_timer *timer)
+{
+	memcpy(&current, &recording[ENTRY_OFFSET(next_entry)], sizeof(current));
+	next_entry++;
+
+	if (current.has_pvt && (current.pvt.flags & NRF_MODEM_GNSS_PVT_FLAG_FIX_VALID)) {
+		fixes++;
+	}
+
+	if (event_handler != NULL) {
+		event_handler(current.event);
+	}
+
+	replay_schedule_next();
+}
+
+int32_t nrf_modem_gnss_event_handler_set(nrf_modem_gnss_event_handler_type_t handler)
+{
+	event_handler = handler;
+
+	return 0;
+}
+
+int32_t nrf_modem_gnss_read(void *buf, int32_t buf_len, int type)
+{
+	if (type != NRF_MODEM_GNSS_DATA_PVT || buf_len < (int32_t)sizeof(current.pvt)) {
+		return -EINVAL;
+	}
+
+	if (!current.has_pvt) {
+		return -ENOMSG;
+	}
+
+	memcpy(buf, &current.pvt, sizeof(current.pvt));
+
+	return 0;
+}
+
+int32_t nrf_modem_gnss_start(void)
+{
+	struct pvt_recording_header header;
+
+	if (recording_len < sizeof(header)) {
+		LOG_ERR("Recording is empty");
+		return -EINVAL;
+	}
+
+	memcpy(&header, recording, sizeof(header));
+	if (header.magic != PVT_RECORDING_MAGIC || header.version != PVT_RECORDING_VERSION) {
+		LOG_ERR("Not a PVT recording");
+		return -EINVAL;
+	}
+
+	if (header.entry_size != sizeof(struct pvt_recording_entry)) {
+		LOG_ERR("Recording entry size %u does not match %zu",
+			header.entry_size, sizeof(struct pvt_recording_entry));
+		return -EINVAL;
+	}
+
+	entry_count = (recording_len - sizeof(header)) / header.entry_size;
+	next_entry = 0;
+	fixes = 0;
+	memset(&current, 0, sizeof(current));
+
+	LOG_INF("Replaying %zu GNSS events", entry_count);
+	replay_schedule_next();
+
+	return 0;
+}
+
+void pvt_replay_recording_set(const void *data, size_t len)
+{
+	k_timer_stop(&replay_timer);
+
+	recording = data;
+	recording_len = len;
+}
+
+int32_t nrf_modem_gnss_stop(void)
+{
+	k_timer_stop(&replay_timer);
+
+	return 0;
+}
+
+/* The recording already reflects the configuration it was made with. */
+
+int32_t nrf_modem_gnss_fix_interval_set(uint16_t fix_interval)
+{
+	return 0;
+}
+
+int32_t nrf_modem_gnss_fix_retry_set(uint16_t fix_retry)
+{
+	return 0;
+}
+
+int32_t nrf_modem_gnss_use_case_set(uint8_t use_case)
+{
+	return 0;
+}
+
+int32_t nrf_modem_gnss_prio_mode_enable(void)
+{
+	return 0;
+}
+
+int32_t nrf_modem_gnss_timing_source_set(uint8_t timing_source)
+{
+	return 0;
+}
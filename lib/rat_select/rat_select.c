@@ -0,0 +1,364 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/settings/settings.h>
+#include <modem/lte_lc.h>
+#include <nrf_modem_at.h>
+
+#include <cellfund/rat_select.h>
+
+LOG_MODULE_REGISTER(rat_select, CONFIG_RAT_SELECT_LOG_LEVEL);
+
+#define SETTINGS_TREE "rat_sel"
+#define SETTINGS_LAST_KEY "last"
+
+/* Access technology values reported by AT+COPS. */
+#define ACT_LTEM 7
+#define ACT_NBIOT 9
+
+/* Weight of new samples in the rolling averages, 1/2^N. */
+#define AVG_SHIFT 2
+
+struct plmn_entry {
+	/* MCC and MNC digits as a number, 0 if the entry is unused. */
+	uint32_t plmn;
+	uint32_t last_used;
+	uint32_t attaches;
+	struct rat_select_stats stats[RAT_SELECT_RAT_COUNT];
+};
+
+static const char *const rat_names[] = {
+	[RAT_SELECT_LTEM] = "LTE-M",
+	[RAT_SELECT_NBIOT] = "NB-IoT",
+};
+
+static K_MUTEX_DEFINE(lock);
+static struct plmn_entry entries[CONFIG_RAT_SELECT_MAX_PLMNS];
+static uint32_t use_counter;
+static uint32_t current_plmn;
+
+/* Attach measurement, written from the LTE event handler. */
+static int64_t attach_start;
+static bool attach_pending;
+static uint32_t attach_ms;
+
+static struct plmn_entry *entry_find(uint32_t plmn)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(entries); i++) {
+		if (plmn != 0 && entries[i].plmn == plmn) {
+			return &entries[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Finds the entry of a network, replacing the least recently used one if it
+ * is not known.
+ */
+static struct plmn_entry *entry_get(uint32_t plmn)
+{
+	struct plmn_entry *entry = entry_find(plmn);
+
+	if (entry == NULL) {
+		entry = &entries[0];
+		for (size_t i = 1; i < ARRAY_SIZE(entries); i++) {
+			if (entries[i].last_used < entry->last_used) {
+				entry = &entries[i];
+			}
+		}
+
+		memset(entry, 0, sizeof(*entry));
+		entry->plmn = plmn;
+	}
+
+	entry->last_used = ++use_counter;
+
+	return entry;
+}
+
+static void avg_update(uint32_t *avg, uint32_t val, bool first)
+{
+	if (first) {
+		*avg = val;
+	} else {
+		*avg = (int32_t)*avg + (((int32_t)val - (int32_t)*avg) >> AVG_SHIFT);
+	}
+}
+
+/* Expected radio-on time of an upload, in ms. The goodput is measured over
+ * whole exchanges, so the payload time already includes the round trip.
+ */
+static uint32_t rat_cost(const struct rat_select_stats *stats)
+{
+	return stats->attach_ms +
+	       CONFIG_RAT_SELECT_PAYLOAD_BYTES * MSEC_PER_SEC / MAX(stats->goodput, 1);
+}
+
+/* The cheapest technology, or the first one that has not been measured. */
+static enum rat_select_rat rat_best(const struct plmn_entry *entry)
+{
+	const struct rat_select_stats *ltem = &entry->stats[RAT_SELECT_LTEM];
+	const struct rat_select_stats *nbiot = &entry->stats[RAT_SELECT_NBIOT];
+
+	if (ltem->samples == 0) {
+		return RAT_SELECT_LTEM;
+	}
+
+	if (nbiot->samples == 0) {
+		return RAT_SELECT_NBIOT;
+	}
+
+	return rat_cost(ltem) <= rat_cost(nbiot) ? RAT_SELECT_LTEM : RAT_SELECT_NBIOT;
+}
+
+static enum rat_select_rat rat_pick(const struct plmn_entry *entry)
+{
+	const struct rat_select_stats *ltem = &entry->stats[RAT_SELECT_LTEM];
+	const struct rat_select_stats *nbiot = &entry->stats[RAT_SELECT_NBIOT];
+	enum rat_select_rat best = rat_best(entry);
+
+	if (ltem->samples == 0 || nbiot->samples == 0) {
+		return best;
+	}
+
+	LOG_DBG("Cost on %u: LTE-M %u ms, NB-IoT %u ms", entry->plmn,
+		rat_cost(ltem), rat_cost(nbiot));
+
+	if (entry->attaches % CONFIG_RAT_SELECT_EXPLORE_INTERVAL == 0) {
+		return best == RAT_SELECT_LTEM ? RAT_SELECT_NBIOT : RAT_SELECT_LTEM;
+	}
+
+	return best;
+}
+
+#if defined(CONFIG_RAT_SELECT_SETTINGS)
+static int settings_set(const char *key, size_t len, settings_read_cb read_cb, void *cb_arg)
+{
+	struct plmn_entry *entry;
+	struct plmn_entry loaded;
+	ssize_t ret;
+
+	if (strcmp(key, SETTINGS_LAST_KEY) == 0) {
+		ret = read_cb(cb_arg, &current_plmn, sizeof(current_plmn));
+		return ret < 0 ? ret : 0;
+	}
+
+	if (len != sizeof(loaded)) {
+		return -EINVAL;
+	}
+
+	ret = read_cb(cb_arg, &loaded, sizeof(loaded));
+	if (ret < 0) {
+		return ret;
+	}
+
+	entry = entry_get(loaded.plmn);
+	*entry = loaded;
+	use_counter = MAX(use_counter, entry->last_used);
+
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(rat_select, SETTINGS_TREE, NULL, settings_set, NULL, NULL);
+
+/* Uptime of the last save, in ms */
+static int64_t saved_at;
+
+/* Saves right away if @p force or @p plmn_changed is set, otherwise at most
+ * every CONFIG_RAT_SELECT_SAVE_INTERVAL seconds to limit flash wear.
+ */
+static void entry_save(const struct plmn_entry *entry, bool plmn_changed, bool force)
+{
+	char key[sizeof(SETTINGS_TREE "/") + 10];
+	int64_t now = k_uptime_get();
+	int err;
+
+	if (!force && !plmn_changed && saved_at != 0 &&
+	    now - saved_at < CONFIG_RAT_SELECT_SAVE_INTERVAL * MSEC_PER_SEC) {
+		return;
+	}
+
+	saved_at = now;
+
+	snprintf(key, sizeof(key), SETTINGS_TREE "/%u", entry->plmn);
+
+	err = settings_save_one(key, entry, sizeof(*entry));
+	if (err) {
+		LOG_WRN("Failed to save statistics, error: %d", err);
+	}
+
+	if (plmn_changed) {
+		(void)settings_save_one(SETTINGS_TREE "/" SETTINGS_LAST_KEY, &current_plmn,
+					sizeof(current_plmn));
+	}
+}
+#else
+static void entry_save(const struct plmn_entry *entry, bool plmn_changed, bool force)
+{
+}
+#endif /* CONFIG_RAT_SELECT_SETTINGS */
+
+static void lte_handler(const struct lte_lc_evt *const evt)
+{
+	if (evt->type != LTE_LC_EVT_NW_REG_STATUS ||
+	    (evt->nw_reg_status != LTE_LC_NW_REG_REGISTERED_HOME &&
+	     evt->nw_reg_status != LTE_LC_NW_REG_REGISTERED_ROAMING)) {
+		return;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+	if (attach_pending) {
+		attach_ms = k_uptime_get() - attach_start;
+		attach_pending = false;
+		LOG_DBG("Attached in %u ms", attach_ms);
+	}
+	k_mutex_unlock(&lock);
+}
+
+int rat_select_init(void)
+{
+	int err;
+
+	if (IS_ENABLED(CONFIG_RAT_SELECT_SETTINGS)) {
+		err = settings_subsys_init();
+		if (err) {
+			LOG_ERR("Failed to initialize settings, error: %d", err);
+			return err;
+		}
+
+		err = settings_load_subtree(SETTINGS_TREE);
+		if (err) {
+			LOG_WRN("Failed to load statistics, error: %d", err);
+		}
+	}
+
+	lte_lc_register_handler(lte_handler);
+
+	return 0;
+}
+
+int rat_select_apply(void)
+{
+	enum lte_lc_system_mode mode;
+	enum lte_lc_system_mode_preference pref, new_pref;
+	struct plmn_entry *entry;
+	enum rat_select_rat rat;
+	int err = 0;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	attach_start = k_uptime_get();
+	attach_pending = true;
+	attach_ms = 0;
+
+	entry = entry_find(current_plmn);
+	if (entry == NULL) {
+		/* Nothing known about the network, let the modem decide. */
+		goto out;
+	}
+
+	entry->attaches++;
+	rat = rat_pick(entry);
+	new_pref = rat == RAT_SELECT_LTEM ? LTE_LC_SYSTEM_MODE_PREFER_LTEM :
+					    LTE_LC_SYSTEM_MODE_PREFER_NBIOT;
+
+	err = lte_lc_system_mode_get(&mode, &pref);
+	if (err) {
+		LOG_ERR("Failed to get system mode, error: %d", err);
+		goto out;
+	}
+
+	if (pref != new_pref) {
+		LOG_INF("Preferring %s on %u", rat_names[rat], current_plmn);
+		err = lte_lc_system_mode_set(mode, new_pref);
+		if (err) {
+			LOG_ERR("Failed to set system mode, error: %d", err);
+		}
+	}
+
+out:
+	k_mutex_unlock(&lock);
+	return err;
+}
+
+void rat_select_exchange_done(size_t bytes, uint32_t rtt_ms)
+{
+	struct rat_select_stats *stats;
+	struct plmn_entry *entry;
+	enum rat_select_rat rat, best;
+	char plmn_str[7];
+	uint32_t plmn;
+	bool changed;
+	int act, ret;
+
+	ret = nrf_modem_at_scanf("AT+COPS?", "+COPS: %*d,%*d,\"%6[0-9]\",%d", plmn_str, &act);
+	if (ret != 2) {
+		LOG_WRN("Failed to read the current network, error: %d", ret);
+		return;
+	}
+
+	if (act != ACT_LTEM && act != ACT_NBIOT) {
+		return;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	plmn = strtoul(plmn_str, NULL, 10);
+	entry = entry_get(plmn);
+	rat = act == ACT_LTEM ? RAT_SELECT_LTEM : RAT_SELECT_NBIOT;
+	stats = &entry->stats[rat];
+	best = rat_best(entry);
+
+	if (attach_ms != 0) {
+		avg_update(&stats->attach_ms, attach_ms, stats->attaches == 0);
+		stats->attaches++;
+		attach_ms = 0;
+	}
+
+	avg_update(&stats->rtt_ms, rtt_ms, stats->samples == 0);
+	avg_update(&stats->goodput, bytes * MSEC_PER_SEC / MAX(rtt_ms, 1), stats->samples == 0);
+	stats->samples++;
+
+	LOG_INF("%s on %u: attach %u ms, RTT %u ms, goodput %u B/s", rat_names[rat], plmn,
+		stats->attach_ms, stats->rtt_ms, stats->goodput);
+
+	changed = plmn != current_plmn;
+	current_plmn = plmn;
+	/* A first measurement or a new preference must survive a reboot */
+	entry_save(entry, changed, stats->samples == 1 || rat_best(entry) != best);
+
+	k_mutex_unlock(&lock);
+}
+
+int rat_select_stats_get(enum rat_select_rat rat, struct rat_select_stats *stats)
+{
+	struct plmn_entry *entry;
+	int err = 0;
+
+	if (rat >= RAT_SELECT_RAT_COUNT) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	entry = entry_find(current_plmn);
+	if (entry == NULL) {
+		err = -ENOENT;
+	} else {
+		*stats = entry->stats[rat];
+	}
+
+	k_mutex_unlock(&lock);
+
+	return err;
+}
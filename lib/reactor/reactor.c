@@ -0,0 +1,381 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/zvfs/eventfd.h>
+
+#include <cellfund/reactor.h>
+
+LOG_MODULE_REGISTER(reactor, CONFIG_REACTOR_LOG_LEVEL);
+
+/* The first slot is for the wakeup event */
+#define FD_COUNT (CONFIG_REACTOR_MAX_FDS + 1)
+#define FD_FIRST 1
+
+struct fd_entry {
+	int fd;
+	short events;
+	reactor_fd_cb_t cb;
+	void *user_data;
+};
+
+static K_MUTEX_DEFINE(lock);
+static struct fd_entry fds[FD_COUNT];
+/* Running timers, the one that expires first at the head */
+static sys_slist_t timers = SYS_SLIST_STATIC_INIT(&timers);
+static k_tid_t reactor_tid;
+static bool stop;
+static struct reactor_event wakeup = { .fd = -1 };
+static struct reactor_stats stats;
+
+/* Makes zsock_poll() in the reactor thread return, so it picks up new file
+ * descriptors and timers. Not needed from the reactor thread itself.
+ */
+static void reactor_wake(void)
+{
+	k_tid_t tid;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	tid = reactor_tid;
+	k_mutex_unlock(&lock);
+
+	if (tid != NULL && tid != k_current_get()) {
+		(void)reactor_event_signal(&wakeup);
+	}
+}
+
+/* Called with the lock held. */
+static struct fd_entry *fd_find_locked(int fd)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(fds); i++) {
+		if (fds[i].cb != NULL && fds[i].fd == fd) {
+			return &fds[i];
+		}
+	}
+
+	return NULL;
+}
+
+int reactor_fd_add(int fd, short events, reactor_fd_cb_t cb, void *user_data)
+{
+	int err = -ENOMEM;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	if (fd_find_locked(fd) != NULL) {
+		err = -EALREADY;
+		goto out;
+	}
+
+	for (size_t i = FD_FIRST; i < ARRAY_SIZE(fds); i++) {
+		if (fds[i].cb == NULL) {
+			fds[i] = (struct fd_entry){
+				.fd = fd,
+				.events = events,
+				.cb = cb,
+				.user_data = user_data,
+			};
+			err = 0;
+			break;
+		}
+	}
+
+out:
+	k_mutex_unlock(&lock);
+
+	if (!err) {
+		reactor_wake();
+	}
+
+	return err;
+}
+
+int reactor_fd_remove(int fd)
+{
+	struct fd_entry *entry;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	entry = fd_find_locked(fd);
+	if (entry != NULL) {
+		entry->cb = NULL;
+	}
+	k_mutex_unlock(&lock);
+
+	if (entry == NULL) {
+		return -ENOENT;
+	}
+
+	reactor_wake();
+
+	return 0;
+}
+
+void reactor_timer_init(struct reactor_timer *timer, reactor_timer_cb_t cb)
+{
+	timer->cb = cb;
+	timer->active = false;
+}
+
+void reactor_timer_start(struct reactor_timer *timer, uint32_t delay_ms)
+{
+	struct reactor_timer *t, *prev = NULL;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	if (timer->active) {
+		(void)sys_slist_find_and_remove(&timers, &timer->node);
+	}
+
+	timer->expiry = k_uptime_get() + delay_ms;
+	timer->active = true;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&timers, t, node) {
+		if (t->expiry > timer->expiry) {
+			break;
+		}
+		prev = t;
+	}
+
+	if (prev == NULL) {
+		sys_slist_prepend(&timers, &timer->node);
+	} else {
+		sys_slist_insert(&timers, &prev->node, &timer->node);
+	}
+	k_mutex_unlock(&lock);
+
+	reactor_wake();
+}
+
+void reactor_timer_stop(struct reactor_timer *timer)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+	if (timer->active) {
+		(void)sys_slist_find_and_remove(&timers, &timer->node);
+		timer->active = false;
+	}
+	k_mutex_unlock(&lock);
+}
+
+static void event_fd_cb(int fd, short revents, void *user_data)
+{
+	struct reactor_event *event = user_data;
+	zvfs_eventfd_t count;
+
+	/* The eventfd is non-blocking, there is nothing to read if it was not signalled */
+	if (zvfs_eventfd_read(fd, &count) != 0) {
+		return;
+	}
+
+	if (event->cb != NULL) {
+		event->cb(event, count);
+	}
+}
+
+int reactor_event_init(struct reactor_event *event, reactor_event_cb_t cb)
+{
+	int err;
+
+	event->cb = cb;
+	event->fd = zvfs_eventfd(0, ZVFS_EFD_NONBLOCK);
+	if (event->fd < 0) {
+		LOG_ERR("Failed to create eventfd: %d", errno);
+		return -ENOMEM;
+	}
+
+	err = reactor_fd_add(event->fd, ZSOCK_POLLIN, event_fd_cb, event);
+	if (err) {
+		(void)zsock_close(event->fd);
+		event->fd = -1;
+	}
+
+	return err;
+}
+
+/* Called with the lock held. */
+static int wakeup_init_locked(void)
+{
+	wakeup.fd = zvfs_eventfd(0, ZVFS_EFD_NONBLOCK);
+	if (wakeup.fd < 0) {
+		LOG_ERR("Failed to create eventfd: %d", errno);
+		return -ENOMEM;
+	}
+
+	fds[0] = (struct fd_entry){
+		.fd = wakeup.fd,
+		.events = ZSOCK_POLLIN,
+		.cb = event_fd_cb,
+		.user_data = &wakeup,
+	};
+
+	return 0;
+}
+
+int reactor_event_signal(struct reactor_event *event)
+{
+	if (zvfs_eventfd_write(event->fd, 1) != 0) {
+		return -errno;
+	}
+
+	return 0;
+}
+
+/* Called with the lock held. Returns the poll timeout for the nearest timer. */
+static int timeout_get_locked(void)
+{
+	struct reactor_timer *t = SYS_SLIST_PEEK_HEAD_CONTAINER(&timers, t, node);
+
+	if (t == NULL) {
+		return -1;
+	}
+
+	return (int)CLAMP(t->expiry - k_uptime_get(), 0, INT32_MAX);
+}
+
+static void callback_done(int64_t start, bool timer)
+{
+	uint32_t ms = k_uptime_get() - start;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	if (timer) {
+		stats.timer_callbacks++;
+	} else {
+		stats.fd_callbacks++;
+	}
+	stats.callback_ms_max = MAX(stats.callback_ms_max, ms);
+	k_mutex_unlock(&lock);
+
+	if (ms > CONFIG_REACTOR_CALLBACK_WARN_MS) {
+		LOG_WRN("Callback took %u ms", ms);
+	}
+}
+
+static void fd_dispatch(int fd, short revents)
+{
+	struct fd_entry *entry;
+	reactor_fd_cb_t cb = NULL;
+	void *user_data;
+	int64_t start;
+
+	/* An earlier callback may have removed it */
+	k_mutex_lock(&lock, K_FOREVER);
+	entry = fd_find_locked(fd);
+	if (entry != NULL) {
+		cb = entry->cb;
+		user_data = entry->user_data;
+	}
+	k_mutex_unlock(&lock);
+
+	if (cb == NULL) {
+		return;
+	}
+
+	start = k_uptime_get();
+	cb(fd, revents, user_data);
+	callback_done(start, false);
+}
+
+static void timers_dispatch(void)
+{
+	struct reactor_timer *t;
+	int64_t start;
+
+	while (true) {
+		k_mutex_lock(&lock, K_FOREVER);
+		t = SYS_SLIST_PEEK_HEAD_CONTAINER(&timers, t, node);
+		if (t == NULL || t->expiry > k_uptime_get()) {
+			k_mutex_unlock(&lock);
+			break;
+		}
+
+		(void)sys_slist_get(&timers);
+		t->active = false;
+		k_mutex_unlock(&lock);
+
+		start = k_uptime_get();
+		t->cb(t);
+		callback_done(start, true);
+	}
+}
+
+int reactor_run(void)
+{
+	struct zsock_pollfd pollfds[FD_COUNT];
+	int count, timeout, ret;
+	int err = 0;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	if (wakeup.fd < 0) {
+		err = wakeup_init_locked();
+		if (err) {
+			k_mutex_unlock(&lock);
+			return err;
+		}
+	}
+
+	reactor_tid = k_current_get();
+	stop = false;
+	k_mutex_unlock(&lock);
+
+	while (true) {
+		k_mutex_lock(&lock, K_FOREVER);
+		if (stop) {
+			k_mutex_unlock(&lock);
+			break;
+		}
+
+		count = 0;
+		for (size_t i = 0; i < ARRAY_SIZE(fds); i++) {
+			if (fds[i].cb != NULL) {
+				pollfds[count].fd = fds[i].fd;
+				pollfds[count].events = fds[i].events;
+				pollfds[count].revents = 0;
+				count++;
+			}
+		}
+		timeout = timeout_get_locked();
+		stats.polls++;
+		k_mutex_unlock(&lock);
+
+		ret = zsock_poll(pollfds, count, timeout);
+		if (ret < 0) {
+			err = -errno;
+			LOG_ERR("Poll failed: %d", errno);
+			break;
+		}
+
+		for (int i = 0; i < count && ret > 0; i++) {
+			if (pollfds[i].revents != 0) {
+				fd_dispatch(pollfds[i].fd, pollfds[i].revents);
+				ret--;
+			}
+		}
+
+		timers_dispatch();
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+	reactor_tid = NULL;
+	k_mutex_unlock(&lock);
+
+	return err;
+}
+
+void reactor_stop(void)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+	stop = true;
+	k_mutex_unlock(&lock);
+
+	reactor_wake();
+}
+
+void reactor_stats_get(struct reactor_stats *out)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+	*out = stats;
+	k_mutex_unlock(&lock);
+}
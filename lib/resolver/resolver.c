@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net/socket.h>
+#if defined(CONFIG_RESOLVER_PDN_FILTER)
+#include <nrf_modem_at.h>
+#endif
+
+#include <cellfund/resolver.h>
+
+LOG_MODULE_REGISTER(resolver, CONFIG_RESOLVER_LOG_LEVEL);
+
+#if defined(CONFIG_RESOLVER_PREFER_IPV6) || defined(CONFIG_RESOLVER_IPV6_ONLY)
+#define FAMILY_PREFERRED AF_INET6
+#else
+#define FAMILY_PREFERRED AF_INET
+#endif
+
+#define FAMILY_ONLY (IS_ENABLED(CONFIG_RESOLVER_IPV4_ONLY) || IS_ENABLED(CONFIG_RESOLVER_IPV6_ONLY))
+
+static K_MUTEX_DEFINE(lock);
+/* IPv4 and IPv6 */
+static struct resolver_family_stats stats[2];
+
+static int family_index(int family)
+{
+	switch (family) {
+	case AF_INET:
+		return 0;
+	case AF_INET6:
+		return 1;
+	default:
+		return -EAFNOSUPPORT;
+	}
+}
+
+/* Private ranges of RFC 1918 and the shared CGNAT range of RFC 6598. */
+static bool ipv4_nat(uint32_t addr)
+{
+	return (addr & 0xff000000) == 0x0a000000 || (addr & 0xfff00000) == 0xac100000 ||
+	       (addr & 0xffff0000) == 0xc0a80000 || (addr & 0xffc00000) == 0x64400000;
+}
+
+static void pdn_addr_add(struct resolver_pdn *pdn, const char *str)
+{
+	struct in6_addr in6;
+	struct in_addr in4;
+
+	if (zsock_inet_pton(AF_INET6, str, &in6) == 1) {
+		pdn->ipv6 = true;
+	} else if (zsock_inet_pton(AF_INET, str, &in4) == 1) {
+		pdn->ipv4 = true;
+		pdn->ipv4_nat = ipv4_nat(ntohl(in4.s_addr));
+	}
+}
+
+int resolver_pdn_get(struct resolver_pdn *pdn)
+{
+#if defined(CONFIG_RESOLVER_PDN_FILTER)
+	char addr1[NET_IPV6_ADDR_LEN];
+	char addr2[NET_IPV6_ADDR_LEN];
+	int ret;
+
+	memset(pdn, 0, sizeof(*pdn));
+
+	/* An IPv4v6 PDN lists the IPv4 address first. */
+	ret = nrf_modem_at_scanf("AT+CGPADDR=0", "+CGPADDR: %*d,\"%45[^\"]\",\"%45[^\"]\"",
+				 addr1, addr2);
+	if (ret < 1) {
+		return -ENOTCONN;
+	}
+
+	pdn_addr_add(pdn, addr1);
+	if (ret > 1) {
+		pdn_addr_add(pdn, addr2);
+	}
+
+	return 0;
+#else
+	ARG_UNUSED(pdn);
+
+	return -ENOTSUP;
+#endif
+}
+
+static bool family_allowed(int family, const struct resolver_pdn *pdn)
+{
+	if (FAMILY_ONLY && family != FAMILY_PREFERRED) {
+		return false;
+	}
+
+	if (pdn != NULL) {
+		return family == AF_INET ? pdn->ipv4 : pdn->ipv6;
+	}
+
+	return family == AF_INET || family == AF_INET6;
+}
+
+int resolver_lookup(const char *host, uint16_t port, int socktype,
+		    struct sockaddr_storage *addr, socklen_t *addrlen)
+{
+	struct zsock_addrinfo hints = {
+		.ai_family = FAMILY_ONLY ? FAMILY_PREFERRED : AF_UNSPEC,
+		.ai_socktype = socktype,
+	};
+	struct zsock_addrinfo *result;
+	const struct zsock_addrinfo *picked = NULL;
+	struct resolver_pdn pdn;
+	const struct resolver_pdn *filter = NULL;
+	char addr_str[NET_IPV6_ADDR_LEN];
+	int err;
+
+	if (resolver_pdn_get(&pdn) == 0 && (pdn.ipv4 || pdn.ipv6)) {
+		filter = &pdn;
+		LOG_DBG("PDN: IPv4 %s%s, IPv6 %s", pdn.ipv4 ? "yes" : "no",
+			pdn.ipv4_nat ? " (NAT)" : "", pdn.ipv6 ? "yes" : "no");
+	}
+
+	err = zsock_getaddrinfo(host, NULL, &hints, &result);
+	if (err != 0) {
+		LOG_ERR("Failed to resolve %s, error: %d", host, err);
+		return -EIO;
+	}
+
+	for (const struct zsock_addrinfo *ai = result; ai != NULL; ai = ai->ai_next) {
+		if (!family_allowed(ai->ai_family, filter)) {
+			continue;
+		}
+
+		if (ai->ai_family == FAMILY_PREFERRED) {
+			picked = ai;
+			break;
+		}
+
+		if (picked == NULL) {
+			picked = ai;
+		}
+	}
+
+	if (picked == NULL) {
+		LOG_ERR("No usable address found for %s", host);
+		zsock_freeaddrinfo(result);
+		return -ENOENT;
+	}
+
+	memset(addr, 0, sizeof(*addr));
+	if (picked->ai_family == AF_INET6) {
+		struct sockaddr_in6 *addr6 = (struct sockaddr_in6 *)addr;
+
+		memcpy(addr6, picked->ai_addr, sizeof(*addr6));
+		addr6->sin6_port = htons(port);
+		*addrlen = sizeof(*addr6);
+		zsock_inet_ntop(AF_INET6, &addr6->sin6_addr, addr_str, sizeof(addr_str));
+	} else {
+		struct sockaddr_in *addr4 = (struct sockaddr_in *)addr;
+
+		memcpy(addr4, picked->ai_addr, sizeof(*addr4));
+		addr4->sin_port = htons(port);
+		*addrlen = sizeof(*addr4);
+		zsock_inet_ntop(AF_INET, &addr4->sin_addr, addr_str, sizeof(addr_str));
+	}
+
+	zsock_freeaddrinfo(result);
+
+	k_mutex_lock(&lock, K_FOREVER);
+	stats[family_index(addr->ss_family)].lookups++;
+	k_mutex_unlock(&lock);
+
+	LOG_INF("%s address of %s: %s", addr->ss_family == AF_INET6 ? "IPv6" : "IPv4", host,
+		addr_str);
+	if (addr->ss_family == AF_INET && filter != NULL && filter->ipv4_nat) {
+		LOG_INF("IPv4 is behind NAT, keepalives must be shorter than its binding timeout");
+	}
+
+	return 0;
+}
+
+void resolver_rtt_add(int family, uint32_t rtt_ms)
+{
+	int idx = family_index(family);
+	struct resolver_family_stats *s;
+
+	if (idx < 0) {
+		return;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+	s = &stats[idx];
+	s->rtt_ms_min = s->rtt_count == 0 ? rtt_ms : MIN(s->rtt_ms_min, rtt_ms);
+	s->rtt_ms_max = MAX(s->rtt_ms_max, rtt_ms);
+	s->rtt_ms_total += rtt_ms;
+	s->rtt_count++;
+	k_mutex_unlock(&lock);
+}
+
+int resolver_stats_get(int family, struct resolver_family_stats *out)
+{
+	int idx = family_index(family);
+
+	if (idx < 0) {
+		return idx;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+	*out = stats[idx];
+	k_mutex_unlock(&lock);
+
+	return 0;
+}
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <nrf_modem_gnss.h>
+
+#include <cellfund/sat_stats.h>
+
+LOG_MODULE_REGISTER(sat_stats, CONFIG_SAT_STATS_LOG_LEVEL);
+
+#define MAX_SV CONFIG_SAT_STATS_MAX_SV
+
+/* C/N0 averages are kept with 4 fractional bits, in 0.1 dB-Hz. */
+#define CN0_FRAC_BITS 4
+#define CN0_MAX (UINT16_MAX >> CN0_FRAC_BITS)
+
+BUILD_ASSERT(MAX_SV <= 32, "Entries are tracked in 32-bit masks");
+BUILD_ASSERT(MAX_SV >= NRF_MODEM_GNSS_MAX_SATELLITES);
+
+/* Structure-of-arrays, so that the per-epoch lookup only walks the ID arrays. */
+static struct {
+	uint16_t sv[MAX_SV];
+	uint8_t signal[MAX_SV];
+	uint16_t cn0_avg[MAX_SV];
+	uint32_t epochs_tracked[MAX_SV];
+	uint32_t epochs_used[MAX_SV];
+	/* Sum of closed visibility intervals, in ms. */
+	uint32_t visible_ms[MAX_SV];
+	/* Start of the open visibility interval, in ms of uptime. */
+	uint32_t visible_since[MAX_SV];
+	uint32_t last_seen[MAX_SV];
+
+	/* Entries holding a satellite. */
+	uint32_t in_use;
+	/* Entries tracked in the latest epoch. */
+	uint32_t visible;
+
+	uint32_t epochs;
+	uint32_t fix_epochs;
+	uint8_t tracked;
+	uint8_t used_in_fix;
+	uint16_t cn0_mean;
+} stats;
+
+static K_MUTEX_DEFINE(stats_lock);
+
+static int entry_find(uint16_t sv, uint8_t signal)
+{
+	for (int i = 0; i < MAX_SV; i++) {
+		if ((stats.in_use & BIT(i)) && stats.sv[i] == sv && stats.signal[i] == signal) {
+			return i;
+		}
+	}
+
+	return -ENOENT;
+}
+
+/* Take a free entry, or replace the one out of view the longest. Entries already
+ * seen in the current epoch are never replaced.
+ */
+static int entry_alloc(uint32_t seen, uint32_t now)
+{
+	int oldest = -1;
+
+	for (int i = 0; i < MAX_SV; i++) {
+		if (!(stats.in_use & BIT(i))) {
+			oldest = i;
+			break;
+		}
+
+		if (seen & BIT(i)) {
+			continue;
+		}
+
+		if (oldest < 0 || (now - stats.last_seen[i]) > (now - stats.last_seen[oldest])) {
+			oldest = i;
+		}
+	}
+
+	if (stats.in_use & BIT(oldest)) {
+		LOG_DBG("Replacing sv %d", stats.sv[oldest]);
+		stats.visible &= ~BIT(oldest);
+	}
+
+	stats.in_use |= BIT(oldest);
+	stats.cn0_avg[oldest] = 0;
+	stats.epochs_tracked[oldest] = 0;
+	stats.epochs_used[oldest] = 0;
+	stats.visible_ms[oldest] = 0;
+
+	return oldest;
+}
+
+void sat_stats_update(const struct nrf_modem_gnss_pvt_data_frame *pvt)
+{
+	uint32_t now = k_uptime_get_32();
+	uint32_t seen = 0;
+	uint32_t lost;
+	uint32_t cn0_sum = 0;
+	uint8_t tracked = 0;
+	uint8_t used = 0;
+
+	k_mutex_lock(&stats_lock, K_FOREVER);
+
+	for (int i = 0; i < NRF_MODEM_GNSS_MAX_SATELLITES; i++) {
+		const struct nrf_modem_gnss_sv *sv = &pvt->sv[i];
+		uint16_t cn0 = MIN(sv->cn0, CN0_MAX);
+		int idx;
+
+		if (sv->signal == 0) {
+			continue;
+		}
+
+		idx = entry_find(sv->sv, sv->signal);
+		if (idx < 0) {
+			idx = entry_alloc(seen, now);
+			stats.sv[idx] = sv->sv;
+			stats.signal[idx] = sv->signal;
+		}
+
+		seen |= BIT(idx);
+
+		if (stats.epochs_tracked[idx] == 0) {
+			stats.cn0_avg[idx] = cn0 << CN0_FRAC_BITS;
+		} else {
+			int32_t diff = (int32_t)(cn0 << CN0_FRAC_BITS) - stats.cn0_avg[idx];
+
+			stats.cn0_avg[idx] += diff / (1 << CONFIG_SAT_STATS_CN0_AVG_SHIFT);
+		}
+
+		stats.epochs_tracked[idx]++;
+		if (sv->flags & NRF_MODEM_GNSS_SV_FLAG_USED_IN_FIX) {
+			stats.epochs_used[idx]++;
+			used++;
+		}
+
+		if (!(stats.visible & BIT(idx))) {
+			stats.visible_since[idx] = now;
+		}
+		stats.last_seen[idx] = now;
+
+		cn0_sum += cn0;
+		tracked++;
+	}
+
+	/* Close the visibility interval of satellites that were lost. */
+	lost = stats.visible & ~seen;
+	for (int i = 0; lost != 0; i++, lost >>= 1) {
+		if (lost & 1) {
+			stats.visible_ms[i] += now - stats.visible_since[i];
+		}
+	}
+
+	stats.visible = seen;
+	stats.epochs++;
+	if (pvt->flags & NRF_MODEM_GNSS_PVT_FLAG_FIX_VALID) {
+		stats.fix_epochs++;
+	}
+	stats.tracked = tracked;
+	stats.used_in_fix = used;
+	stats.cn0_mean = tracked ? cn0_sum / tracked : 0;
+
+	k_mutex_unlock(&stats_lock);
+}
+
+void sat_stats_summary_get(struct sat_stats_summary *summary)
+{
+	k_mutex_lock(&stats_lock, K_FOREVER);
+
+	summary->epochs = stats.epochs;
+	summary->fix_epochs = stats.fix_epochs;
+	summary->tracked = stats.tracked;
+	summary->used_in_fix = stats.used_in_fix;
+	summary->cn0_mean = stats.cn0_mean;
+	summary->entries = 0;
+	for (uint32_t mask = stats.in_use; mask != 0; mask &= mask - 1) {
+		summary->entries++;
+	}
+
+	k_mutex_unlock(&stats_lock);
+}
+
+static void entry_read(int idx, struct sat_stats_sv *out)
+{
+	bool visible = stats.visible & BIT(idx);
+
+	out->sv = stats.sv[idx];
+	out->signal = stats.signal[idx];
+	out->visible = visible;
+	out->cn0_avg = (stats.cn0_avg[idx] + BIT(CN0_FRAC_BITS - 1)) >> CN0_FRAC_BITS;
+	out->epochs_tracked = stats.epochs_tracked[idx];
+	out->used_in_fix_pct = stats.epochs_tracked[idx] ?
+			       (stats.epochs_used[idx] * 100U) / stats.epochs_tracked[idx] : 0;
+	out->visible_ms = stats.visible_ms[idx];
+	if (visible) {
+		out->visible_ms += k_uptime_get_32() - stats.visible_since[idx];
+	}
+}
+
+int sat_stats_get(uint8_t idx, struct sat_stats_sv *out)
+{
+	int err = -ENOENT;
+
+	k_mutex_lock(&stats_lock, K_FOREVER);
+
+	/* Entries are reported in table order, skipping free ones. */
+	for (int i = 0; i < MAX_SV; i++) {
+		if (!(stats.in_use & BIT(i))) {
+			continue;
+		}
+
+		if (idx-- == 0) {
+			entry_read(i, out);
+			err = 0;
+			break;
+		}
+	}
+
+	k_mutex_unlock(&stats_lock);
+
+	return err;
+}
+
+int sat_stats_sv_get(uint16_t sv, uint8_t signal, struct sat_stats_sv *out)
+{
+	int idx;
+
+	k_mutex_lock(&stats_lock, K_FOREVER);
+
+	idx = entry_find(sv, signal);
+	if (idx >= 0) {
+		entry_read(idx, out);
+	}
+
+	k_mutex_unlock(&stats_lock);
+
+	return idx < 0 ? idx : 0;
+}
+
+void sat_stats_reset(void)
+{
+	k_mutex_lock(&stats_lock, K_FOREVER);
+	memset(&stats, 0, sizeof(stats));
+	k_mutex_unlock(&stats_lock);
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+
+#include <cellfund/sat_stats.h>
+
+static int cmd_sat_stats_show(const struct shell *sh, size_t argc, char **argv)
+{
+	struct sat_stats_summary summary;
+	struct sat_stats_sv sv;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	sat_stats_summary_get(&summary);
+
+	shell_print(sh, "Epochs: %u, with fix: %u", summary.epochs, summary.fix_epochs);
+	shell_print(sh, "Tracked: %u, used in fix: %u, mean C/N0: %u.%u dB-Hz",
+		    summary.tracked, summary.used_in_fix,
+		    summary.cn0_mean / 10, summary.cn0_mean % 10);
+
+	if (summary.entries == 0) {
+		return 0;
+	}
+
+	shell_print(sh, " sv  sig vis  C/N0  epochs  used  visible");
+	for (uint8_t i = 0; sat_stats_get(i, &sv) == 0; i++) {
+		shell_print(sh, "%3u  %3u  %c  %2u.%u  %6u  %3u%%  %5u s",
+			    sv.sv, sv.signal, sv.visible ? '*' : ' ',
+			    sv.cn0_avg / 10, sv.cn0_avg % 10, sv.epochs_tracked,
+			    sv.used_in_fix_pct, sv.visible_ms / MSEC_PER_SEC);
+	}
+
+	return 0;
+}
+
+static int cmd_sat_stats_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	sat_stats_reset();
+	shell_print(sh, "Satellite statistics cleared");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_sat_stats,
+	SHELL_CMD(show, NULL, "Show satellite statistics", cmd_sat_stats_show),
+	SHELL_CMD(reset, NULL, "Clear satellite statistics", cmd_sat_stats_reset),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(sat_stats, &sub_sat_stats, "GNSS satellite statistics", NULL);
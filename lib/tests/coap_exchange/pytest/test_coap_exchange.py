@@ -0,0 +1,47 @@
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+"""Runs the coap_exchange test against emu_server.py behind udp_proxy.py.
+
+The server answers confirmable requests with an empty ACK and a separate
+response 4 s later, and the proxy adds 100 ms of latency each way.
+"""
+
+import re
+import subprocess
+import sys
+import time
+from pathlib import Path
+
+import pytest
+from twister_harness import DeviceAdapter
+
+MODEM_EMU = Path(__file__).resolve().parents[3] / 'modem_emu'
+
+
+@pytest.fixture
+def server():
+    emu = subprocess.Popen([sys.executable, '-u', str(MODEM_EMU / 'emu_server.py'),
+                            '--separate', '4000'],
+                           stdout=subprocess.PIPE, text=True)
+    proxy = subprocess.Popen([sys.executable, '-u', str(MODEM_EMU / 'udp_proxy.py'),
+                              '--port', '5783', '--server', '5683', '--latency', '100'],
+                             stdout=subprocess.DEVNULL)
+    # Both listen before the test binary starts
+    time.sleep(1)
+    yield emu
+    proxy.terminate()
+    emu.terminate()
+
+
+def test_coap_exchange(server, dut: DeviceAdapter):
+    lines = dut.readlines_until(regex='PROJECT EXECUTION (SUCCESSFUL|FAILED)', timeout=60)
+    assert 'PROJECT EXECUTION SUCCESSFUL' in lines[-1]
+
+    server.terminate()
+    output = server.communicate(timeout=5)[0]
+    assert re.search(r'Separate response 0x[0-9a-f]{4} acknowledged after 1 transmissions',
+                     output), output
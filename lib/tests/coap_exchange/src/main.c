@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/coap.h>
+#include <zephyr/ztest.h>
+
+#include <cellfund/coap_dedup.h>
+#include <cellfund/coap_exchange.h>
+#include <cellfund/coap_rto.h>
+
+/* udp_proxy.py in front of emu_server.py, started by pytest/test_coap_exchange.py */
+#define PROXY_PORT 5783
+/* Delay of the separate response, longer than any first timeout */
+#define SEPARATE_MS 4000
+/* The server retransmits an unacknowledged response after 2 s */
+#define SERVER_ACK_TIMEOUT_MS 2000
+
+static const uint8_t token[] = {0xca, 0xfe};
+
+static int sock = -1;
+static struct sockaddr_in server = {
+	.sin_family = AF_INET,
+	.sin_port = htons(PROXY_PORT),
+	/* 127.0.0.1 */
+	.sin_addr.s_addr = htonl(0x7f000001),
+};
+static uint8_t request_buf[64];
+static uint8_t rx_buf[128];
+
+static void request_init(struct coap_packet *request, uint16_t id)
+{
+	zassert_ok(coap_packet_init(request, request_buf, sizeof(request_buf), COAP_VERSION_1,
+				    COAP_TYPE_CON, sizeof(token), token, COAP_METHOD_GET, id));
+	zassert_ok(coap_packet_append_option(request, COAP_OPTION_URI_PATH, (uint8_t *)"test",
+					     strlen("test")));
+}
+
+static void msg_init(struct coap_packet *msg, uint8_t *buf, size_t len, uint8_t type,
+		     uint8_t code, uint16_t id, const uint8_t *tkn, uint8_t tkl)
+{
+	zassert_ok(coap_packet_init(msg, buf, len, COAP_VERSION_1, type, tkl, tkn, code, id));
+}
+
+/* Returns the length of the message received within @p timeout_ms, or 0 */
+static int recv_wait(int timeout_ms)
+{
+	struct zsock_pollfd fds = {
+		.fd = sock,
+		.events = ZSOCK_POLLIN,
+	};
+	int ret;
+
+	ret = zsock_poll(&fds, 1, timeout_ms);
+	zassert_true(ret >= 0, "poll failed: %d", errno);
+	if (ret == 0) {
+		return 0;
+	}
+
+	ret = zsock_recv(sock, rx_buf, sizeof(rx_buf), 0);
+	zassert_true(ret > 0, "recv failed: %d", errno);
+
+	return ret;
+}
+
+/* Handles a received message the way the CoAP solutions do */
+static enum coap_exchange_match rx_match(struct coap_exchange *ex, struct coap_packet *msg,
+					 int len)
+{
+	zassert_ok(coap_packet_parse(msg, rx_buf, len, NULL, 0));
+	if (coap_dedup_rx(sock, (struct sockaddr *)&server, msg) == -EALREADY) {
+		return COAP_EXCHANGE_OTHER;
+	}
+
+	return coap_exchange_rx(ex, sock, msg);
+}
+
+ZTEST(coap_exchange, test_match)
+{
+	/* 192.0.2.1, TEST-NET-1, nothing is sent */
+	struct sockaddr_in dst = {
+		.sin_family = AF_INET,
+		.sin_port = htons(1000),
+		.sin_addr.s_addr = htonl(0xc0000201),
+	};
+	static const uint8_t other[] = {0xbe, 0xef};
+	struct coap_packet request, msg;
+	struct coap_exchange ex;
+	struct coap_rto_stats stats;
+	uint8_t buf[16];
+
+	request_init(&request, 0x1000);
+	(void)coap_exchange_start(&ex, (struct sockaddr *)&dst, &request);
+
+	/* ACKs and resets of other requests */
+	msg_init(&msg, buf, sizeof(buf), COAP_TYPE_ACK, COAP_CODE_EMPTY, 0x0fff, NULL, 0);
+	zassert_equal(coap_exchange_rx(&ex, sock, &msg), COAP_EXCHANGE_OTHER);
+	msg_init(&msg, buf, sizeof(buf), COAP_TYPE_RESET, COAP_CODE_EMPTY, 0x1001, NULL, 0);
+	zassert_equal(coap_exchange_rx(&ex, sock, &msg), COAP_EXCHANGE_OTHER);
+	zassert_false(ex.acked);
+
+	/* A response to an older request */
+	msg_init(&msg, buf, sizeof(buf), COAP_TYPE_NON_CON, COAP_RESPONSE_CODE_CONTENT, 0x2000,
+		 other, sizeof(other));
+	zassert_equal(coap_exchange_rx(&ex, sock, &msg), COAP_EXCHANGE_OTHER);
+
+	msg_init(&msg, buf, sizeof(buf), COAP_TYPE_RESET, COAP_CODE_EMPTY, 0x1000, NULL, 0);
+	zassert_equal(coap_exchange_rx(&ex, sock, &msg), COAP_EXCHANGE_RESET);
+	zassert_equal(coap_rto_stats_get((struct sockaddr *)&dst, &stats), 0);
+	zassert_equal(stats.strong_samples, 0);
+
+	/* A piggybacked response is the ACK and the response at once */
+	msg_init(&msg, buf, sizeof(buf), COAP_TYPE_ACK, COAP_RESPONSE_CODE_CONTENT, 0x1000,
+		 token, sizeof(token));
+	zassert_equal(coap_exchange_rx(&ex, sock, &msg), COAP_EXCHANGE_RESPONSE);
+	zassert_true(ex.acked);
+	zassert_ok(coap_rto_stats_get((struct sockaddr *)&dst, &stats));
+	zassert_equal(stats.strong_samples, 1);
+
+	/* A separate response whose ACK was lost gives no sample */
+	request_init(&request, 0x1001);
+	(void)coap_exchange_start(&ex, (struct sockaddr *)&dst, &request);
+	msg_init(&msg, buf, sizeof(buf), COAP_TYPE_NON_CON, COAP_RESPONSE_CODE_CONTENT, 0x2001,
+		 token, sizeof(token));
+	zassert_equal(coap_exchange_rx(&ex, sock, &msg), COAP_EXCHANGE_RESPONSE);
+	zassert_false(ex.acked);
+	zassert_ok(coap_rto_stats_get((struct sockaddr *)&dst, &stats));
+	zassert_equal(stats.strong_samples, 1);
+}
+
+ZTEST(coap_exchange, test_separate_response)
+{
+	struct coap_packet request, msg;
+	struct coap_exchange ex;
+	struct coap_rto_stats stats;
+	struct coap_dedup_stats dedup;
+	uint32_t timeout;
+	int64_t sent;
+	int len;
+
+	request_init(&request, coap_next_id());
+	timeout = coap_exchange_start(&ex, (struct sockaddr *)&server, &request);
+	sent = k_uptime_get();
+	zassert_true(zsock_send(sock, request.data, request.offset, 0) > 0);
+
+	/* The empty ACK arrives within the first timeout and gives the round trip */
+	len = recv_wait(timeout);
+	zassert_true(len > 0, "No ACK within %u ms", timeout);
+	zassert_equal(rx_match(&ex, &msg, len), COAP_EXCHANGE_ACKED);
+	zassert_true(ex.acked);
+	zassert_ok(coap_rto_stats_get((struct sockaddr *)&server, &stats));
+	zassert_equal(stats.strong_samples, 1);
+	zassert_true(stats.strong_rtt_ms < SEPARATE_MS / 2, "RTT %u ms taken at the response",
+		     stats.strong_rtt_ms);
+
+	/* The response comes after the first timeout, without a retransmission */
+	len = recv_wait(CONFIG_COAP_EXCHANGE_SEPARATE_TIMEOUT * MSEC_PER_SEC);
+	zassert_true(len > 0, "No separate response");
+	zassert_true(k_uptime_get() - sent > timeout);
+	zassert_equal(rx_match(&ex, &msg, len), COAP_EXCHANGE_RESPONSE);
+	zassert_equal(coap_header_get_type(&msg), COAP_TYPE_CON);
+	zassert_equal(coap_header_get_code(&msg), COAP_RESPONSE_CODE_CONTENT);
+	zassert_equal(ex.rto.retransmissions, 0);
+
+	/* The response was acknowledged, so the server does not send it again */
+	coap_dedup_stats_get(&dedup);
+	zassert_equal(dedup.acks_sent, 1);
+	zassert_equal(recv_wait(2 * SERVER_ACK_TIMEOUT_MS), 0, "Separate response retransmitted");
+}
+
+static void *coap_exchange_setup(void)
+{
+	sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(sock >= 0, "socket failed: %d", errno);
+	zassert_ok(zsock_connect(sock, (struct sockaddr *)&server, sizeof(server)));
+
+	return NULL;
+}
+
+ZTEST_SUITE(coap_exchange, NULL, coap_exchange_setup, NULL, NULL, NULL);
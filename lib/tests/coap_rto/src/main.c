@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/ztest.h>
+
+#include <cellfund/coap_rto.h>
+
+/* The tests use ten destinations, none of them is replaced */
+BUILD_ASSERT(CONFIG_COAP_RTO_DESTINATIONS >= 10);
+
+static struct sockaddr_in dest_init(uint16_t port)
+{
+	return (struct sockaddr_in){
+		.sin_family = AF_INET,
+		.sin_port = htons(port),
+		/* 192.0.2.1, TEST-NET-1 */
+		.sin_addr.s_addr = htonl(0xc0000201),
+	};
+}
+
+static struct coap_rto_stats stats_get(const struct sockaddr_in *dst)
+{
+	struct coap_rto_stats stats;
+
+	zassert_ok(coap_rto_stats_get((const struct sockaddr *)dst, &stats));
+
+	return stats;
+}
+
+/* The first timeout is the RTO dithered by ACK_RANDOM_FACTOR 1.5 */
+static void timeout_check(uint32_t timeout_ms, uint32_t rto_ms)
+{
+	zassert_between_inclusive(timeout_ms, rto_ms, rto_ms + rto_ms / 2,
+				  "Timeout %u ms for RTO %u ms", timeout_ms, rto_ms);
+}
+
+/* Runs one exchange that is answered @p rtt_ms after its first transmission,
+ * following @p retransmissions timeouts.
+ */
+static void exchange(const struct sockaddr_in *dst, uint32_t rtt_ms, int retransmissions)
+{
+	struct coap_rto_exchange ex;
+
+	(void)coap_rto_start(&ex, (const struct sockaddr *)dst);
+	for (int i = 0; i < retransmissions; i++) {
+		zassert_true(coap_rto_retransmit(&ex) > 0);
+	}
+
+	ex.start = k_uptime_get() - rtt_ms;
+	coap_rto_done(&ex);
+}
+
+/* Two strong samples of 100 ms: RTO 1150 ms, then 699 ms */
+static void fast_dest_setup(const struct sockaddr_in *dst)
+{
+	exchange(dst, 100, 0);
+	exchange(dst, 100, 0);
+	zassert_equal(stats_get(dst).rto_ms, 699);
+}
+
+/* A weak sample of 20 s: RTO (30000 + 3 * 2000) / 4 ms */
+static void slow_dest_setup(const struct sockaddr_in *dst)
+{
+	exchange(dst, 20000, 1);
+	zassert_equal(stats_get(dst).rto_ms, 9000);
+}
+
+ZTEST(coap_rto, test_initial)
+{
+	struct sockaddr_in dst = dest_init(1000);
+	struct coap_rto_stats stats;
+	struct coap_rto_exchange ex;
+
+	zassert_equal(coap_rto_stats_get((struct sockaddr *)&dst, &stats), -ENOENT);
+
+	timeout_check(coap_rto_start(&ex, (struct sockaddr *)&dst), CONFIG_COAP_RTO_INITIAL_MS);
+	zassert_equal(ex.backoff_x2, 4);
+	zassert_equal(ex.retransmissions, 0);
+
+	stats = stats_get(&dst);
+	zassert_equal(stats.rto_ms, CONFIG_COAP_RTO_INITIAL_MS);
+	zassert_equal(stats.strong_samples, 0);
+	zassert_equal(stats.weak_samples, 0);
+}
+
+ZTEST(coap_rto, test_strong_update)
+{
+	struct sockaddr_in dst = dest_init(1001);
+	struct coap_rto_stats stats;
+
+	/* RTT 400, RTTVAR 200, estimate 400 + 4 * 200, blended 1:1 */
+	exchange(&dst, 400, 0);
+	stats = stats_get(&dst);
+	zassert_equal(stats.strong_rtt_ms, 400);
+	zassert_equal(stats.strong_rttvar_ms, 200);
+	zassert_equal(stats.rto_ms, (1200 + CONFIG_COAP_RTO_INITIAL_MS) / 2);
+
+	/* RTTVAR (3 * 200 + 0) / 4, estimate 400 + 4 * 150 */
+	exchange(&dst, 400, 0);
+	stats = stats_get(&dst);
+	zassert_equal(stats.strong_rtt_ms, 400);
+	zassert_equal(stats.strong_rttvar_ms, 150);
+	zassert_equal(stats.rto_ms, 1300);
+	zassert_equal(stats.strong_samples, 2);
+	zassert_equal(stats.weak_samples, 0);
+}
+
+ZTEST(coap_rto, test_weak_update)
+{
+	struct sockaddr_in dst = dest_init(1002);
+	struct coap_rto_stats stats;
+
+	/* RTT 3000, RTTVAR 1500, estimate 3000 + 1500, blended 1:3 */
+	exchange(&dst, 3000, 1);
+	stats = stats_get(&dst);
+	zassert_equal(stats.weak_rtt_ms, 3000);
+	zassert_equal(stats.weak_rttvar_ms, 1500);
+	zassert_equal(stats.rto_ms, (4500 + 3 * CONFIG_COAP_RTO_INITIAL_MS) / 4);
+	zassert_equal(stats.strong_samples, 0);
+	zassert_equal(stats.retransmissions, 1);
+
+	/* RTTVAR (3 * 1500 + 1000) / 4, RTT (7 * 3000 + 2000) / 8 */
+	exchange(&dst, 2000, 2);
+	stats = stats_get(&dst);
+	zassert_equal(stats.weak_rtt_ms, 2875);
+	zassert_equal(stats.weak_rttvar_ms, 1375);
+	zassert_equal(stats.rto_ms, (4250 + 3 * 2625) / 4);
+	zassert_equal(stats.weak_samples, 2);
+
+	/* After three retransmissions the ACK is ambiguous and not used */
+	exchange(&dst, 100, 3);
+	stats = stats_get(&dst);
+	zassert_equal(stats.rto_ms, 3031);
+	zassert_equal(stats.weak_samples, 2);
+	zassert_equal(stats.retransmissions, 6);
+}
+
+ZTEST(coap_rto, test_backoff)
+{
+	struct sockaddr_in fast = dest_init(1003);
+	struct sockaddr_in normal = dest_init(1004);
+	struct sockaddr_in slow = dest_init(1005);
+	struct coap_rto_exchange ex;
+	uint32_t timeout_ms;
+
+	/* Below 1 s the timeout triples */
+	fast_dest_setup(&fast);
+	timeout_ms = coap_rto_start(&ex, (struct sockaddr *)&fast);
+	timeout_check(timeout_ms, 699);
+	zassert_equal(ex.backoff_x2, 6);
+	zassert_equal(coap_rto_retransmit(&ex), 3 * timeout_ms);
+	zassert_equal(coap_rto_retransmit(&ex), 9 * timeout_ms);
+
+	/* From 1 s to 3 s it doubles, as in RFC 7252 */
+	timeout_ms = coap_rto_start(&ex, (struct sockaddr *)&normal);
+	zassert_equal(ex.backoff_x2, 4);
+	zassert_equal(coap_rto_retransmit(&ex), 2 * timeout_ms);
+	zassert_equal(coap_rto_retransmit(&ex), 4 * timeout_ms);
+
+	/* Above 3 s it grows by half */
+	slow_dest_setup(&slow);
+	timeout_ms = coap_rto_start(&ex, (struct sockaddr *)&slow);
+	timeout_check(timeout_ms, 9000);
+	zassert_equal(ex.backoff_x2, 3);
+	timeout_ms = timeout_ms * 3 / 2;
+	zassert_equal(coap_rto_retransmit(&ex), timeout_ms);
+	zassert_equal(coap_rto_retransmit(&ex), timeout_ms * 3 / 2);
+}
+
+ZTEST(coap_rto, test_aging)
+{
+	struct sockaddr_in fast = dest_init(1006);
+	struct sockaddr_in normal = dest_init(1007);
+	struct sockaddr_in slow = dest_init(1008);
+	struct coap_rto_exchange ex;
+
+	fast_dest_setup(&fast);
+	exchange(&normal, 500, 0);
+	slow_dest_setup(&slow);
+	zassert_equal(stats_get(&normal).rto_ms, 1750);
+
+	/* Idle time counts from the last update, not from the last exchange */
+	k_sleep(K_MSEC(8 * 699));
+	(void)coap_rto_start(&ex, (struct sockaddr *)&fast);
+	zassert_equal(stats_get(&fast).rto_ms, 699);
+
+	/* A small RTO doubles after 16 RTOs */
+	k_sleep(K_MSEC(8 * 699 + 10));
+	(void)coap_rto_start(&ex, (struct sockaddr *)&fast);
+	zassert_equal(ex.backoff_x2, 4);
+	zassert_equal(stats_get(&fast).rto_ms, 2 * 699);
+
+	/* A large RTO moves halfway back to the initial one after 4 RTOs */
+	k_sleep(K_MSEC(4 * 9000 - 16 * 699));
+	(void)coap_rto_start(&ex, (struct sockaddr *)&slow);
+	zassert_equal(stats_get(&slow).rto_ms, (CONFIG_COAP_RTO_INITIAL_MS + 9000) / 2);
+	zassert_equal(ex.backoff_x2, 3);
+
+	/* One from 1 s to 3 s is kept */
+	(void)coap_rto_start(&ex, (struct sockaddr *)&normal);
+	zassert_equal(stats_get(&normal).rto_ms, 1750);
+}
+
+ZTEST(coap_rto, test_max_retransmit)
+{
+	struct sockaddr_in dst = dest_init(1009);
+	struct coap_rto_exchange ex;
+	struct coap_rto_stats stats;
+	int timeout_ms;
+
+	timeout_ms = coap_rto_start(&ex, (struct sockaddr *)&dst);
+	for (int i = 0; i < CONFIG_COAP_RTO_MAX_RETRANSMIT; i++) {
+		int next_ms = coap_rto_retransmit(&ex);
+
+		zassert_equal(next_ms, 2 * timeout_ms, "Retransmission %d", i + 1);
+		timeout_ms = next_ms;
+	}
+
+	zassert_equal(coap_rto_retransmit(&ex), -ETIMEDOUT);
+	zassert_equal(ex.retransmissions, CONFIG_COAP_RTO_MAX_RETRANSMIT);
+
+	stats = stats_get(&dst);
+	zassert_equal(stats.retransmissions, CONFIG_COAP_RTO_MAX_RETRANSMIT);
+	zassert_equal(stats.timeouts, 1);
+	zassert_equal(stats.rto_ms, CONFIG_COAP_RTO_INITIAL_MS);
+}
+
+ZTEST_SUITE(coap_rto, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Built with the host libc, see CMakeLists.txt */
+
+#include <stdint.h>
+#include <time.h>
+
+uint64_t gnss_bench_cpu_time_ns(void)
+{
+	struct timespec ts;
+
+	/* Each Zephyr thread runs in its own host thread */
+	if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+		return 0;
+	}
+
+	return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
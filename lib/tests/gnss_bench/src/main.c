@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Replays drive.csv through the GNSS processing of l6_e2_sol and l8_sol, and
+ * reports the CPU time per epoch, the fixes emitted and the upload bytes of
+ * each. Twister records the report lines, see testcase.yaml.
+ */
+
+#include <stdio.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+#include <nrf_modem_gnss.h>
+
+#include <cellfund/fixfmt.h>
+#include <cellfund/gnss_pipeline.h>
+#include <cellfund/pos_filter.h>
+#include <cellfund/track_simplify.h>
+
+/* PVT frames and fixes in drive.csv */
+#define DRIVE_EPOCHS 28
+#define DRIVE_FIXES 8
+/* Longest time between two events of the drive, as replayed */
+#define DRIVE_GAP_MS (120000 / CONFIG_PVT_REPLAY_SPEEDUP)
+
+/* l8_sol built with overlay-batch.conf */
+#define L8_FIXES_PER_UPLOAD 4
+#define L8_FIX_PAYLOAD_MAX_LEN 64
+
+/* Defined in cpu_time_bottom.c */
+uint64_t gnss_bench_cpu_time_ns(void);
+
+struct bench {
+	const char *name;
+	void (*process)(struct bench *bench, const struct gnss_pipeline_evt *evt);
+	struct pos_filter filter;
+	uint64_t cpu_ns;
+	uint32_t epochs;
+	uint32_t fixes;
+	uint32_t upload_bytes;
+};
+
+/* Fixes buffered by l8_sol between uploads */
+static struct track_point l8_track[L8_FIXES_PER_UPLOAD];
+static uint32_t l8_accuracy_mm[L8_FIXES_PER_UPLOAD];
+static struct nrf_modem_gnss_datetime l8_datetime[L8_FIXES_PER_UPLOAD];
+static size_t l8_count;
+
+/* Reports that did not fit, counted as the handler cannot fail the test */
+static uint32_t encode_errors;
+
+static K_SEM_DEFINE(event_sem, 0, K_SEM_MAX_LIMIT);
+
+/* Filters the fix like both solutions do. */
+static void fix_filter(struct bench *bench, struct nrf_modem_gnss_pvt_data_frame *pvt)
+{
+	struct pos_filter_output filtered;
+
+	if (pos_filter_update(&bench->filter, pvt, &filtered) == 0) {
+		pos_filter_output_to_pvt(&filtered, pvt);
+	}
+}
+
+/* l6_e2_sol filters every PVT frame with a fix and sends it as a text report. */
+static void l6_process(struct bench *bench, const struct gnss_pipeline_evt *evt)
+{
+	struct nrf_modem_gnss_pvt_data_frame pvt = evt->pvt;
+	char lat[FIXFMT_DEG_LEN], lon[FIXFMT_DEG_LEN];
+	char report[64];
+	int len;
+
+	if (evt->id != NRF_MODEM_GNSS_EVT_PVT ||
+	    !(pvt.flags & NRF_MODEM_GNSS_PVT_FLAG_FIX_VALID)) {
+		return;
+	}
+
+	fix_filter(bench, &pvt);
+	fixfmt_deg_e7(lat, sizeof(lat), fixfmt_deg_to_e7(pvt.latitude));
+	fixfmt_deg_e7(lon, sizeof(lon), fixfmt_deg_to_e7(pvt.longitude));
+	len = snprintf(report, sizeof(report), "Latitude: %s, Longitude: %s", lat, lon);
+	if (len < 0 || (size_t)len >= sizeof(report)) {
+		encode_errors++;
+		return;
+	}
+
+	bench->fixes++;
+	bench->upload_bytes += len;
+}
+
+/* l8_sol sends the fixes that change the shape of the track, in one payload. */
+static void l8_upload(struct bench *bench)
+{
+	char payload[L8_FIX_PAYLOAD_MAX_LEN * L8_FIXES_PER_UPLOAD];
+	uint8_t kept[L8_FIXES_PER_UPLOAD];
+	size_t len = 0;
+	int count, ret;
+
+	count = track_simplify(l8_track, l8_count, CONFIG_TRACK_SIMPLIFY_TOLERANCE * 1000, kept);
+	l8_count = 0;
+	if (count < 0) {
+		encode_errors++;
+		return;
+	}
+
+	for (int i = 0; i < count; i++) {
+		const struct nrf_modem_gnss_datetime *dt = &l8_datetime[kept[i]];
+		char lat[FIXFMT_DEG_LEN], lon[FIXFMT_DEG_LEN], acc[16];
+
+		fixfmt_deg_e7(lat, sizeof(lat), l8_track[kept[i]].lat_e7);
+		fixfmt_deg_e7(lon, sizeof(lon), l8_track[kept[i]].lon_e7);
+		fixfmt_mm(acc, sizeof(acc), l8_accuracy_mm[kept[i]]);
+		ret = snprintf(payload + len, sizeof(payload) - len,
+			       "%s%s,%s\n%s m\n%04u-%02u-%02u %02u:%02u:%02u",
+			       len > 0 ? "\n" : "", lat, lon, acc, dt->year, dt->month, dt->day,
+			       dt->hour, dt->minute, dt->seconds);
+		if (ret < 0 || (size_t)ret >= sizeof(payload) - len) {
+			encode_errors++;
+			return;
+		}
+		len += ret;
+	}
+
+	bench->fixes += count;
+	bench->upload_bytes += len;
+}
+
+/* l8_sol tracks with periodic fixes, and buffers a fix when GNSS goes to sleep. */
+static void l8_process(struct bench *bench, const struct gnss_pipeline_evt *evt)
+{
+	struct nrf_modem_gnss_pvt_data_frame pvt = evt->pvt;
+
+	if (evt->id != NRF_MODEM_GNSS_EVT_SLEEP_AFTER_FIX || !evt->has_pvt) {
+		return;
+	}
+
+	fix_filter(bench, &pvt);
+	l8_track[l8_count].lat_e7 = fixfmt_deg_to_e7(pvt.latitude);
+	l8_track[l8_count].lon_e7 = fixfmt_deg_to_e7(pvt.longitude);
+	l8_accuracy_mm[l8_count] = (uint32_t)(pvt.accuracy * 1000.0f);
+	l8_datetime[l8_count] = pvt.datetime;
+	l8_count++;
+
+	if (l8_count == L8_FIXES_PER_UPLOAD) {
+		l8_upload(bench);
+	}
+}
+
+static struct bench benches[] = {
+	{ .name = "l6_e2_sol", .process = l6_process },
+	{ .name = "l8_sol", .process = l8_process },
+};
+
+static void handler(const struct gnss_pipeline_evt *evt)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(benches); i++) {
+		uint64_t start = gnss_bench_cpu_time_ns();
+
+		benches[i].process(&benches[i], evt);
+		benches[i].cpu_ns += gnss_bench_cpu_time_ns() - start;
+		if (evt->id == NRF_MODEM_GNSS_EVT_PVT) {
+			benches[i].epochs++;
+		}
+	}
+
+	k_sem_give(&event_sem);
+}
+
+ZTEST(gnss_bench, test_drive)
+{
+	struct gnss_pipeline_stats stats;
+
+	zassert_ok(gnss_pipeline_init(handler));
+	zassert_ok(nrf_modem_gnss_start());
+
+	/* The drive has been replayed when no event comes within the longest gap */
+	while (k_sem_take(&event_sem, K_MSEC(2 * DRIVE_GAP_MS)) == 0) {
+	}
+	zassert_ok(nrf_modem_gnss_stop());
+
+	if (l8_count > 0) {
+		l8_upload(&benches[1]);
+	}
+
+	gnss_pipeline_stats_get(&stats);
+	zassert_equal(stats.dropped, 0, "%u events dropped", stats.dropped);
+	zassert_equal(encode_errors, 0);
+
+	for (size_t i = 0; i < ARRAY_SIZE(benches); i++) {
+		const struct bench *bench = &benches[i];
+
+		uint64_t cpu_ns = bench->epochs ? bench->cpu_ns / bench->epochs : 0;
+
+		TC_PRINT("GNSS bench %s: %u epochs, %llu ns CPU per epoch, %u fixes, "
+			 "%u upload bytes\n", bench->name, bench->epochs,
+			 (unsigned long long)cpu_ns, bench->fixes, bench->upload_bytes);
+
+		/* Only PVT frames without a fix are coalesced */
+		zassert_equal(bench->epochs + stats.coalesced, DRIVE_EPOCHS);
+	}
+
+	zassert_equal(benches[0].fixes, DRIVE_FIXES);
+	/* Every upload keeps at least its first and last fix */
+	zassert_between_inclusive(benches[1].fixes,
+				  2 * DIV_ROUND_UP(DRIVE_FIXES, L8_FIXES_PER_UPLOAD), DRIVE_FIXES);
+	zassert_true(benches[1].upload_bytes > 0);
+}
+
+ZTEST_SUITE(gnss_bench, NULL, NULL, NULL, NULL, NULL);
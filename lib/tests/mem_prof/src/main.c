@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#if defined(CONFIG_MEM_PROF_BUDGET_FATAL)
+#include <zephyr/ztest_error_hook.h>
+#endif
+
+#include <cellfund/mem_prof.h>
+
+/* The system heap is the only heap without the modem library */
+#define HEAP_SYSTEM 0
+
+static struct mem_prof_usage heap_get(void)
+{
+	struct mem_prof_usage usage;
+
+	zassert_ok(mem_prof_heap_get(HEAP_SYSTEM, &usage));
+	zassert_str_equal(usage.name, "system heap");
+
+	return usage;
+}
+
+#if defined(CONFIG_MEM_PROF_BUDGET_FATAL)
+static K_THREAD_STACK_DEFINE(sample_stack, 2048);
+static struct k_thread sample_thread;
+static volatile bool fatal_seen;
+
+void ztest_post_fatal_error_hook(unsigned int reason, const struct arch_esf *esf)
+{
+	fatal_seen = reason == K_ERR_KERNEL_PANIC;
+}
+
+static void sample_thread_fn(void *p1, void *p2, void *p3)
+{
+	(void)mem_prof_sample();
+}
+
+/* The budget check panics, so it runs in a thread of its own */
+static void sample_expect_fatal(void)
+{
+	ztest_set_fault_valid(true);
+	k_thread_create(&sample_thread, sample_stack, K_THREAD_STACK_SIZEOF(sample_stack),
+			sample_thread_fn, NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	zassert_ok(k_thread_join(&sample_thread, K_SECONDS(1)));
+	zassert_true(fatal_seen, "Exceeded budget did not stop the run");
+}
+#endif
+
+ZTEST(mem_prof, test_heap_budget)
+{
+	struct mem_prof_usage usage;
+	size_t len;
+	void *buf;
+
+	/* Nothing is allocated yet, and stacks run on host stacks on native_sim */
+	zassert_equal(mem_prof_sample(), 0);
+	usage = heap_get();
+	zassert_true(usage.size > 0 && usage.size <= CONFIG_HEAP_MEM_POOL_SIZE);
+	zassert_false(usage.over_budget);
+	zassert_str_equal(usage.kconfig, "CONFIG_HEAP_MEM_POOL_SIZE");
+
+	/* Within the budget */
+	len = usage.size * (CONFIG_MEM_PROF_HEAP_BUDGET - 20) / 100;
+	buf = k_malloc(len);
+	zassert_not_null(buf);
+	zassert_equal(mem_prof_sample(), 0);
+	usage = heap_get();
+	zassert_true(usage.peak >= len);
+	zassert_false(usage.over_budget);
+	k_free(buf);
+
+	/* Over the budget */
+	len = usage.size * (CONFIG_MEM_PROF_HEAP_BUDGET + 10) / 100;
+	buf = k_malloc(len);
+	zassert_not_null(buf);
+#if defined(CONFIG_MEM_PROF_BUDGET_FATAL)
+	sample_expect_fatal();
+#else
+	zassert_equal(mem_prof_sample(), 1);
+#endif
+	k_free(buf);
+
+	/* The peak and the verdict stay after the memory is freed */
+	zassert_equal(mem_prof_sample(), 1);
+	usage = heap_get();
+	zassert_true(usage.peak >= len);
+	zassert_true(usage.over_budget);
+	zassert_true(mem_prof_suggest(usage.peak) > usage.peak);
+}
+
+ZTEST(mem_prof, test_suggest)
+{
+	/* 25% margin, rounded up to 64 bytes */
+	zassert_equal(mem_prof_suggest(0), 0);
+	zassert_equal(mem_prof_suggest(1000), 1280);
+	zassert_equal(mem_prof_suggest(1024), 1280);
+	zassert_equal(mem_prof_suggest(1025), 1344);
+}
+
+ZTEST_SUITE(mem_prof, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk-hooks.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+#include <nrf_modem_gnss.h>
+
+#include <cellfund/gnss_pipeline.h>
+#include <cellfund/pvt_recording.h>
+
+#define ENTRIES 5
+/* Allowed difference between recorded and expected event times */
+#define TIME_TOLERANCE_MS 20
+
+struct recording {
+	struct pvt_recording_header header;
+	struct pvt_recording_entry entries[ENTRIES];
+};
+
+BUILD_ASSERT(offsetof(struct recording, entries) == sizeof(struct pvt_recording_header),
+	     "Recording must not be padded");
+
+static struct recording source;
+static struct recording captured;
+static size_t captured_bytes[ENTRIES];
+static uint32_t capture_errors;
+
+static struct gnss_pipeline_evt received[ENTRIES];
+static size_t received_count;
+static K_SEM_DEFINE(received_sem, 0, ENTRIES);
+
+static printk_hook_fn_t console_hook;
+static char line[128];
+static size_t line_len;
+
+static void entry_set(struct pvt_recording_entry *entry, uint32_t time_ms, int event,
+		      double latitude, bool fix)
+{
+	entry->time_ms = time_ms;
+	entry->event = event;
+	if (latitude == 0.0) {
+		return;
+	}
+
+	entry->has_pvt = 1;
+	entry->pvt.latitude = latitude;
+	entry->pvt.longitude = 10.395;
+	entry->pvt.accuracy = 12.5f;
+	if (fix) {
+		entry->pvt.flags = NRF_MODEM_GNSS_PVT_FLAG_FIX_VALID;
+	}
+}
+
+static void source_build(void)
+{
+	source.header = (struct pvt_recording_header){
+		.magic = PVT_RECORDING_MAGIC,
+		.version = PVT_RECORDING_VERSION,
+		.entry_size = sizeof(struct pvt_recording_entry),
+	};
+
+	entry_set(&source.entries[0], 0, NRF_MODEM_GNSS_EVT_PVT, 63.1, false);
+	entry_set(&source.entries[1], 1000, NRF_MODEM_GNSS_EVT_PVT, 63.4305, true);
+	entry_set(&source.entries[2], 1000, NRF_MODEM_GNSS_EVT_FIX, 63.4305, true);
+	entry_set(&source.entries[3], 2000, NRF_MODEM_GNSS_EVT_PVT, 63.4310, true);
+	entry_set(&source.entries[4], 3000, NRF_MODEM_GNSS_EVT_BLOCKED, 0.0, false);
+}
+
+/* Puts the payload of one "PVTREC <seq> <offset> <hex>" line into the
+ * captured recording, like pvt_rec.py does on the host.
+ */
+static void line_parse(const char *str)
+{
+	uint8_t buf[64];
+	unsigned long seq;
+	unsigned long off;
+	char *end;
+	size_t len;
+
+	if (strncmp(str, "PVTREC ", 7) != 0) {
+		return;
+	}
+
+	seq = strtoul(str + 7, &end, 10);
+	off = strtoul(end, &end, 10);
+	len = hex2bin(end + 1, strlen(end + 1), buf, sizeof(buf));
+	if (seq >= ENTRIES || len == 0 || off + len > sizeof(struct pvt_recording_entry)) {
+		capture_errors++;
+		return;
+	}
+
+	memcpy((uint8_t *)&captured.entries[seq] + off, buf, len);
+	captured_bytes[seq] += len;
+}
+
+static int capture_char(int c)
+{
+	if (c == '\n') {
+		line[line_len] = '\0';
+		line_parse(line);
+		line_len = 0;
+	} else if (line_len < sizeof(line) - 1) {
+		line[line_len++] = c;
+	}
+
+	return console_hook != NULL ? console_hook(c) : c;
+}
+
+static void handler(const struct gnss_pipeline_evt *evt)
+{
+	if (received_count < ARRAY_SIZE(received)) {
+		received[received_count++] = *evt;
+	}
+
+	k_sem_give(&received_sem);
+}
+
+static void replay(const struct recording *rec)
+{
+	received_count = 0;
+	k_sem_reset(&received_sem);
+
+	pvt_replay_recording_set(rec, sizeof(*rec));
+	zassert_ok(nrf_modem_gnss_start());
+
+	for (size_t i = 0; i < ENTRIES; i++) {
+		zassert_ok(k_sem_take(&received_sem, K_SECONDS(5)), "Event %zu not handled", i);
+	}
+
+	zassert_ok(nrf_modem_gnss_stop());
+}
+
+static void entry_check(const struct pvt_recording_entry *expected, int id, bool has_pvt,
+			const struct nrf_modem_gnss_pvt_data_frame *pvt, size_t idx)
+{
+	zassert_equal(id, expected->event, "Entry %zu event", idx);
+	zassert_equal(has_pvt, expected->has_pvt, "Entry %zu PVT", idx);
+	if (!has_pvt) {
+		return;
+	}
+
+	zassert_equal(pvt->latitude, expected->pvt.latitude, "Entry %zu latitude", idx);
+	zassert_equal(pvt->longitude, expected->pvt.longitude, "Entry %zu longitude", idx);
+	zassert_equal(pvt->accuracy, expected->pvt.accuracy, "Entry %zu accuracy", idx);
+	zassert_equal(pvt->flags, expected->pvt.flags, "Entry %zu flags", idx);
+}
+
+static void *suite_setup(void)
+{
+	source_build();
+	zassert_ok(gnss_pipeline_init(handler));
+
+	return NULL;
+}
+
+ZTEST(pvt_recording, test_record_replay)
+{
+	struct gnss_pipeline_stats stats;
+
+	/* Replay the source and record what the pipeline handles */
+	console_hook = __printk_get_hook();
+	__printk_hook_install(capture_char);
+	replay(&source);
+	__printk_hook_install(console_hook);
+
+	zassert_equal(capture_errors, 0);
+	for (size_t i = 0; i < ENTRIES; i++) {
+		const struct pvt_recording_entry *entry = &captured.entries[i];
+		uint32_t expected_ms = source.entries[i].time_ms / CONFIG_PVT_REPLAY_SPEEDUP;
+
+		zassert_equal(captured_bytes[i], sizeof(*entry), "Entry %zu incomplete", i);
+		entry_check(&source.entries[i], received[i].id, received[i].has_pvt,
+			    &received[i].pvt, i);
+		entry_check(&source.entries[i], entry->event, entry->has_pvt, &entry->pvt, i);
+		zassert_within(entry->time_ms, expected_ms, TIME_TOLERANCE_MS,
+			       "Entry %zu recorded at %u ms", i, entry->time_ms);
+	}
+
+	/* The recording must replay to the same events */
+	captured.header = source.header;
+	replay(&captured);
+
+	for (size_t i = 0; i < ENTRIES; i++) {
+		entry_check(&source.entries[i], received[i].id, received[i].has_pvt,
+			    &received[i].pvt, i);
+	}
+
+	gnss_pipeline_stats_get(&stats);
+	zassert_equal(stats.processed, 2 * ENTRIES);
+	zassert_equal(stats.dropped, 0);
+	zassert_equal(stats.read_errors, 0);
+}
+
+ZTEST_SUITE(pvt_recording, NULL, suite_setup, NULL, NULL, NULL);
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+
+#include <cellfund/geo.h>
+#include <cellfund/track_simplify.h>
+
+/* Segment from a start point to an end point, in mm from the start point. */
+struct segment {
+	struct geo_frame frame;
+	int64_t north;
+	int64_t east;
+	int64_t len2;
+	uint32_t len;
+};
+
+static void segment_init(struct segment *seg, const struct track_point *start,
+			 const struct track_point *end)
+{
+	geo_frame_init(&seg->frame, start->lat_e7, start->lon_e7);
+	geo_to_local(&seg->frame, end->lat_e7, end->lon_e7, &seg->north, &seg->east);
+	seg->len2 = seg->north * seg->north + seg->east * seg->east;
+	seg->len = geo_isqrt64(seg->len2);
+}
+
+/* Distance from a point to the segment, in mm. */
+static uint32_t segment_dist(const struct segment *seg, const struct track_point *point)
+{
+	int64_t north, east, dot, cross;
+
+	geo_to_local(&seg->frame, point->lat_e7, point->lon_e7, &north, &east);
+
+	dot = north * seg->north + east * seg->east;
+	if (seg->len == 0 || dot <= 0) {
+		return geo_isqrt64(north * north + east * east);
+	}
+
+	if (dot >= seg->len2) {
+		north -= seg->north;
+		east -= seg->east;
+		return geo_isqrt64(north * north + east * east);
+	}
+
+	cross = north * seg->east - east * seg->north;
+
+	return (cross < 0 ? -cross : cross) / seg->len;
+}
+
+int track_simplify(const struct track_point *points, size_t count,
+		   uint32_t tolerance_mm, uint8_t *kept)
+{
+	/* Pending ranges never overlap, so there are fewer of them than points. */
+	struct {
+		uint8_t first;
+		uint8_t last;
+	} stack[CONFIG_TRACK_SIMPLIFY_MAX_POINTS];
+	bool keep[CONFIG_TRACK_SIMPLIFY_MAX_POINTS];
+	struct segment seg;
+	size_t depth = 0;
+	size_t n = 0;
+
+	if (count > CONFIG_TRACK_SIMPLIFY_MAX_POINTS) {
+		return -EINVAL;
+	}
+
+	if (count < 3) {
+		for (size_t i = 0; i < count; i++) {
+			kept[i] = i;
+		}
+		return count;
+	}
+
+	memset(keep, 0, count);
+	keep[0] = true;
+	keep[count - 1] = true;
+
+	stack[depth].first = 0;
+	stack[depth].last = count - 1;
+	depth++;
+
+	while (depth > 0) {
+		uint8_t first, last, max_idx = 0;
+		uint32_t dist, max_dist = 0;
+
+		depth--;
+		first = stack[depth].first;
+		last = stack[depth].last;
+
+		if (last - first < 2) {
+			continue;
+		}
+
+		segment_init(&seg, &points[first], &points[last]);
+
+		for (uint8_t i = first + 1; i < last; i++) {
+			dist = segment_dist(&seg, &points[i]);
+			if (dist > max_dist) {
+				max_dist = dist;
+				max_idx = i;
+			}
+		}
+
+		if (max_dist > tolerance_mm) {
+			keep[max_idx] = true;
+
+			stack[depth].first = first;
+			stack[depth].last = max_idx;
+			depth++;
+			stack[depth].first = max_idx;
+			stack[depth].last = last;
+			depth++;
+		}
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		if (keep[i]) {
+			kept[n++] = i;
+		}
+	}
+
+	return n;
+}
+
+void track_simplify_stream_init(struct track_simplify_stream *stream, uint32_t tolerance_mm)
+{
+	stream->tolerance_mm = tolerance_mm;
+	stream->count = 0;
+}
+
+/* Whether every buffered point is within the tolerance of the segment from the
+ * last emitted point to the new one.
+ */
+static bool window_fits(const struct track_simplify_stream *stream,
+			const struct track_point *point)
+{
+	struct segment seg;
+
+	segment_init(&seg, &stream->window[0], point);
+
+	for (size_t i = 1; i < stream->count; i++) {
+		if (segment_dist(&seg, &stream->window[i]) > stream->tolerance_mm) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool track_simplify_stream_push(struct track_simplify_stream *stream,
+				const struct track_point *point, struct track_point *out)
+{
+	if (stream->count == 0) {
+		stream->window[0] = *point;
+		stream->count = 1;
+		*out = *point;
+		return true;
+	}
+
+	if (stream->count < ARRAY_SIZE(stream->window) && window_fits(stream, point)) {
+		stream->window[stream->count++] = *point;
+		return false;
+	}
+
+	/* The previous point starts a new segment. */
+	*out = stream->window[stream->count - 1];
+	stream->window[0] = *out;
+	stream->window[1] = *point;
+	stream->count = 2;
+
+	return true;
+}
+
+bool track_simplify_stream_flush(struct track_simplify_stream *stream, struct track_point *out)
+{
+	if (stream->count < 2) {
+		return false;
+	}
+
+	*out = stream->window[stream->count - 1];
+	stream->window[0] = *out;
+	stream->count = 1;
+
+	return true;
+}
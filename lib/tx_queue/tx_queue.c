@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include <cellfund/tx_queue.h>
+
+LOG_MODULE_REGISTER(tx_queue, CONFIG_TX_QUEUE_LOG_LEVEL);
+
+struct msg {
+	uint8_t type;
+	uint8_t flags;
+	uint16_t len;
+	int64_t queued_at;
+	uint8_t data[CONFIG_TX_QUEUE_DATA_MAX];
+};
+
+static K_MUTEX_DEFINE(lock);
+static K_SEM_DEFINE(msg_sem, 0, 1);
+static tx_queue_send_t send_cb;
+static struct msg queue[CONFIG_TX_QUEUE_LEN];
+static uint8_t head;
+static uint8_t count;
+static struct tx_queue_stats stats;
+static struct tx_queue_type_stats type_stats[CONFIG_TX_QUEUE_TYPES];
+/* Token bucket as the time the bucket would be full again, in ms of uptime */
+static int64_t bucket_full_at;
+
+/* Only used by the sender thread */
+static struct msg current;
+
+/* Called with the lock held. Per-type counters for the types that have them. */
+static struct tx_queue_type_stats *type_stats_locked(uint8_t type)
+{
+	static struct tx_queue_type_stats unused;
+
+	return type < ARRAY_SIZE(type_stats) ? &type_stats[type] : &unused;
+}
+
+/* Called with the lock held. */
+static struct msg *msg_at_locked(uint8_t idx)
+{
+	return &queue[(head + idx) % CONFIG_TX_QUEUE_LEN];
+}
+
+/* Called with the lock held. */
+static struct msg *coalesce_find_locked(uint8_t type)
+{
+	for (uint8_t i = 0; i < count; i++) {
+		struct msg *msg = msg_at_locked(i);
+
+		if (msg->type == type && (msg->flags & TX_QUEUE_COALESCE)) {
+			return msg;
+		}
+	}
+
+	return NULL;
+}
+
+int tx_queue_put(uint8_t type, const void *data, size_t len, uint32_t flags)
+{
+	struct msg *msg = NULL;
+	int err = 0;
+
+	if (len > CONFIG_TX_QUEUE_DATA_MAX) {
+		return -EMSGSIZE;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	if (flags & TX_QUEUE_COALESCE) {
+		msg = coalesce_find_locked(type);
+		if (msg != NULL) {
+			/* Keeps its place and queue time, only the data is newer */
+			stats.coalesced++;
+			type_stats_locked(type)->coalesced++;
+			goto copy;
+		}
+	}
+
+	if (count == CONFIG_TX_QUEUE_LEN) {
+		stats.dropped++;
+		if (IS_ENABLED(CONFIG_TX_QUEUE_DROP_NEWEST)) {
+			LOG_WRN("Queue full, message of type %u dropped", type);
+			type_stats_locked(type)->dropped++;
+			err = -ENOBUFS;
+			goto out;
+		}
+
+		LOG_WRN("Queue full, oldest message of type %u dropped", queue[head].type);
+		type_stats_locked(queue[head].type)->dropped++;
+		head = (head + 1) % CONFIG_TX_QUEUE_LEN;
+		count--;
+	}
+
+	msg = msg_at_locked(count++);
+	msg->type = type;
+	msg->flags = flags;
+	msg->queued_at = k_uptime_get();
+	stats.queued++;
+	type_stats_locked(type)->queued++;
+	stats.depth = count;
+	stats.depth_max = MAX(stats.depth_max, count);
+
+copy:
+	if (len > 0) {
+		memcpy(msg->data, data, len);
+	}
+	msg->len = len;
+
+out:
+	k_mutex_unlock(&lock);
+
+	if (!err) {
+		k_sem_give(&msg_sem);
+	}
+
+	return err;
+}
+
+/* Called with the lock held. Returns the time until the oldest message can
+ * be sent, or -1 if there is none.
+ */
+static int64_t wait_get_locked(int64_t now)
+{
+	int64_t until = 0;
+
+	if (count == 0 || send_cb == NULL) {
+		return -1;
+	}
+
+	if (CONFIG_TX_QUEUE_RATE_INTERVAL_MS > 0) {
+		/* At least one token is left once the bucket is this close to full */
+		until = bucket_full_at -
+			(int64_t)(CONFIG_TX_QUEUE_RATE_BURST - 1) * CONFIG_TX_QUEUE_RATE_INTERVAL_MS;
+	}
+
+	/* Give later triggers a chance to merge into this message */
+	if (queue[head].flags & TX_QUEUE_COALESCE) {
+		until = MAX(until, queue[head].queued_at + CONFIG_TX_QUEUE_COALESCE_MS);
+	}
+
+	return MAX(until - now, 0);
+}
+
+/* Takes the oldest message out of the queue once it can be sent, so
+ * tx_queue_put() can reuse its slot and merge into the messages behind it
+ * while it waits. Returns false when the queue is empty.
+ */
+static bool msg_get(struct msg *out, tx_queue_send_t *send)
+{
+	int64_t now, wait;
+	bool limited = false;
+
+	while (true) {
+		k_mutex_lock(&lock, K_FOREVER);
+		now = k_uptime_get();
+		wait = wait_get_locked(now);
+		if (wait < 0) {
+			k_mutex_unlock(&lock);
+			return false;
+		} else if (wait > 0) {
+			LOG_DBG("Message of type %u held for %lld ms", queue[head].type, wait);
+			k_mutex_unlock(&lock);
+
+			limited = true;
+			k_sleep(K_MSEC(wait));
+			continue;
+		}
+
+		*out = queue[head];
+		*send = send_cb;
+		head = (head + 1) % CONFIG_TX_QUEUE_LEN;
+		count--;
+		stats.depth = count;
+		stats.held += limited;
+		bucket_full_at = MAX(bucket_full_at, now) + CONFIG_TX_QUEUE_RATE_INTERVAL_MS;
+		k_mutex_unlock(&lock);
+
+		return true;
+	}
+}
+
+static void tx_queue_thread(void)
+{
+	tx_queue_send_t send;
+	int64_t start;
+	uint32_t wait_ms, send_ms;
+	int err;
+
+	while (true) {
+		k_sem_take(&msg_sem, K_FOREVER);
+
+		while (msg_get(&current, &send)) {
+			start = k_uptime_get();
+			wait_ms = start - current.queued_at;
+
+			err = send(current.type, current.data, current.len);
+			if (err) {
+				LOG_WRN("Failed to send message of type %u, error: %d",
+					current.type, err);
+			}
+
+			send_ms = k_uptime_get() - start;
+			LOG_DBG("Type %u, %u bytes, waited %u ms, sent in %u ms", current.type,
+				current.len, wait_ms, send_ms);
+
+			k_mutex_lock(&lock, K_FOREVER);
+			if (err) {
+				stats.send_errors++;
+			} else {
+				stats.sent++;
+				type_stats_locked(current.type)->sent++;
+			}
+			stats.wait_ms_max = MAX(stats.wait_ms_max, wait_ms);
+			stats.send_ms_max = MAX(stats.send_ms_max, send_ms);
+			k_mutex_unlock(&lock);
+		}
+	}
+}
+
+K_THREAD_DEFINE(tx_queue_tid, CONFIG_TX_QUEUE_STACK_SIZE,
+		tx_queue_thread, NULL, NULL, NULL,
+		CONFIG_TX_QUEUE_THREAD_PRIORITY, 0, 0);
+
+void tx_queue_init(tx_queue_send_t send)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+	send_cb = send;
+	k_mutex_unlock(&lock);
+
+	k_sem_give(&msg_sem);
+}
+
+void tx_queue_stats_get(struct tx_queue_stats *out)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+	*out = stats;
+	k_mutex_unlock(&lock);
+}
+
+int tx_queue_type_stats_get(uint8_t type, struct tx_queue_type_stats *out)
+{
+	if (type >= ARRAY_SIZE(type_stats)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+	*out = type_stats[type];
+	k_mutex_unlock(&lock);
+
+	return 0;
+}
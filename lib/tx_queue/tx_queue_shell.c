@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+
+#include <cellfund/tx_queue.h>
+
+static int cmd_tx_queue_show(const struct shell *sh, size_t argc, char **argv)
+{
+	struct tx_queue_stats stats;
+	struct tx_queue_type_stats type_stats;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	tx_queue_stats_get(&stats);
+
+	shell_print(sh, "Depth: %u, max: %u of %u", stats.depth, stats.depth_max,
+		    CONFIG_TX_QUEUE_LEN);
+	shell_print(sh, "Queued: %u, coalesced: %u, dropped: %u", stats.queued,
+		    stats.coalesced, stats.dropped);
+	shell_print(sh, "Sent: %u, send errors: %u", stats.sent, stats.send_errors);
+	shell_print(sh, "Held: %u, longest wait: %u ms, longest send: %u ms", stats.held,
+		    stats.wait_ms_max, stats.send_ms_max);
+
+	shell_print(sh, "type  queued  coalesced  dropped  sent");
+	for (uint8_t type = 0; tx_queue_type_stats_get(type, &type_stats) == 0; type++) {
+		if (type_stats.queued == 0 && type_stats.coalesced == 0) {
+			continue;
+		}
+
+		shell_print(sh, "%4u  %6u  %9u  %7u  %4u", type, type_stats.queued,
+			    type_stats.coalesced, type_stats.dropped, type_stats.sent);
+	}
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_tx_queue,
+	SHELL_CMD(show, NULL, "Show send queue statistics", cmd_tx_queue_show),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(tx_queue, &sub_tx_queue, "Asynchronous send queue", NULL);
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <modem/lte_lc.h>
+
+#include <cellfund/upload_sched.h>
+
+LOG_MODULE_REGISTER(upload_sched, CONFIG_UPLOAD_SCHED_LOG_LEVEL);
+
+static K_MUTEX_DEFINE(stats_lock);
+static struct upload_sched_stats stats;
+/* Uptime when upload_sched_check() first deferred the pending upload, 0 if none */
+static int64_t deferred_since;
+
+int upload_sched_quality_get(struct upload_sched_quality *quality)
+{
+	struct lte_lc_conn_eval_params params = {0};
+	int err;
+
+	err = lte_lc_conn_eval_params_get(&params);
+	if (err) {
+		/* Positive values are evaluation failures reported by the modem. */
+		LOG_DBG("Connection evaluation failed: %d", err);
+		return -EAGAIN;
+	}
+
+	quality->rsrp_dbm = params.rsrp - 140;
+	quality->snr_db = params.snr - 24;
+	quality->ce_level = params.ce_level;
+	quality->energy_estimate = params.energy_estimate;
+
+	return 0;
+}
+
+uint32_t upload_sched_energy_per_byte(const struct upload_sched_quality *quality,
+				      size_t payload_len)
+{
+	uint32_t energy;
+
+	switch (quality->energy_estimate) {
+	case LTE_LC_ENERGY_CONSUMPTION_EFFICIENT:
+		energy = 50;
+		break;
+	case LTE_LC_ENERGY_CONSUMPTION_REDUCED:
+		energy = 75;
+		break;
+	case LTE_LC_ENERGY_CONSUMPTION_NORMAL:
+		energy = 100;
+		break;
+	case LTE_LC_ENERGY_CONSUMPTION_INCREASED:
+		energy = 200;
+		break;
+	default:
+		energy = 400;
+		break;
+	}
+
+	payload_len = MAX(payload_len, 1);
+
+	return energy * (CONFIG_UPLOAD_SCHED_OVERHEAD_BYTES + payload_len) / payload_len;
+}
+
+bool upload_sched_quality_ok(const struct upload_sched_quality *quality, size_t payload_len)
+{
+	return quality->rsrp_dbm >= CONFIG_UPLOAD_SCHED_MIN_RSRP &&
+	       quality->snr_db >= CONFIG_UPLOAD_SCHED_MIN_SNR &&
+	       quality->ce_level <= CONFIG_UPLOAD_SCHED_MAX_CE_LEVEL &&
+	       upload_sched_energy_per_byte(quality, payload_len) <=
+		       CONFIG_UPLOAD_SCHED_MAX_ENERGY_PER_BYTE;
+}
+
+static void stats_add_wait(uint32_t wait_ms)
+{
+	stats.wait_ms_total += wait_ms;
+	stats.wait_ms_max = MAX(stats.wait_ms_max, wait_ms);
+}
+
+int upload_sched_wait(bool urgent, size_t payload_len)
+{
+	struct upload_sched_quality quality;
+	int64_t start = k_uptime_get();
+	uint32_t waited_ms;
+	bool deferred = false;
+
+	if (urgent) {
+		k_mutex_lock(&stats_lock, K_FOREVER);
+		stats.immediate++;
+		k_mutex_unlock(&stats_lock);
+		return 0;
+	}
+
+	while (true) {
+		waited_ms = k_uptime_get() - start;
+
+		if (upload_sched_quality_get(&quality) == 0) {
+			LOG_DBG("RSRP %d dBm, SNR %d dB, CE level %d, energy per byte %u",
+				quality.rsrp_dbm, quality.snr_db, quality.ce_level,
+				upload_sched_energy_per_byte(&quality, payload_len));
+
+			if (upload_sched_quality_ok(&quality, payload_len)) {
+				break;
+			}
+		} else {
+			k_mutex_lock(&stats_lock, K_FOREVER);
+			stats.eval_errors++;
+			k_mutex_unlock(&stats_lock);
+		}
+
+		if (waited_ms >= CONFIG_UPLOAD_SCHED_DEADLINE * MSEC_PER_SEC) {
+			LOG_INF("Upload deadline expired after %u s", waited_ms / MSEC_PER_SEC);
+			k_mutex_lock(&stats_lock, K_FOREVER);
+			stats.deadline_expired++;
+			stats_add_wait(waited_ms);
+			k_mutex_unlock(&stats_lock);
+			return -ETIMEDOUT;
+		}
+
+		if (!deferred) {
+			LOG_INF("Poor link, deferring upload");
+			deferred = true;
+		}
+
+		k_sleep(K_SECONDS(CONFIG_UPLOAD_SCHED_POLL_INTERVAL));
+	}
+
+	k_mutex_lock(&stats_lock, K_FOREVER);
+	if (deferred) {
+		LOG_INF("Link improved after %u s", waited_ms / MSEC_PER_SEC);
+		stats.deferred++;
+		stats_add_wait(waited_ms);
+	} else {
+		stats.immediate++;
+	}
+	k_mutex_unlock(&stats_lock);
+
+	return 0;
+}
+
+int upload_sched_check(bool urgent, size_t payload_len)
+{
+	struct upload_sched_quality quality;
+	int64_t now = k_uptime_get();
+	uint32_t waited_ms;
+	bool good = urgent;
+	int err = 0;
+
+	if (!urgent) {
+		err = upload_sched_quality_get(&quality);
+		good = err == 0 && upload_sched_quality_ok(&quality, payload_len);
+	}
+
+	k_mutex_lock(&stats_lock, K_FOREVER);
+	if (err) {
+		stats.eval_errors++;
+	}
+
+	waited_ms = deferred_since != 0 ? now - deferred_since : 0;
+	if (good) {
+		if (deferred_since != 0) {
+			LOG_INF("Link improved after %u s", waited_ms / MSEC_PER_SEC);
+			stats.deferred++;
+			stats_add_wait(waited_ms);
+		} else {
+			stats.immediate++;
+		}
+
+		deferred_since = 0;
+		err = 0;
+	} else if (waited_ms >= CONFIG_UPLOAD_SCHED_DEADLINE * MSEC_PER_SEC) {
+		LOG_INF("Upload deadline expired after %u s", waited_ms / MSEC_PER_SEC);
+		stats.deadline_expired++;
+		stats_add_wait(waited_ms);
+		deferred_since = 0;
+		err = -ETIMEDOUT;
+	} else {
+		if (deferred_since == 0) {
+			LOG_INF("Poor link, deferring upload");
+			deferred_since = now;
+		}
+
+		err = -EAGAIN;
+	}
+	k_mutex_unlock(&stats_lock);
+
+	return err;
+}
+
+void upload_sched_stats_get(struct upload_sched_stats *out)
+{
+	k_mutex_lock(&stats_lock, K_FOREVER);
+	*out = stats;
+	k_mutex_unlock(&stats_lock);
+}